@@ -36,6 +36,10 @@ XML2=/usr/include/libxml2
 # Typical install on macos
 #XML2=/usr/local/opt/libxml2/include/libxml2/
 
+# zstd compressed program files (".zst"), needs the libzstd headers.
+# gzip compressed files (".gz") are always supported (zlib).
+ZSTD_SUPPORT=0
+
 ####################################
 # INSTALLATION PARAMETERS
 ####################################
@@ -108,6 +112,7 @@ fi
 echo "XML2 = ${XML2}" >>  $fileConfigMakefile
 echo "RM=rm -f -v" >>  $fileConfigMakefile
 echo "CXXFLAGS+=-D${HOST_OS}" >>  $fileConfigMakefile
+echo "ZSTD = ${ZSTD_SUPPORT}" >>  $fileConfigMakefile
 
 cd "${HEPTANE_ROOT}"
 ####################################
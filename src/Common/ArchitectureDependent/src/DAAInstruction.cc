@@ -16,14 +16,32 @@
 // Operands are in the order they appear in the asm text file (destination first)
 // The instruction mnemonic is not part of the returned vector,
 // that contains operands only
-vector < string > DAAInstruction::getOperands(const string & instructionAsm)
+vector < string > DAAInstruction::getOperands(const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
+  if (tokenised != NULL)
+    {
+      vector < string > result;
+      for (size_t i = 0; i < tokenised->size(); i++)
+	result.push_back((*tokenised)[i].text);
+      voperator = instructionAsm.substr(0, instructionAsm.find(' '));
+      return result;
+    }
   vector < string > instr = Arch::splitInstruction(instructionAsm);
   vector < string > result(instr.begin() + 1, instr.end());	//+1 to not put the mnemonic
   voperator = instr[0];
   return result;
 }
 
+// getOperandRegister
+// ------------------
+// Register number of the operand k of operands, returned by getOperands
+int DAAInstruction::getOperandRegister(const vector < string > &operands, const cfglib::OperandList * tokenised, size_t k)
+{
+  if (tokenised != NULL && (*tokenised)[k].kind == cfglib::RegisterOperand)
+    return (*tokenised)[k].reg;
+  return Arch::getRegisterNumber(operands[k]);
+}
+
 DAAInstruction::~DAAInstruction()
 {
 }
@@ -187,9 +205,12 @@ string DAAInstruction::eval(string operand1, string codop, string operand2)
   long val;
   string res;
   if (Utl::eval(operand1, codop, operand2, &val)) return Utl::int2cstring(val);
-  if (eval(operand1, codop, operand2, res)) return res;
-  if ( codop.find("+") != EOS ) // commutativity for +
-    if (eval(operand2, codop, operand1, res)) return res;
+  if (eval(operand1, codop, operand2, res) || (codop.find("+") != EOS && eval(operand2, codop, operand1, res)))  // commutativity for +
+    {
+      // A null constant is dropped: "sp + 8" - 8 is "sp", not "sp ".
+      res.erase(res.find_last_not_of(' ') + 1);
+      return res;
+    }
   return (operand1 + codop + operand2);
 }
 
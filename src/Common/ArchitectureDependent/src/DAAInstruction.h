@@ -48,6 +48,7 @@ Rq: The implementation is done for MIPS architecture only !!!
 #include <string>
 #include <iostream>
 #include "arch.h"
+#include "Operand.h"
 
 using namespace std;
 
@@ -90,6 +91,9 @@ class DAAInstruction
      *
      * asmInstr (input) contains the textual representation of the instruction
      *
+     * operands (input) are the operands of asmInstr tokenised at extraction
+     * time, NULL if they have to be parsed from asmInstr
+     *
      * precision contains information on registers whose
      * contents is known precisely. 
      *
@@ -100,13 +104,17 @@ class DAAInstruction
      * Rq: regs and precision are modified by the simulate function
      *
      */
-  virtual void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack,  stackPrecType &vStackPrecision, const string & asmInstr) = 0;
+  virtual void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack,  stackPrecType &vStackPrecision, const string & asmInstr, const cfglib::OperandList *operands) = 0;
 
   /*! Virtual destructor */
   virtual ~ DAAInstruction () = 0;
 
-  /*! Returns all the operands of an asm instruction in a vector (i.e. simply parse the asm line) */
-  /*static*/ vector < string > getOperands (const string & instructionAsm);
+  /*! Returns all the operands of an asm instruction in a vector (i.e. simply parse the asm line,
+   *  unless its operands are tokenised: tokenised != NULL) */
+  vector < string > getOperands (const string & instructionAsm, const cfglib::OperandList *tokenised);
+
+  /*! Returns the register number of the operand k of operands, returned by getOperands */
+  static int getOperandRegister (const vector < string > &operands, const cfglib::OperandList *tokenised, size_t k);
 
   void killop1(regTable &regs, vector < bool > &precision);
   void killop2(regTable &regs, vector < bool > &precision);
@@ -22,7 +22,7 @@ using namespace std;
 #define NOT_YET_IMPLEMENTED "--- Not yet implemented ::simulate "
 
 
-void ARM_COMMON::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_COMMON::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   assert(false);
 }
@@ -45,7 +45,7 @@ void ARM_COMMON::simulateShifter(regTable & regs, regPrecisionTable & precision,
     }
   ARM_SHIFT *shifter = new ARM_SHIFT();
   string instr = shiftOperator + " raux, " + operand1 + ", " + shiftOperand;
-  shifter->simulate(regs, precision, vstack, vStackPrecision, instr);
+  shifter->simulate(regs, precision, vstack, vStackPrecision, instr, NULL);
   num_register1 = Arch::getRegisterNumber("raux");
   TRACE(cout << " Shift operation = " << instr << endl);
 }
@@ -121,7 +121,7 @@ void ARM_COMMON::setRegistersInfos2ops(regTable & regs, regPrecisionTable & prec
     }
 }
 
-void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // add*, adc*
   DAA_TRACE("ARM_ADD", instructionAsm);
@@ -160,7 +160,7 @@ void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_ADD", instructionAsm);
 }
 
-void ARM_DIV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_DIV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // add*, adc*
   DAA_TRACE("ARM_DIV", instructionAsm);
@@ -187,7 +187,7 @@ void ARM_DIV::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_ADD", instructionAsm);
 }
 
-void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   // sub*, sbc*
@@ -232,7 +232,7 @@ void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stac
     ERROR_ACCESS("ARM_SUBTRACT", instructionAsm);
 }
 
-void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   // rsb*, rsc*
@@ -270,7 +270,7 @@ void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, s
     ERROR_ACCESS("ARM_REVERSE_SUB", instructionAsm);
 }
 
-void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   string vinstr = instructionAsm;
@@ -298,9 +298,9 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 		{
 		  // mla Rd, Rm, Rs, Rn is simulated by R':= Rm x Rs, Rd := R' + Rn
 		  ARM_MUL *obj = new ARM_MUL();
-		  obj->simulate(regs, precision, vstack, vStackPrecision, "mul raux," + operand1 + " , " + operand2);
+		  obj->simulate(regs, precision, vstack, vStackPrecision, "mul raux," + operand1 + " , " + operand2, NULL);
 		  ARM_ADD *obj_add = new ARM_ADD();
-		  obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + oreg + "raux, " + operand3);
+		  obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + oreg + "raux, " + operand3, NULL);
 		}
 	    }
 	  else
@@ -368,7 +368,7 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_MUL", instructionAsm);
 }
 
-void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   string vinstr = instructionAsm;
@@ -431,7 +431,7 @@ void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_MOV", instructionAsm);
 }
 
-void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // ldr* (32-bits) ; half-word (16-bits): ldrh*, ldrsh* ; byte(8-bits):  ldrb*, ldrsb* 
   // ldrt* ldrbt* used in non-user mode -- IGNORED
@@ -490,7 +490,7 @@ void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
 	    {
 	      // "LDR R0, [R1, #4]!"  or "LDR R0, [R1] #4". R1 := R1 + 4 after the memory transfert
 	      ARM_ADD *obj_add = new ARM_ADD();
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3);
+	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3, NULL);
 	    }
 	}
     }
@@ -498,7 +498,7 @@ void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
     ERROR_ACCESS("ARM_LOAD", instructionAsm);
 }
 
-void ARM_PUSH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_PUSH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("ARM_PUSH", instructionAsm);
   int num_register_v0 = ARM_SP_REGISTER;
@@ -509,7 +509,7 @@ void ARM_PUSH::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
   regs[num_register_v0] = regs[num_register_v0] + " + " + ossAddr.str();
 }
 
-void ARM_POP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_POP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("ARM_POP", instructionAsm);
 
@@ -522,7 +522,7 @@ void ARM_POP::simulate(regTable & regs, regPrecisionTable & precision, stackType
 }
 
 // Kept, but now the "multiple loads" are rewritten in the Extract step.
-void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string icode, incr, icodeinit;
   string vinstr = instructionAsm;
@@ -544,7 +544,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  // LDM[IA] Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk;  for i=1,n { Ro_i = [ raux ]; raux = raux + 4; end} )
 	  icodeinit = "ldr raux, [ " + oreg + "]";
 
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit, NULL);
 	  TRACE(cout << instructionAsm << " simulée par:" << endl; cout << "            " << icodeinit << endl);
 
 	  obj_add = new ARM_ADD();
@@ -556,9 +556,9 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 		if ((*it)[i] != ' ')
 		  icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode, NULL);
 	      incr = "add raux, raux, 4";
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr);
+	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 	      TRACE(cout << "            " << icode << "   " << incr << endl);
 	    }
 	}
@@ -567,7 +567,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  // LDMIB Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk;  for i=1,n { raux = raux + 4; Ro_i = [ raux ];end} )
 	  icodeinit = "ldr raux, [ " + oreg + "]";
 
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit, NULL);
 	  TRACE(cout << " ldr init = " << icodeinit << endl);
 
 	  obj_add = new ARM_ADD();
@@ -575,13 +575,13 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  for (it = regList.begin(); it != regList.end(); it++)
 	    {
 	      incr = "add raux, raux, 4";
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr);
+	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 	      icode = "ldr ";
 	      for (i = 0; i < (*it).size(); i++)
 		if ((*it)[i] != ' ')
 		  icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode, NULL);
 	      TRACE(cout << "simulée par " << incr << "   " << icode << endl);
 	    }
 
@@ -591,11 +591,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  // LDMDA Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk - |regs|*4 + 4;  for i=1,n {  Ro_i = [ raux ]; raux = raux - 4;end} )
 	  int n = regList.size() * 4 + 4;
 	  icodeinit = "ldr raux, [ " + oreg + "]";
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit, NULL);
 
 	  incr = "sub raux, raux," + Utl::int2cstring(n);
 	  obj_sub = new ARM_SUBTRACT();
-	  obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr);
+	  obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 	  TRACE(cout << " ldr init = " << icodeinit << " " << incr << endl);
 
 	  obj_add = new ARM_ADD();
@@ -607,9 +607,9 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 		if ((*it)[i] != ' ')
 		  icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode, NULL);
 	      incr = "sub raux, raux, 4";
-	      obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr);
+	      obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 	      TRACE(cout << "simulée par " << incr << "   " << icode << endl);
 	    }
 	}
@@ -618,11 +618,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  // LDMDB Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk - |regs|*4;  for i=1,n { raux = raux - 4; Ro_i = [ raux ];;end} )
 	  int n = regList.size() * 4;
 	  icodeinit = "ldr raux, [ " + oreg + "]";
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit, NULL);
 
 	  incr = "sub raux, raux," + Utl::int2cstring(n);
 	  obj_sub = new ARM_SUBTRACT();
-	  obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr);
+	  obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 
 	  TRACE(cout << " ldr init = " << icodeinit << " " << incr << endl);
 
@@ -631,13 +631,13 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  for (it = regList.begin(); it != regList.end(); it++)
 	    {
 	      incr = "sub raux, raux, 4";
-	      obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr);
+	      obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr, NULL);
 	      icode = "ldr ";
 	      for (i = 0; i < (*it).size(); i++)
 		if ((*it)[i] != ' ')
 		  icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode, NULL);
 	      TRACE(cout << "simulée par " << incr << "   " << icode << endl);
 	    }
 	}
@@ -650,7 +650,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	{
 	  // Rk = raux;
 	  icodeinit = "ldr " + oreg + ",[raux]";
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit, NULL);
 	}
 
     }
@@ -658,12 +658,12 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
     ERROR_ACCESS(" ARM_LOAD_MULTIPLE", instructionAsm);
 }
 
-void ARM_BRANCH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_BRANCH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("ARM_BRANCH", instructionAsm);
 };
 
-void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   string vinstr = instructionAsm;
@@ -733,7 +733,7 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
     ERROR_ACCESS("(ARM_SHIFT ", instructionAsm);
 }
 
-void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // and*, orr*,eor*, bic* (and not)
   string op;
@@ -793,7 +793,7 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
    No effects on output register, but on the operand register in auto_indexing or post_indexing.
    Example : "STR R0, [R1, #4]!"  or "STR R0, [R1] #4". R1 := R1 + 4 after the memory transfert
 */
-void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string vinstr = instructionAsm;
   offsetType TypeOperand;
@@ -811,7 +811,7 @@ void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 	  else
 	    {
 	      ARM_ADD *obj_add = new ARM_ADD();
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3);
+	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3, NULL);
 	    }
 	}
 
@@ -843,27 +843,27 @@ void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackTy
     }
 }
 
-void ARM_COMPARE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_COMPARE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // DAA_TRACE("ARM_COMPARE", instructionAsm);
   // cpm*, cmn*, tst*; teq* : update the CPSR flags 
   // no effects on registers ( the flags are not managed , useful Damien ?)
 };
 
-void ARM_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   //  No effects on registers 
   //  DAA_TRACE("ARM_NOP", instructionAsm);
 };
 
-void ARM_STORE_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_STORE_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // DAA_TRACE("ARM_STORE_MULTIPLE", instructionAsm);
   // No effects on registers
 };
 
 
-void ARM_CONVERSION_DP_SP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_CONVERSION_DP_SP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   string vinstr = instructionAsm;
@@ -890,7 +890,7 @@ void ARM_CONVERSION_DP_SP::simulate(regTable & regs, regPrecisionTable & precisi
     ERROR_ACCESS("ARM_CONVERSION_DP_SP ", instructionAsm);
 }
 
-void ARM_NEGATE_FP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_NEGATE_FP::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   string op;
   string vinstr = instructionAsm;
@@ -923,7 +923,7 @@ void ARM_NEGATE_FP::simulate(regTable & regs, regPrecisionTable & precision, sta
 }
 
 
-void ARM_TODO_LOIC::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void ARM_TODO_LOIC::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("ARM_TODO_LOIC", instructionAsm);
 };
@@ -17,7 +17,7 @@ class ARM_COMMON:public DAAInstruction {
   void setRegistersInfos3ops(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision);
   void setRegistersInfosMultLong(regTable & regs, regPrecisionTable & precision);
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 
 };
 
@@ -26,7 +26,7 @@ class ARM_COMMON:public DAAInstruction {
 ///-------------------------------
 class ARM_ADD:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -34,7 +34,7 @@ class ARM_ADD:public ARM_COMMON {
 ///-------------------------------
 class ARM_SUBTRACT:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -42,7 +42,7 @@ class ARM_SUBTRACT:public ARM_COMMON {
 ///-------------------------------
 class ARM_DIV:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -50,7 +50,7 @@ class ARM_DIV:public ARM_COMMON {
 ///-------------------------------
 class ARM_REVERSE_SUB:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -58,7 +58,7 @@ class ARM_REVERSE_SUB:public ARM_COMMON {
 ///-------------------------------
 class ARM_MUL:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -66,7 +66,7 @@ class ARM_MUL:public ARM_COMMON {
 ///-------------------------------
 class ARM_MOV:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -74,79 +74,79 @@ class ARM_MOV:public ARM_COMMON {
 ///-------------------------------
 class ARM_LOAD:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_LOAD_MULTIPLE:public ARM_COMMON {
  public:
-  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+  void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_POP:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM NOP
 ///-------------------------------
 class ARM_NOP:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM STORE
 ///-------------------------------
 class ARM_PUSH:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_STORE:public ARM_COMMON {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_STORE_MULTIPLE:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM BRANCH
 ///-------------------------------
 class ARM_BRANCH:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM SHIFT / ROTATE
 ///-------------------------------
 class ARM_SHIFT:public ARM_COMMON {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM LOGICAL: and, eor, orr, bic (and not) 
 ///-------------------------------
 class ARM_LOGICAL:public ARM_COMMON {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_CONVERSION_DP_SP:public ARM_COMMON {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 class ARM_NEGATE_FP:public ARM_COMMON {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 ///-------------------------------
 ///     ARM COMPARE
 ///-------------------------------
 class ARM_COMPARE:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 // for test.
 class ARM_TODO_LOIC:public DAAInstruction {
- public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm);
+ public:void simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList *);
 };
 
 #endif
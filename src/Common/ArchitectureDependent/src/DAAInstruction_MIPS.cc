@@ -46,7 +46,7 @@ using namespace std;
 // registers -> no impact on address analysis
 //--------------------------------------------
 void
-Nop::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+Nop::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
 }
 
@@ -57,7 +57,7 @@ Nop::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack,
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   bool b;
   int i,n;
@@ -82,8 +82,8 @@ void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &
     }
   else
     {
-      vector < string > operands = getOperands(instructionAsm);
-      num_register0 = Arch::getRegisterNumber(operands[0]);
+      vector < string > operands = getOperands(instructionAsm, tokenised);
+      num_register0 = getOperandRegister(operands, tokenised, 0);
       size_t found = instructionAsm.find("gp");  
       if ( found != EOS ) // codop  R, -val(gp)
 	{
@@ -114,7 +114,7 @@ void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   bool b;
   int i, n;
@@ -147,7 +147,7 @@ void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType
 // because in the MIPS they kill the registers
 // used for the return values of functions
 //---------------------------------------------
-void DCall::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void DCall::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // removed by LBesnard, because:
   // 4005b4:	0c1004d2 	jal	401348 <filtez>
@@ -169,20 +169,20 @@ void DCall::simulate(regTable & regs, regPrecisionTable & precision, stackType &
 //
 // Transfer from register to register
 //---------------------------------------------
-void Move::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Move::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // mtc1 $t0, $f0      # f0 = t0   Note that destination is *second* reg.
   size_t vindex = instructionAsm.find ("mtc1");
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   if (vindex == EOS) 
     {
-      num_register0 = Arch::getRegisterNumber(operands[0]);
-      num_register1 = Arch::getRegisterNumber(operands[1]);
+      num_register0 = getOperandRegister(operands, tokenised, 0);
+      num_register1 = getOperandRegister(operands, tokenised, 1);
     }
   else
     {
-      num_register1 = Arch::getRegisterNumber(operands[0]);
-      num_register0 = Arch::getRegisterNumber(operands[1]);
+      num_register1 = getOperandRegister(operands, tokenised, 0);
+      num_register0 = getOperandRegister(operands, tokenised, 1);
 
     }
   move(regs, precision);
@@ -200,10 +200,10 @@ void Move::simulate(regTable & regs, regPrecisionTable & precision,  stackType &
 // operand and not the first one, category KILL_OP2
 // should be used instead.
 //---------------------------------------------
-void KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision);
 }
 
@@ -218,10 +218,10 @@ void KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackTyp
 // In case the instruction kills the first register operand and not
 // the second one, category KILL_OP1 should be used instead.
 // ---------------------------------------------
-void KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   killop2(regs, precision);
 }
 
@@ -234,13 +234,13 @@ void KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType
 //
 // Signed addition on registers
 //---------------------------------------------
-void Add::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void Add::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   size_t vindex;
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
 
    string regOperand2 =  regs[num_register2];
    vindex=  regOperand2.find ("-");
@@ -261,13 +261,13 @@ void Add::simulate(regTable & regs, regPrecisionTable & precision,stackType &vst
 // Unsigned addition of immediate to register
 // (rt <- rs + immediate)
 //---------------------------------------------
-void Addiu::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Addiu::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   size_t vindex;
 
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   num_register2 = MIPS_AUX_REGISTER;
   regs[num_register2] = operands[2];
   precision[num_register2] = true;
@@ -292,9 +292,9 @@ void Addiu::simulate(regTable & regs, regPrecisionTable & precision, stackType &
 //---------------------------------------------
 //TODO:2nd case: regs[num_register0]= "-" + operand2;
 /* to be added if needed (should be similar to the add simulate function)
-void Subu::simulate(vector<string>& regs, vector<bool>& precision, stackType &vstack, stackPrecType &vStackPrecision,  const string& instructionAsm)
+void Subu::simulate(vector<string>& regs, vector<bool>& precision, stackType &vstack, stackPrecType &vStackPrecision,  const string& instructionAsm, const cfglib::OperandList * tokenised)
 {
-    vector<string> operands= getOperands(instructionAsm);
+    vector<string> operands= getOperands(instructionAsm, tokenised);
     
     int num_register0 = MapRegistersMIPS::getRegisterNumber(operands[0]);
     int num_register1 = MapRegistersMIPS::getRegisterNumber(operands[1]);
@@ -324,12 +324,12 @@ void Subu::simulate(vector<string>& regs, vector<bool>& precision, stackType &vs
 }
 */
 
-void Subu::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Subu::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   minus(regs, precision);
 }
 
@@ -340,10 +340,10 @@ void Subu::simulate(regTable & regs, regPrecisionTable & precision,stackType &vs
 ///-------------------------------
 ///     LUI
 ///-------------------------------
-void Lui::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Lui::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   // the lui flag is used to specify that the immediate value must be shifted left 16 bits.
   loadConstant(regs, precision, operands[1] + "lui");
 }
@@ -351,10 +351,10 @@ void Lui::simulate(regTable & regs, regPrecisionTable & precision,stackType &vst
 ///-------------------------------
 ///     LI
 ///-------------------------------
-void Li::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Li::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   loadConstant(regs, precision, operands[1]);
 }
 
@@ -362,11 +362,11 @@ void Li::simulate(regTable & regs, regPrecisionTable & precision, stackType &vst
 /// SHIFT 
 //  ssl R1,R2,i with i in [0,31], ssl v0,v0,0  is a nop.
 //  sll, srl, sllv, srlv sra
-void Shift::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Shift::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   num_register2 = MIPS_AUX_REGISTER;
   if (  (voperator == "sll") || (voperator == "srl") || (voperator == "sra") )
     { 
@@ -44,7 +44,7 @@ using namespace std;
 // address analysis (Nop, ...)
 //--------------------------------------------
 void
-MSP_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+MSP_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
 }
 
@@ -56,7 +56,7 @@ MSP_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vst
 // because in the MIPS they kill the registers
 // used for the return values of functions
 //---------------------------------------------
-void MSP_CALL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void MSP_CALL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   num_register0 = Arch::getRegisterNumber("v0");
   num_register1 = Arch::getRegisterNumber("v1");
@@ -73,11 +73,11 @@ void MSP_CALL::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
 //
 // Transfer from register to register
 //---------------------------------------------
-void MSP_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void MSP_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   move(regs, precision);
 }
 
@@ -94,10 +94,10 @@ void MSP_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stackTy
 // operand and not the first one, category KILL_OP2
 // should be used instead.
 //---------------------------------------------
-void MSP_KILLOP1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void MSP_KILLOP1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision);
 }
 
@@ -111,11 +111,11 @@ void MSP_KILLOP1::simulate(regTable & regs, regPrecisionTable & precision,  stac
 //
 // Signed addition on registers
 //---------------------------------------------
-void MSP_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void MSP_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   add(regs, precision, true);
 }
 
@@ -125,11 +125,11 @@ void MSP_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackType
 //
 // Signed substraction between registers
 //---------------------------------------------
-void MSP_SUB::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void MSP_SUB::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   minus(regs, precision);
 }
 
@@ -141,11 +141,11 @@ void MSP_SUB::simulate(regTable & regs, regPrecisionTable & precision,stackType
 ///-------------------------------
 ///     SHIFT  
 ///-------------------------------
-void MSP_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void MSP_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   num_register2 = MSP430_AUX_REGISTER;
   regs[num_register2] = operands[2];
   precision[num_register2] = true;
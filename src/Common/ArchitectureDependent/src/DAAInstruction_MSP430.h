@@ -59,7 +59,7 @@ See CREDITS.txt for credits of authorship
 //--------------------------------------------
 class MSP_NOP:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -72,7 +72,7 @@ class MSP_NOP:public DAAInstruction
 //---------------------------------------------
 class MSP_CALL:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -82,7 +82,7 @@ class MSP_CALL:public DAAInstruction
 //---------------------------------------------
 class MSP_MOVE:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -99,7 +99,7 @@ class MSP_MOVE:public DAAInstruction
 //---------------------------------------------
 class MSP_KILLOP1:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///------------------------------------------------------------
@@ -113,7 +113,7 @@ class MSP_KILLOP1:public DAAInstruction
 //---------------------------------------------
 class MSP_ADD:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -123,7 +123,7 @@ class MSP_ADD:public DAAInstruction
 //---------------------------------------------
 class MSP_SUB:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///------------------------------------------------------------
@@ -135,7 +135,7 @@ class MSP_SUB:public DAAInstruction
 ///-------------------------------
 class MSP_SHIFT:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 #endif
@@ -41,15 +41,41 @@ using namespace std;
 
 #define REGISTERS_SWITCH(num1, num2) { int _aux_ = num1; num1 = num2; num2 = _aux_; }
 
-bool DAAInstruction_RISCV::getRegisterAndIndexStack(const string &instructionAsm, string &reg, int *i)
+/* Slot of the stack accessed by a load or a store, through sp or through a register holding
+   a stack relative value (frame pointer "addi s0,sp,32", pointer to a local of a caller).
+   The slot i holds the byte at offset (vstack.size() - 1 - i) from the stack pointer of the function.
+   onStack is set when the base register is relative to the stack pointer, even if it is not precise. */
+bool DAAInstruction_RISCV::getStackSlot(regTable & regs, regPrecisionTable & precision, stackType &vstack, const string &instructionAsm, const cfglib::OperandList *tokenised, bool *onStack, int *vindex)
 {
-  if (Arch::getRegisterAndIndexStack( instructionAsm, reg, i )) return true;
-  // sw ra,20(a5), and a5 = SP + VAL
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  // num_register1 = Arch::getRegisterNumber(operands[1]);
-  //   cout << "  DAAInstruction_RISCV::getRegisterAndIndexStack = " << operands[1] << endl;
-  return false;
+  int base, offset, k;
+  *onStack = false;
+  if (tokenised != NULL && tokenised->size() >= 2 && (*tokenised)[1].kind == cfglib::MemoryOperand)
+    {
+      base = (*tokenised)[1].reg;
+      offset = (*tokenised)[1].value;
+    }
+  else
+    {
+      vector < string > operands = getOperands(instructionAsm, tokenised);
+      if (operands.size() < 2 || operands[1].find("(") == EOS) return false;
+      string reg, val;
+      Utl::extractRegVal(operands[1], reg, val);
+      base = Arch::getRegisterNumber(reg);
+      offset = Utl::string2int(val);
+    }
+  if (base < 0 || base >= (int) regs.size()) return false;
+
+  string value = regs[base];
+  if (value == "sp") k = 0;
+  else if (!Utl::parseRefStackPointer(value, &k)) return false;
+  *onStack = true;
+  if (!precision[base]) return false;
+
+  int n = vstack.size();
+  int off = k + offset;
+  if (off < 0 || off >= n) return false;
+  *vindex = n - 1 - off;
+  return true;
 }
 
 void DAAInstruction_RISCV::minus(regTable & regs, regPrecisionTable & precision)
@@ -114,7 +140,7 @@ void DAAInstruction_RISCV::add(regTable & regs, regPrecisionTable & precision, b
 // registers -> no impact on address analysis
 //--------------------------------------------
 void
-RISCV_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+RISCV_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
 }
 
@@ -124,33 +150,25 @@ RISCV_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &v
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void RISCV_DLOAD::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_DLOAD::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
- bool b;
-  int i,n;
-  string reg;
+  bool onStack;
   int vindex;
 
-  b = getRegisterAndIndexStack(instructionAsm, reg, &n);
+  bool b = getStackSlot(regs, precision, vstack, instructionAsm, tokenised, &onStack, &vindex);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   if (b) 
     {
-      bool i_set = getStackIndexFromRegister(regs, RISCV_SP_REGISTER, &i);
-      num_register0 = Arch::getRegisterNumber(reg);
-      if ( i_set && getEffectiveStackIndex(vstack, n+i, (n == 0 ? 0 : -1 ), &vindex))
-	{
-	  regs[num_register0] = vstack[vindex];
-	  precision[num_register0] = vStackPrecision[vindex];
-	}
-      else
-	{
-	  regs[num_register0] = "*";
-	  precision[num_register0] = false;
-	}
+      regs[num_register0] = vstack[vindex];
+      precision[num_register0] = vStackPrecision[vindex];
+    }
+  else if (onStack)
+    {
+      killop1(regs, precision);
     }
   else
     {
-      vector < string > operands = getOperands(instructionAsm);
-      num_register0 = Arch::getRegisterNumber(operands[0]);
       size_t found = instructionAsm.find("gp");  
       if ( found != EOS ) // codop  R, -val(gp)
 	{
@@ -181,33 +199,36 @@ void RISCV_DLOAD::simulate(regTable & regs, regPrecisionTable & precision, stack
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void RISCV_DSTORE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void RISCV_DSTORE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  bool b;
-  int i,n;
-  string reg;
+  bool onStack;
+  int vindex;
 
-  // example : sw ra,20(sp)
-  b = getRegisterAndIndexStack(instructionAsm, reg, &n);
+  // example : sw ra,20(sp), sw a0,-20(s0)
+  bool b = getStackSlot(regs, precision, vstack, instructionAsm, tokenised, &onStack, &vindex);
   if (b)  
     {
-      bool i_set = getStackIndexFromRegister(regs, RISCV_SP_REGISTER, &i);
-      num_register0 = Arch::getRegisterNumber(reg);
-      int vindex;
-      if ( i_set && getEffectiveStackIndex(vstack, n+i, (n == 0 ? 0 : -1 ), &vindex))
-	{
-	  vstack[vindex] = regs[num_register0];
-	  vStackPrecision[vindex] = precision[num_register0];
-	}
-      else; // ????
-      /*
-      vstack[vindex] =  regs[num_register0];
-      vStackPrecision[vindex] = precision[num_register0]; */
+      vector < string > operands = getOperands(instructionAsm, tokenised);
+      num_register0 = getOperandRegister(operands, tokenised, 0);
+      // The slots overlapping the stored bytes (accesses of at most 8 bytes) are lost.
+      int size = Arch::getSizeOfMemoryAccess(instructionAsm);
+      for (int j = vindex - size + 1; j < vindex + 8; j++)
+	if (j >= 0 && j < (int) vstack.size() && j != vindex)
+	  {
+	    vstack[j] = "*";
+	    vStackPrecision[j] = false;
+	  }
+      vstack[vindex] = regs[num_register0];
+      vStackPrecision[vindex] = precision[num_register0];
     }
-  else
+  else if (onStack)
     {
-      // vector < string > operands = getOperands(instructionAsm);
-     cout << "*** DEBUG: RISCV_DSTORE::simulate, getRegisterAndIndexStack returns false for " <<  instructionAsm << endl;
+      // Unknown slot of the stack (array in the stack).
+      for (size_t j = 0; j < vstack.size(); j++)
+	{
+	  vstack[j] = "*";
+	  vStackPrecision[j] = false;
+	}
     }
 }
 
@@ -217,7 +238,7 @@ void RISCV_DSTORE::simulate(regTable & regs, regPrecisionTable & precision, stac
 // Call instruction.
 // Calls have to be in a specific category
 //---------------------------------------------
-void RISCV_DCALL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_DCALL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
  // @1  jal ra, @call
   // ra : return address = @1+4
@@ -231,12 +252,12 @@ void RISCV_DCALL::simulate(regTable & regs, regPrecisionTable & precision, stack
 //
 // Transfer from register to register
 //---------------------------------------------
-void RISCV_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void RISCV_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // mv | fmv.X.Y | fmv.X    RD, RS
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   move(regs, precision);
 }
 
@@ -252,10 +273,10 @@ void RISCV_MOVE::simulate(regTable & regs, regPrecisionTable & precision,  stack
 // operand and not the first one, category KILL_OP2
 // should be used instead.
 //---------------------------------------------
-void RISCV_KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision);
 }
 
@@ -270,10 +291,10 @@ void RISCV_KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  st
 // In case the instruction kills the first register operand and not
 // the second one, category KILL_OP1 should be used instead.
 // ---------------------------------------------
-void RISCV_KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   killop2(regs, precision);
 }
 
@@ -286,15 +307,15 @@ void RISCV_KillOp2::simulate(regTable & regs, regPrecisionTable & precision, sta
 //
 // Signed addition on registers
 //---------------------------------------------
-void RISCV_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void RISCV_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // add | addw | fadd.X  RD, RS1,RS2
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   size_t vindex;
 
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
 
   // swithing the operands for sp 
   if ( num_register2 == RISCV_SP_REGISTER )
@@ -319,13 +340,13 @@ void RISCV_ADD::simulate(regTable & regs, regPrecisionTable & precision,stackTyp
 // Unsigned addition of immediate to register
 // (rt <- rs + immediate)
 //---------------------------------------------
-void RISCV_ADDIU::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_ADDIU::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   size_t vindex;
 
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   num_register2 = RISCV_AUX_REGISTER;
   regs[num_register2] = operands[2];
   precision[num_register2] = true;
@@ -343,13 +364,13 @@ void RISCV_ADDIU::simulate(regTable & regs, regPrecisionTable & precision, stack
     }
 }
 
-void RISCV_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // sub | subw | fsub.X    RD,RS1,RS2
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   minus(regs, precision);
 }
 
@@ -360,10 +381,10 @@ void RISCV_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision,sta
 ///-------------------------------
 ///     LUI
 ///-------------------------------
-void RISCV_LUI::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void RISCV_LUI::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   // the lui flag is used to specify that the immediate value must be shifted left 16 bits.
   loadConstant(regs, precision, operands[1] + "lui");
 }
@@ -371,21 +392,21 @@ void RISCV_LUI::simulate(regTable & regs, regPrecisionTable & precision,stackTyp
 ///-------------------------------
 ///     LI
 ///-------------------------------
-void RISCV_LI::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void RISCV_LI::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   loadConstant(regs, precision, operands[1]);
 }
 
 
 /// SHIFT 
 // ssl R1,R2,i with i in [0,31], ssl v0,v0,0  is a nop.
-void RISCV_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void RISCV_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   num_register2 = RISCV_AUX_REGISTER;
   regs[num_register2] = operands[2];
   precision[num_register2] = true;
@@ -394,31 +415,31 @@ void RISCV_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stack
 }
 
 
-void RISCV_BRANCH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_BRANCH::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("RISCV_BRANCH", instructionAsm);
 };
 
-void RISCV_NEGATE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_NEGATE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // neg | negw | fneg.X   RD, RS
   DAA_TRACE("RISCV_NEGATE", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   mult(regs, precision);
 }
 
   
-void RISCV_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("RISCV_LOGICAL", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   if (voperator == "not") return op_not(regs, precision);
   
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   if (voperator == "and") return op_and(regs, precision);
   if (voperator == "or")  return op_or(regs, precision);
   if (voperator == "xor") return op_xor(regs, precision);
@@ -426,14 +447,14 @@ void RISCV_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, sta
 }
 
 
-void RISCV_LOGICAL_I::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_LOGICAL_I::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // ANDI, ORI, XORI are logical operations that perform bitwise AND, OR, and XOR on register rs1
   // and the sign-extended 12-bit immediate and place the result in rd.
   // Note, XORI rd, rs1, -1 performs a bitwise logical inversion of register rs1 (assembler pseudo-instruction NOT rd, rs).
   DAA_TRACE("RISCV_LOGICAL_I", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision); // NYI
   assert( (voperator == "andi") || (voperator == "ori") || (voperator == "xori"));
 
@@ -450,67 +471,67 @@ void RISCV_LOGICAL_I::simulate(regTable & regs, regPrecisionTable & precision, s
 }
 
 
-void RISCV_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // mul | mulw | fmul.X  rd,rs1,rs2
   DAA_TRACE("RISCV_MUL", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   mult(regs, precision);
 }
 
-void RISCV_DIV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_DIV::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // fdiv.X | div | divw rd,rs1,rs2
   DAA_TRACE("RISCV_DIV", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   divi(regs, precision);
 }
 
-void RISCV_REMAINDER::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_REMAINDER::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // If the second operand of / or % is zero the behavior is undefined; otherwise (a/b)*b + a%b is equal to a. 
   // If both operands are nonnegative then the remainder is nonnegative; if not, the sign of the remainder is implementation-defined.
   // REMW and REMUW instructions are only valid for RV64, and provide the corresponding signed and unsigned remainder operations respectively
   // Both REMW and REMUW always sign-extend the 32-bit result to 64 bits, including on a divide by zero
   DAA_TRACE("RISCV_REMAINDER", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
-  num_register2 = Arch::getRegisterNumber(operands[2]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
+  num_register2 = getOperandRegister(operands, tokenised, 2);
   remainder(regs, precision);
 }
 
 
 
-void RISCV_SIGN_EXTENDED_WORD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_SIGN_EXTENDED_WORD::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("RISCV_SIGN_EXTENDED_WORD", instructionAsm);
   // sext.w rd, rs
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
-  num_register1 = Arch::getRegisterNumber(operands[1]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
+  num_register1 = getOperandRegister(operands, tokenised, 1);
   regs[num_register0] = regs[num_register1];
   precision[num_register0] = precision[num_register1];
 }
 
 
-void RISCV_CONVERSION::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_CONVERSION::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   DAA_TRACE("RISCV_CONVERSION", instructionAsm);
   // fcvt.d.l, fcvt.d.lu, fcvt.d.w,fcvt.d.s, fcvt.s.w : 2 operands
   // fcvt.w.d, fcvt.l.d,  fcvt.s.d : 3 operands (third is the rounding mode : )
-  vector < string > operands = getOperands(instructionAsm);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
   
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   if ( operands.size() == 2)
     {
-      num_register1 = Arch::getRegisterNumber(operands[1]);
+      num_register1 = getOperandRegister(operands, tokenised, 1);
       regs[num_register0] = regs[num_register1];
       precision[num_register0] = precision[num_register1];
     }
@@ -526,17 +547,17 @@ register rd.
 FLT.S and FLE.S perform what the IEEE 754-2008 standard refers to as signaling comparisons:
 that is, an Invalid Operation exception is raised if either input is NaN. FEQ.S performs a quiet comparison: only signaling NaN inputs cause an Invalid Operation exception. For all three instructions,
 the result is 0 if either operand is NaN. */
-void RISCV_FP_COMPARE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_FP_COMPARE::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // feq | flt | fle RD, RS1,RS2 
   DAA_TRACE("RISCV_FP_COMPARE", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision); // NYI
 }
 
 
-void RISCV_SETIF::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm)
+void RISCV_SETIF::simulate(regTable & regs, regPrecisionTable & precision, stackType & vstack, stackPrecType & vStackPrecision, const string & instructionAsm, const cfglib::OperandList * tokenised)
 {
   // seqz, snez, sltz, sgtz 
   // seqz rd, rs :  rd = 1 if rs = zero   <=> sltiu rd, rs, 1
@@ -545,7 +566,7 @@ void RISCV_SETIF::simulate(regTable & regs, regPrecisionTable & precision, stack
   // sgtz rd, rs :  rd = 1 if rs> zero    <=> slt rd, x0, rs  
 
   DAA_TRACE("RISCV_SETIF", instructionAsm);
-  vector < string > operands = getOperands(instructionAsm);
-  num_register0 = Arch::getRegisterNumber(operands[0]);
+  vector < string > operands = getOperands(instructionAsm, tokenised);
+  num_register0 = getOperandRegister(operands, tokenised, 0);
   killop1(regs, precision); // NYI
 }
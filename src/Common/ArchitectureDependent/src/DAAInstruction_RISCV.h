@@ -57,7 +57,7 @@ class DAAInstruction_RISCV:public DAAInstruction
  protected:
   void add(regTable & regs, regPrecisionTable & precision, bool bAugmentPrecision);
   void minus(regTable & regs, regPrecisionTable & precision);
-  bool getRegisterAndIndexStack(const string &instructionAsm, string &reg, int *i);
+  bool getStackSlot(regTable & regs, regPrecisionTable & precision, stackType &vstack, const string &instructionAsm, const cfglib::OperandList *tokenised, bool *onStack, int *vindex);
 };
 
 ///-------------------------------
@@ -83,7 +83,7 @@ class DAAInstruction_RISCV:public DAAInstruction
 //--------------------------------------------
 class RISCV_NOP:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
@@ -94,7 +94,7 @@ class RISCV_NOP:public DAAInstruction
 //---------------------------------------------
 class RISCV_DLOAD:public DAAInstruction_RISCV
 {
-  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,   const string &);
+  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,   const string &, const cfglib::OperandList *);
 };
 
 
@@ -105,7 +105,7 @@ class RISCV_DLOAD:public DAAInstruction_RISCV
 //---------------------------------------------
 class RISCV_DSTORE:public DAAInstruction_RISCV
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -118,7 +118,7 @@ class RISCV_DSTORE:public DAAInstruction_RISCV
 //---------------------------------------------
 class RISCV_DCALL:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -128,7 +128,7 @@ class RISCV_DCALL:public DAAInstruction
 //---------------------------------------------
 class RISCV_MOVE:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -145,7 +145,7 @@ class RISCV_MOVE:public DAAInstruction
 //---------------------------------------------
 class RISCV_KillOp1:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -161,7 +161,7 @@ class RISCV_KillOp1:public DAAInstruction
 // ---------------------------------------------
 class RISCV_KillOp2:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///------------------------------------------------------------
@@ -175,7 +175,7 @@ class RISCV_KillOp2:public DAAInstruction
 //---------------------------------------------
 class RISCV_ADD:public DAAInstruction_RISCV
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -186,7 +186,7 @@ class RISCV_ADD:public DAAInstruction_RISCV
 //---------------------------------------------
 class RISCV_ADDIU:public DAAInstruction_RISCV
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 //---------------------------------------------
@@ -196,7 +196,7 @@ class RISCV_ADDIU:public DAAInstruction_RISCV
 //---------------------------------------------
 class RISCV_SUBTRACT:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///------------------------------------------------------------
@@ -208,7 +208,7 @@ class RISCV_SUBTRACT:public DAAInstruction
 ///-------------------------------
 class RISCV_LUI:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -216,7 +216,7 @@ class RISCV_LUI:public DAAInstruction
 ///-------------------------------
 class RISCV_LI:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 ///-------------------------------
@@ -224,67 +224,67 @@ class RISCV_LI:public DAAInstruction
 ///-------------------------------
 class RISCV_SHIFT:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
 /// Defined but nothing to do ???
 class RISCV_BRANCH:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class  RISCV_LOGICAL:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class  RISCV_LOGICAL_I:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class  RISCV_MUL:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class  RISCV_DIV:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class RISCV_NEGATE:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class  RISCV_REMAINDER:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
 class RISCV_SIGN_EXTENDED_WORD:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
 class RISCV_CONVERSION:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 class RISCV_FP_COMPARE:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
 class RISCV_SETIF:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &, const cfglib::OperandList *);
 };
 
 
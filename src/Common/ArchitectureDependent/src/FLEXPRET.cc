@@ -35,6 +35,8 @@ FLEXPRET::FLEXPRET(const bool is_big_endian_p, const string &dataPath)
 {
 	FileLoader *F = new FileLoader();
 	F->loadDataLatency("FLEXPRET", dataPath);
+	branchpred_wrongpred_cost = F->GetDataValue("_BRANCHPRED_WRONGPRED_", 0);
+	branchpred_missbtb_cost = F->GetDataValue("_BRANCHPRED_MISSBTB_", 0);
 
 	is_big_endian = is_big_endian_p;
 	zero_register_num = 0;
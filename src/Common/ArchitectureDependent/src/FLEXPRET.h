@@ -196,10 +196,19 @@ public:
 	void setMemoryLoadLatency(int val);
 	int getPipelineFlushCost() { return 0; };
 
+	/*! Branch prediction costs, entries _BRANCHPRED_WRONGPRED_ and
+	    _BRANCHPRED_MISSBTB_ of the latency data file (0 if not defined) */
+	int getBranchPredWrongPredCost(uint32_t, const string &) { return branchpred_wrongpred_cost; };
+	int getBranchPredMissBTBCost(uint32_t, const string &) { return branchpred_missbtb_cost; };
+
 private:
 	// Architecture endianness
 	bool is_big_endian;
 
+	// Branch prediction costs (latency data file)
+	int branchpred_wrongpred_cost;
+	int branchpred_missbtb_cost;
+
 	/***** Pipeline analysis functions *****/
 	/*! split the operands into a vector*/
 	vector<string> splitOperands(const string &operands);
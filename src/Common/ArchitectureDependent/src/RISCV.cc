@@ -36,6 +36,8 @@ RISCV::RISCV(const bool is_big_endian_p, const string &dataPath)
 {
    FileLoader *F = new FileLoader();
    F->loadDataLatency("RISCV", dataPath);
+   branchpred_wrongpred_cost = F->GetDataValue("_BRANCHPRED_WRONGPRED_", 0);
+   branchpred_missbtb_cost = F->GetDataValue("_BRANCHPRED_MISSBTB_", 0);
 
   is_big_endian = is_big_endian_p;
   zero_register_num = 0;
@@ -21,6 +21,7 @@
    ------------------------------------------------------------------------ */
 
 #include <climits>
+#include <cctype>
 #include <algorithm>
 #include "arch.h"
 #include "MIPS.h"
@@ -70,6 +71,7 @@ void Arch::init(const string & arch, const bool is_big_endian, const string &dat
     {      
       Logger::addFatal("Error: architecture '" + arch + "' not supported");
     }
+  instance->buildOpcodeTable();
 }
 
 //public destructor
@@ -174,6 +176,16 @@ InstructionType *Arch::getInstructionTypeFromAsm(const string & instr)
   return getInstance()->getInstructionTypeFromAsm(instr);
 }
 
+int Arch::getOpcodeFromAsm(const string & instr)
+{
+  return getInstance()->getOpcodeFromAsm(instr);
+}
+
+InstructionType *Arch::getInstructionTypeFromOpcode(int opcode)
+{
+  return getInstance()->getInstructionTypeFromOpcode(opcode);
+}
+
 int Arch::getRegisterNumber(const string & reg_name)
 {
   return getInstance()->getRegisterNumber(reg_name);
@@ -241,10 +253,83 @@ int Arch::getBranchPredMissBTBCost(uint32_t memlatency, const string &code) {
 
 //const string &Arch_dep::getObjdumpTextMarker(){return objdump_text_marker;}
 
+// FNV-1a hash of a mnemonic
+static uint32_t hashMnemonic(const char *mnemonic, size_t length)
+{
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < length; i++)
+    {
+      h ^= (unsigned char) mnemonic[i];
+      h *= 16777619u;
+    }
+  return h;
+}
+
+void Arch_dep::buildOpcodeTable()
+{
+  opcodeMnemonics.clear();
+  opcodeTypes.clear();
+  for (map < string, InstructionType * >::iterator it = mnemonicToInstructionTypes.begin(); it != mnemonicToInstructionTypes.end(); it++)
+    {
+      opcodeMnemonics.push_back(it->first);
+      opcodeTypes.push_back(it->second);
+    }
+
+  // load factor <= 1/4: a lookup almost always ends on the first probe
+  size_t size = 16;
+  while (size < 4 * opcodeMnemonics.size())
+    size *= 2;
+  opcodeTable.assign(size, -1);
+  for (size_t opcode = 0; opcode < opcodeMnemonics.size(); opcode++)
+    {
+      const string & mnemonic = opcodeMnemonics[opcode];
+      size_t slot = hashMnemonic(mnemonic.data(), mnemonic.size()) & (size - 1);
+      while (opcodeTable[slot] != -1)
+	slot = (slot + 1) & (size - 1);
+      opcodeTable[slot] = opcode;
+    }
+}
+
+int Arch_dep::findOpcode(const char *mnemonic, size_t length)
+{
+  assert(!opcodeTable.empty());
+  size_t mask = opcodeTable.size() - 1;
+  for (size_t slot = hashMnemonic(mnemonic, length) & mask; opcodeTable[slot] != -1; slot = (slot + 1) & mask)
+    {
+      const string & candidate = opcodeMnemonics[opcodeTable[slot]];
+      if (candidate.size() == length && candidate.compare(0, length, mnemonic, length) == 0)
+	return opcodeTable[slot];
+    }
+  return -1;
+}
+
+int Arch_dep::getOpcodeFromAsm(const string & instr)
+{
+  // assumed instr format: mnemonic operands (the mnemonic is the first word)
+  size_t begin = 0, end;
+  while (begin < instr.size() && isspace((unsigned char) instr[begin]))
+    begin++;
+  for (end = begin; end < instr.size() && !isspace((unsigned char) instr[end]); end++);
+  return findOpcode(instr.data() + begin, end - begin);
+}
+
+InstructionType *Arch_dep::getInstructionTypeFromOpcode(int opcode)
+{
+  assert(opcode >= 0 && opcode < (int) opcodeTypes.size());
+  return opcodeTypes[opcode];
+}
+
 InstructionType *Arch_dep::getInstructionTypeFromMnemonic(const string & mnemonic)
 {
-  if (mnemonicToInstructionTypes.find(mnemonic) != mnemonicToInstructionTypes.end())
+  if (!opcodeTable.empty())
+    {
+      int opcode = findOpcode(mnemonic.data(), mnemonic.size());
+      if (opcode != -1)
+	return opcodeTypes[opcode];
+    }
+  else if (mnemonicToInstructionTypes.find(mnemonic) != mnemonicToInstructionTypes.end())
     {
+      // architecture description under construction
       return mnemonicToInstructionTypes[mnemonic];
     }
   // the instruction does not exist, simply exit
@@ -254,11 +339,23 @@ InstructionType *Arch_dep::getInstructionTypeFromMnemonic(const string & mnemoni
 
 InstructionType *Arch_dep::getInstructionTypeFromAsm(const string & instr)
 {
-  // assumed instr format: mnemonic operands
-  string mnemonic;
-  istringstream parse(instr);
-  parse >> mnemonic;
-  return getInstructionTypeFromMnemonic(mnemonic);
+  if (opcodeTable.empty())
+    {
+      string mnemonic;
+      istringstream parse(instr);
+      parse >> mnemonic;
+      return getInstructionTypeFromMnemonic(mnemonic);
+    }
+  int opcode = getOpcodeFromAsm(instr);
+  if (opcode == -1)
+    {
+      // the instruction does not exist, simply exit
+      string mnemonic;
+      istringstream parse(instr);
+      parse >> mnemonic;
+      Logger::addFatal("Error: instruction asm \"" + mnemonic + "\" not defined");
+    }
+  return opcodeTypes[opcode];
 }
 
 int Arch_dep::getRegisterNumber(const string & reg_name)
@@ -114,6 +114,8 @@ public :
     static bool isMemPattern(const string& operand);
     static InstructionType* getInstructionTypeFromMnemonic(const string& mnemonic);
     static InstructionType* getInstructionTypeFromAsm(const string& instr);
+    static int getOpcodeFromAsm(const string& instr);
+    static InstructionType* getInstructionTypeFromOpcode(int opcode);
     static int getRegisterNumber(const string& reg_name);
     static bool isRegisterName(const string& reg_name);
     static bool isZeroRegister(const string& str);
@@ -450,6 +452,17 @@ public:
   /*! Returns the InstructionType object which corresponds to the mnemonic present in instr*/
   //assume instr: mnemonic ...
   InstructionType* getInstructionTypeFromAsm(const string& instr);
+
+  /*! Numbers the mnemonics (opcodes) and builds the hash table used by the lookups */
+  //called once the architecture description is complete (Arch::init)
+  void buildOpcodeTable();
+
+  /*! Returns the opcode of the mnemonic present in instr, -1 if the mnemonic is not defined */
+  //assume instr: mnemonic ...
+  int getOpcodeFromAsm(const string& instr);
+
+  /*! Returns the InstructionType object which corresponds to an opcode */
+  InstructionType* getInstructionTypeFromOpcode(int opcode);
     
   /*! Returns the number of instructions in the delay slot*/
   virtual int getNBInstrInDelaySlot()=0;
@@ -507,6 +520,9 @@ protected:
   
   /*! split the operands into a vector*/
   virtual vector<string> splitOperands(const string& operands)=0;
+
+  /*! Returns the opcode of a mnemonic given by its characters, -1 if not defined */
+  int findOpcode(const char* mnemonic, size_t length);
   
   
   /***** class fields *****/
@@ -519,6 +535,13 @@ protected:
     
   /*! map which associate a mnemonic with an InstructionType object*/
   map<string, InstructionType*> mnemonicToInstructionTypes;
+
+  /*! mnemonics and InstructionType objects indexed by opcode (dense numbering of mnemonicToInstructionTypes) */
+  vector<string> opcodeMnemonics;
+  vector<InstructionType*> opcodeTypes;
+
+  /*! open addressing hash table of the mnemonics (opcode or -1), its size is a power of 2 */
+  vector<int> opcodeTable;
   
   /*! map which associate a string register with its integer value*/
   //Even if there is no number associated to register in the architecture
@@ -85,6 +85,32 @@ namespace cfglib
      */
     void RemoveAttribute(std::string const& symbol) ;
 
+    /*! Enter/leave the concurrent mode, in which the attributes of the same
+     * objects may be accessed by several threads (analyses run concurrently):
+     * the accesses are then serialised per object, and the attributes replaced or
+     * removed stay allocated up to the end of the concurrent mode.
+     * Must be called when no other thread accesses attributes.
+     */
+    static void SetConcurrentAccess(bool concurrent);
+
+    /*! Start an attribute overlay (copy-on-write of the attributes): the
+     * attributes set or removed on any object up to DiscardOverlay, by any
+     * thread, are recorded, the original ones being kept aside.
+     * Cheap alternative to Program::Clone for results not to be kept.
+     * The overlays do not nest, and only cover attributes: the control flow
+     * must be left unchanged.
+     */
+    static void BeginOverlay();
+
+    /*! End the overlay, restoring the attributes of the objects to their
+     * state at BeginOverlay. Must be called when no other thread accesses
+     * attributes.
+     */
+    static void DiscardOverlay();
+
+    /*! @return true if an overlay is active */
+    static bool InOverlay();
+
     /*! Print information on the non serialisable attributes, by calling
      * their Print method. Used for debug only, to check that all
      * NonSerialisableAttributes are removed at the end of every analysis.
@@ -95,6 +121,10 @@ namespace cfglib
     std::ostream& WriteXmlAttributes(std::ostream& os,
 				     Handle& hand_ser) const ;
 
+    /*! @return true if one of the serialisable attributes is
+     * selected by the attribute filter of hand_ser */
+    bool HasSelectedAttributes(Handle& hand_ser) const;
+
     /*! Unserialise all attributes */
     void ReadXmlAttributes(XmlTag const* tag, 
 			   Handle& hand) ;
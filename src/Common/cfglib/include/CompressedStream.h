@@ -0,0 +1,95 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef CFGLIB_COMPRESSEDSTREAM_H
+#define CFGLIB_COMPRESSEDSTREAM_H
+
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <libxml/tree.h>
+
+namespace cfglib
+{
+  /** Compression of a program file, chosen by the extension of its
+      name: ".gz" (gzip, through zlib), ".zst" (zstd, only when built
+      with ZSTD=1), plain XML otherwise. */
+  typedef enum { NoCompression, GzipCompression, ZstdCompression } compression_kind;
+
+  /** Return the compression of a file from its name. */
+  compression_kind compressionOf(const std::string & file_name);
+
+  /** Output stream buffer compressing what is written into a file,
+      chunk after chunk: the compressed form is never built in
+      memory. */
+  class CompressedFileBuf:public std::streambuf
+  {
+  private:
+    compression_kind kind;
+    void *gz;			// gzFile
+    void *zstd;			// ZSTD_CStream*
+    FILE *file;			// output of the zstd stream
+    std::vector < char >buffer;	// uncompressed chunk
+    std::vector < char >out;	// compressed chunk (zstd)
+
+    /** Compress the pending chunk, and terminate the stream if end
+	is true. Return false on a write error. */
+    bool flushBuffer(bool end);
+  protected:
+    virtual int_type overflow(int_type c);
+    virtual int sync();
+  public:
+    CompressedFileBuf();
+    virtual ~CompressedFileBuf();
+
+    /** Open file_name for writing with the compression kind
+	(GzipCompression or ZstdCompression). Throws a string
+	when the file cannot be opened or when the compression is
+	not available. */
+    void open(const std::string & file_name, compression_kind k);
+
+    /** Terminate the compressed stream and close the file. Return
+	false on a write error. */
+    bool close();
+  };
+
+  /** std::ostream onto a compressed file. */
+  class CompressedOfstream:public std::ostream
+  {
+  private:
+    CompressedFileBuf buf;
+  public:
+    CompressedOfstream(const std::string & file_name, compression_kind k);
+    ~CompressedOfstream();
+    void close();
+  };
+
+  /** Parse the XML document of file_name, decompressing it on the fly
+      when its name ends with ".gz" or ".zst". Return NULL on a parse
+      error; throws a string when the file cannot be opened. */
+  xmlDocPtr readXmlFile(const std::string & file_name);
+
+} // cfglib::
+
+#endif
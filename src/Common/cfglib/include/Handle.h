@@ -26,6 +26,8 @@ See CREDITS.txt for credits of authorship
 /*! #includes and forward declarations */
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 #include "Factory.h"
 /*! #includes and forward declarations */
 #include "Serialisable.h"
@@ -48,6 +50,10 @@ namespace cfglib
 
     /*! maps used for serisalisation to attribute a unique identifier to a serialisable object*/
     std::map<Serialisable const*, int> identifiers ;
+
+    /*! attributes to serialise, exact names or prefixes ending
+     * with '*'. Empty: all the attributes are serialised. */
+    std::vector<std::string> attribute_filter;
     
   public:
     Handle() ;
@@ -81,6 +87,17 @@ namespace cfglib
 
     std::string getId(Serialisable const* obj);
 
+    /*! Restrict the serialised attributes to the ones matching
+     * patterns ("name" or "prefix*"). An empty vector restores
+     * the serialisation of all the attributes. */
+    void setAttributeFilter(std::vector<std::string> const& patterns);
+
+    /*! @return true if the serialised attributes are restricted */
+    bool isFilteringAttributes() const;
+
+    /*! @return true if the attribute name is to be serialised */
+    bool selectsAttribute(std::string const& name) const;
+
   } ;
   
 
@@ -24,6 +24,7 @@ See CREDITS.txt for credits of authorship
 #include <string>
 #include "Attributed.h"
 #include "CloneHandle.h"
+#include "Operand.h"
 
 namespace cfglib { class Numberize ; } // cf. "misc/handlers.h"
 namespace cfglib { class Handle ; } // cf. "misc/handlers.h"
@@ -52,6 +53,11 @@ namespace cfglib
   private:
     std::string code ;
     asm_type type ;
+    /*! opcode of the mnemonic given by the architecture (Arch::getOpcodeFromAsm), -1 if not resolved */
+    int opcode ;
+    /*! operands tokenised at extraction time, valid if tokenised is true */
+    OperandList operands ;
+    bool tokenised ;
   public:
     /*! Constructor */
     Instruction();
@@ -76,6 +82,17 @@ namespace cfglib
     /*! get the assembly code line */
     std::string GetCode() ;
 
+    /*! get/set the opcode of the instruction (not serialised, -1 if not resolved) */
+    int GetOpcode() {return opcode;}
+    void SetOpcode(int vopcode) {opcode = vopcode;}
+
+    /*! Returns true if the operands of the instruction have been tokenised */
+    bool HasOperands() {return tokenised;}
+
+    /*! get/set the tokenised operands of the instruction (serialised) */
+    const OperandList& GetOperands() {return operands;}
+    void SetOperands(const OperandList& voperands) {operands = voperands; tokenised = true;}
+
     /*! Returns true if the line is a Code line */
     bool IsCode() {return (type==Code);}
 
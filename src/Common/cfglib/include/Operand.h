@@ -0,0 +1,56 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef _IRISA_CFGLIB_OPERAND_H
+#define _IRISA_CFGLIB_OPERAND_H
+
+/*! #includes and forward declarations */
+#include <string>
+#include <vector>
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+	enum operand_kind {
+		RegisterOperand, /* register, reg is its number */
+		ImmediateOperand, /* decimal or hexadecimal constant, value is the constant */
+		MemoryOperand, /* offset(base), reg is the number of the base register, value the offset */
+		OtherOperand /* anything else (symbols, addresses, register lists, ...) */
+	} ;
+
+  /*! Operand of an instruction, tokenised once when the program is
+   * extracted (see Instruction::SetOperands). The text is the operand
+   * as it appears in the assembly code. */
+  struct Operand
+  {
+    operand_kind kind ;
+    int reg ;
+    long value ;
+    std::string text ;
+
+    Operand() : kind(OtherOperand), reg(-1), value(0) {}
+  } ;
+
+  typedef std::vector<Operand> OperandList ;
+
+} // cfglib::
+#endif // _IRISA_CFGLIB_OPERAND_H
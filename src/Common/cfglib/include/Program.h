@@ -111,15 +111,23 @@ namespace cfglib
     /** Deserialisation function. This function is the one
 	really meant for user usage. ReadXml should not be
 	used. cf. unserialise_program for precision on
-	arguments. */
+	arguments. ".gz" and ".zst" files are decompressed on the
+	fly. */
     static Program *unserialise_program_file(std::string const& file_name) ;
     
     /** Serialisation function. */
     std::ostream& serialise_program(std::ostream& os) ;
     
-    /** Serialisation to file function */
+    /** Serialisation to file function. The file is compressed
+	when its name ends with ".gz" (gzip) or ".zst" (zstd). */
     void serialise_program(std::string& file_name) ;
 
+    /** Serialisation to file of the attributes matching patterns
+	("name" or "prefix*") only. The instructions without such
+	attributes are left out: the file is a snapshot of results,
+	not meant to be unserialised. */
+    void serialise_program(std::string& file_name, std::vector<std::string> const& patterns) ;
+
   } ;
 
 } // cfglib::
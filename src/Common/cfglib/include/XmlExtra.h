@@ -125,6 +125,9 @@ public:
   /** Taking an attribute's of type string, acording to its name as parameter */
   string getAttributeString(string AttributeName) const;
 
+  /** True if the tag has an attribute of this name */
+  bool hasAttribute(string AttributeName) const;
+
   /** Return the XmlTag contents */
   string getContent() const;
 
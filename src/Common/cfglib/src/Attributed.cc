@@ -25,6 +25,10 @@ See CREDITS.txt for credits of authorship
 #include <map>
 #include <iostream>
 #include <cassert>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
 #include "Attributed.h"
 #include "Handle.h"
 #include "Factory.h"
@@ -36,8 +40,131 @@ namespace cfglib {
 }
 /*! this namespace is the global namespace */ namespace cfglib
 {
+  // Concurrent mode (see SetConcurrentAccess): the attribute maps are protected by
+  // a pool of locks, selected from the address of the attributed object, and the
+  // replaced/removed attributes are only deleted when the concurrent mode ends.
+#define NB_ATTRIBUTE_LOCKS 64
+  static std::atomic < bool > concurrent_access(false);
+  static std::mutex attribute_locks[NB_ATTRIBUTE_LOCKS];
+  static std::mutex retired_lock;
+  static std::vector < Attribute * >retired_attributes;
+
+  /*! Lock of the attribute map of an object, only taken in concurrent mode */
+  class AttributeLock {
+  private:
+    std::mutex * m;
+  public:
+    AttributeLock(const Attributed * a):m(NULL) {
+      if (concurrent_access)
+	{
+	  m = &attribute_locks[((uintptr_t) a >> 4) % NB_ATTRIBUTE_LOCKS];
+	  m->lock();
+	}
+    }
+    ~AttributeLock() {
+      if (m != NULL)
+	m->unlock();
+    }
+  };
+
+  /*! Delete an attribute no longer attached, or keep it until the end of the concurrent
+   * mode, references obtained by GetAttribute in other threads staying valid */
+  static void ReleaseAttribute(Attribute * a)
+  {
+    if (concurrent_access)
+      {
+	std::lock_guard < std::mutex > lock(retired_lock);
+	retired_attributes.push_back(a);
+      }
+    else
+      delete a;
+  }
+
+  // Attribute overlay (see BeginOverlay): attributes of every object modified since the
+  // beginning of the overlay, as they were at that time (NULL when absent). The journal is
+  // shared by all the threads (worker threads of the analysis run in the overlay), its
+  // accesses are serialised by overlay_lock.
+  typedef std::map < Attributed *, std::map < std::string, Attribute * > > overlay_journal;
+  static overlay_journal *overlay = NULL;
+  static std::mutex overlay_lock;
+
+  /*! Record the original value (current) of an attribute before its first change in the overlay.
+   * @return true if the attribute is now owned by the overlay (not to be deleted) */
+  static bool SaveInOverlay(Attributed * a, const std::string & symbol, Attribute * current)
+  {
+    if (overlay == NULL)
+      return false;
+    std::lock_guard < std::mutex > lock(overlay_lock);
+    std::map < std::string, Attribute * >&saved = (*overlay)[a];
+    if (saved.find(symbol) != saved.end())
+      return false;
+    saved[symbol] = current;
+    return current != NULL;
+  }
+
+  void Attributed::BeginOverlay()
+  {
+    std::lock_guard < std::mutex > lock(overlay_lock);
+    assert(overlay == NULL);
+    overlay = new overlay_journal();
+  }
+
+  void Attributed::DiscardOverlay()
+  {
+    std::lock_guard < std::mutex > lock(overlay_lock);
+    assert(overlay != NULL);
+    for (overlay_journal::iterator o = overlay->begin(); o != overlay->end(); ++o)
+      {
+	attributes_container & attrs = o->first->attributes;
+	for (std::map < std::string, Attribute * >::iterator s = o->second.begin(); s != o->second.end(); ++s)
+	  {
+	    attributes_container::iterator it(attrs.find(s->first));
+	    if (it != attrs.end())
+	      {
+		ReleaseAttribute(it->second);
+		if (s->second == NULL)
+		  attrs.erase(it);
+		else
+		  it->second = s->second;
+	      }
+	    else if (s->second != NULL)
+	      attrs[s->first] = s->second;
+	  }
+      }
+    delete overlay;
+    overlay = NULL;
+  }
+
+  bool Attributed::InOverlay()
+  {
+    return overlay != NULL;
+  }
+
+  void Attributed::SetConcurrentAccess(bool concurrent)
+  {
+    concurrent_access = concurrent;
+    if (!concurrent)
+      {
+	for (size_t i = 0; i < retired_attributes.size(); i++)
+	  delete retired_attributes[i];
+	retired_attributes.clear();
+      }
+  }
+
   /*! Destructor */
   Attributed::~Attributed() {
+    // Object created and deleted in the overlay, or deleted before its end: forget its original attributes
+    if (overlay != NULL)
+      {
+	std::lock_guard < std::mutex > lock(overlay_lock);
+	overlay_journal::iterator o(overlay->find(this));
+	if (o != overlay->end())
+	  {
+	    for (std::map < std::string, Attribute * >::iterator s = o->second.begin(); s != o->second.end(); ++s)
+	      delete s->second;
+	    overlay->erase(o);
+	  }
+      }
     // Deallocate attributes
     for (attributes_container::iterator it(this->attributes.begin()); it != this->attributes.end(); ++it)
       {
@@ -47,6 +174,7 @@ namespace cfglib {
    *  Must be called before any attempt to call method GetAttribute
    */ bool Attributed::HasAttribute(std::string symbol)
   {
+    AttributeLock lock(this);
     attributes_container::iterator it(this->attributes.find(symbol));
     return (it != this->attributes.end());
   }
@@ -69,6 +197,7 @@ namespace cfglib {
    */
   Attribute & Attributed::GetAttribute(std::string symbol)
   {
+    AttributeLock lock(this);
     attributes_container::iterator it(this->attributes.find(symbol));
     if (it == this->attributes.end())
       {
@@ -81,6 +210,7 @@ namespace cfglib {
 
   std::vector < string > Attributed::getAttributeList(void) {
     std::vector < string > attrList;
+    AttributeLock lock(this);
     for (attributes_container::iterator it = attributes.begin(); it != attributes.end(); it++)
       {
 	attrList.push_back(it->first);
@@ -115,13 +245,17 @@ namespace cfglib {
     // cout << " SetAttribute = " << symbol << endl;
     // Make a copy of the attribute
     Attribute *new_attribute = attribute.clone();
+    AttributeLock lock(this);
     // Delete the former attribute with same name, if any
     attributes_container::iterator it(this->attributes.find(symbol));
     if (it != this->attributes.end())
       {
 	assert(it->second != NULL);
-	delete it->second;
+	if (!SaveInOverlay(this, symbol, it->second))
+	  ReleaseAttribute(it->second);
       }
+    else
+      SaveInOverlay(this, symbol, NULL);
     // Store the new attribute
     (this->attributes)[symbol] = new_attribute;
   }
@@ -132,10 +266,12 @@ namespace cfglib {
    */
   void Attributed::RemoveAttribute(std::string const &symbol) {
     // cout << " removeAttribute = " << symbol << endl;
+    AttributeLock lock(this);
     attributes_container::iterator it(this->attributes.find(symbol));
     if (it != this->attributes.end())
       {
-	delete it->second;
+	if (!SaveInOverlay(this, symbol, it->second))
+	  ReleaseAttribute(it->second);
 	this->attributes.erase(it);
       }
   }
@@ -160,6 +296,23 @@ namespace cfglib {
 
   /*! Serialise all attributes */
   std::ostream & Attributed::WriteXmlAttributes(std::ostream & os, Handle & hand_ser) const {
+    if (hand_ser.isFilteringAttributes())
+      {
+	// Only the selected attributes, and no empty ATTRS_LIST
+	if (!this->HasSelectedAttributes(hand_ser))
+	  return os;
+	os << "<ATTRS_LIST>" << std::endl;
+	for (attributes_container::const_iterator it(this->attributes.begin()); it != this->attributes.end(); ++it)
+	  {
+	    if (!hand_ser.selectsAttribute(it->first))
+	      continue;
+	    it->second->SetName(it->first);
+	    if (SerialisableAttribute * sa = dynamic_cast < SerialisableAttribute * >(it->second))
+	      sa->WriteXml(os, hand_ser);
+	  }
+	os << "</ATTRS_LIST>" << std::endl;
+	return os;
+      }
     if (this->attributes.size() != 0)
       {
 	os << "<ATTRS_LIST>" << std::endl;
@@ -174,6 +327,14 @@ namespace cfglib {
     return os;
   }
 
+  /*! true if a serialisable attribute is selected by the filter of hand_ser */
+  bool Attributed::HasSelectedAttributes(Handle & hand_ser) const {
+    for (attributes_container::const_iterator it(this->attributes.begin()); it != this->attributes.end(); ++it)
+      if (hand_ser.selectsAttribute(it->first) && dynamic_cast < SerialisableAttribute * >(it->second) != NULL)
+	return true;
+    return false;
+  }
+
   /*! Unserialise all attributes */
   void Attributed::ReadXmlAttributes(XmlTag const *tag, Handle & hand) {
     ListXmlTag children = tag->searchChildren("ATTRS_LIST");
@@ -54,6 +54,7 @@ namespace cfglib {
 
     C->program = (Program *) handle.GetClone(this->program);
     C->external = external;
+    C->addr = addr;
 
     //clone every nodes
     for (std::vector < Node * >::iterator it = nodes.begin(); it != nodes.end(); it++)
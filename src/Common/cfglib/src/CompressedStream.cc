@@ -0,0 +1,299 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include "CompressedStream.h"
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include <libxml/parser.h>
+
+namespace cfglib
+{
+  // Size of the uncompressed chunks handed to the compressors.
+  static const size_t CHUNK_SIZE = 1 << 16;
+
+  static bool hasSuffix(const std::string & s, const std::string & suffix)
+  {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  compression_kind compressionOf(const std::string & file_name)
+  {
+    if (hasSuffix(file_name, ".gz"))
+      return GzipCompression;
+    if (hasSuffix(file_name, ".zst"))
+      return ZstdCompression;
+    return NoCompression;
+  }
+
+#ifndef HAVE_ZSTD
+  static std::string noZstd(const std::string & file_name)
+  {
+    return "ERROR: " + file_name + ": zstd compression is not available (rebuild Heptane with ZSTD=1)";
+  }
+#endif
+
+  /* ------------------------------------------------------------------
+     Output
+     ------------------------------------------------------------------ */
+
+  CompressedFileBuf::CompressedFileBuf():kind(NoCompression), gz(NULL), zstd(NULL), file(NULL)
+  {
+  }
+
+  CompressedFileBuf::~CompressedFileBuf()
+  {
+    close();
+  }
+
+  void CompressedFileBuf::open(const std::string & file_name, compression_kind k)
+  {
+    kind = k;
+    if (kind == GzipCompression)
+      {
+	gz = gzopen(file_name.c_str(), "wb");
+	if (gz == NULL)
+	  throw std::string("ERROR WHILE OPENING FILE : " + file_name);
+	gzbuffer((gzFile) gz, CHUNK_SIZE);
+      }
+    else if (kind == ZstdCompression)
+      {
+#ifdef HAVE_ZSTD
+	file = fopen(file_name.c_str(), "wb");
+	if (file == NULL)
+	  throw std::string("ERROR WHILE OPENING FILE : " + file_name);
+	ZSTD_CStream *cs = ZSTD_createCStream();
+	ZSTD_initCStream(cs, ZSTD_CLEVEL_DEFAULT);
+	zstd = cs;
+	out.resize(ZSTD_CStreamOutSize());
+#else
+	throw noZstd(file_name);
+#endif
+      }
+    else
+      throw std::string("ERROR: " + file_name + " is not a compressed file name");
+    buffer.resize(CHUNK_SIZE);
+    setp(&buffer[0], &buffer[0] + buffer.size());
+  }
+
+  bool CompressedFileBuf::flushBuffer(bool end)
+  {
+    size_t pending = pptr() - pbase();
+    setp(&buffer[0], &buffer[0] + buffer.size());
+    if (kind == GzipCompression)
+      return pending == 0 || gzwrite((gzFile) gz, &buffer[0], pending) == (int) pending;
+#ifdef HAVE_ZSTD
+    if (kind == ZstdCompression)
+      {
+	ZSTD_CStream *cs = (ZSTD_CStream *) zstd;
+	ZSTD_inBuffer input = { &buffer[0], pending, 0 };
+	while (input.pos < input.size)
+	  {
+	    ZSTD_outBuffer output = { &out[0], out.size(), 0 };
+	    if (ZSTD_isError(ZSTD_compressStream(cs, &output, &input)))
+	      return false;
+	    if (fwrite(&out[0], 1, output.pos, file) != output.pos)
+	      return false;
+	  }
+	size_t remaining = end ? 1 : 0;
+	while (remaining != 0)
+	  {
+	    ZSTD_outBuffer output = { &out[0], out.size(), 0 };
+	    remaining = ZSTD_endStream(cs, &output);
+	    if (ZSTD_isError(remaining))
+	      return false;
+	    if (fwrite(&out[0], 1, output.pos, file) != output.pos)
+	      return false;
+	  }
+      }
+#endif
+    return true;
+  }
+
+  CompressedFileBuf::int_type CompressedFileBuf::overflow(int_type c)
+  {
+    if (gz == NULL && zstd == NULL)
+      return traits_type::eof();
+    if (!flushBuffer(false))
+      return traits_type::eof();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      {
+	*pptr() = traits_type::to_char_type(c);
+	pbump(1);
+      }
+    return traits_type::not_eof(c);
+  }
+
+  /* std::endl flushes the stream at each line of the XML form: the
+     chunks are only compressed when full or when the file is closed,
+     which keeps the compression ratio of the large blocks. */
+  int CompressedFileBuf::sync()
+  {
+    return 0;
+  }
+
+  bool CompressedFileBuf::close()
+  {
+    bool ok = true;
+    if (gz != NULL)
+      {
+	ok = flushBuffer(true);
+	ok = (gzclose((gzFile) gz) == Z_OK) && ok;
+	gz = NULL;
+      }
+#ifdef HAVE_ZSTD
+    if (zstd != NULL)
+      {
+	ok = flushBuffer(true);
+	ZSTD_freeCStream((ZSTD_CStream *) zstd);
+	zstd = NULL;
+      }
+#endif
+    if (file != NULL)
+      {
+	ok = (fclose(file) == 0) && ok;
+	file = NULL;
+      }
+    return ok;
+  }
+
+  CompressedOfstream::CompressedOfstream(const std::string & file_name, compression_kind k):std::ostream(NULL)
+  {
+    buf.open(file_name, k);
+    rdbuf(&buf);
+  }
+
+  CompressedOfstream::~CompressedOfstream()
+  {
+    close();
+  }
+
+  void CompressedOfstream::close()
+  {
+    if (!buf.close())
+      setstate(std::ios::badbit);
+  }
+
+  /* ------------------------------------------------------------------
+     Input: the decompressed form is handed to libxml2 chunk after
+     chunk (xmlReadIO), whatever the zlib support of libxml2 itself.
+     ------------------------------------------------------------------ */
+
+  typedef struct
+  {
+    compression_kind kind;
+    gzFile gz;
+#ifdef HAVE_ZSTD
+    FILE *file;
+    ZSTD_DStream *ds;
+    std::vector < char >in;
+    ZSTD_inBuffer input;
+#endif
+  } XmlInput;
+
+  static int readInput(void *context, char *buffer, int len)
+  {
+    XmlInput *xi = (XmlInput *) context;
+    if (xi->kind == GzipCompression)
+      return gzread(xi->gz, buffer, len);
+#ifdef HAVE_ZSTD
+    ZSTD_outBuffer output = { buffer, (size_t) len, 0 };
+    while (output.pos == 0)
+      {
+	if (xi->input.pos == xi->input.size)
+	  {
+	    size_t n = fread(&xi->in[0], 1, xi->in.size(), xi->file);
+	    if (n == 0)
+	      return ferror(xi->file) ? -1 : 0;
+	    xi->input.src = &xi->in[0];
+	    xi->input.size = n;
+	    xi->input.pos = 0;
+	  }
+	if (ZSTD_isError(ZSTD_decompressStream(xi->ds, &output, &xi->input)))
+	  return -1;
+      }
+    return output.pos;
+#else
+    return -1;
+#endif
+  }
+
+  static int closeInput(void *context)
+  {
+    XmlInput *xi = (XmlInput *) context;
+    if (xi->kind == GzipCompression)
+      gzclose(xi->gz);
+#ifdef HAVE_ZSTD
+    if (xi->kind == ZstdCompression)
+      {
+	ZSTD_freeDStream(xi->ds);
+	fclose(xi->file);
+      }
+#endif
+    delete xi;
+    return 0;
+  }
+
+  xmlDocPtr readXmlFile(const std::string & file_name)
+  {
+    compression_kind kind = compressionOf(file_name);
+    if (kind == NoCompression)
+      return xmlParseFile(file_name.c_str());
+
+    XmlInput *xi = new XmlInput();
+    xi->kind = kind;
+    if (kind == GzipCompression)
+      {
+	xi->gz = gzopen(file_name.c_str(), "rb");
+	if (xi->gz == NULL)
+	  {
+	    delete xi;
+	    throw std::string("ERROR WHILE OPENING FILE : " + file_name);
+	  }
+	gzbuffer(xi->gz, CHUNK_SIZE);
+      }
+    else
+      {
+#ifdef HAVE_ZSTD
+	xi->file = fopen(file_name.c_str(), "rb");
+	if (xi->file == NULL)
+	  {
+	    delete xi;
+	    throw std::string("ERROR WHILE OPENING FILE : " + file_name);
+	  }
+	xi->ds = ZSTD_createDStream();
+	ZSTD_initDStream(xi->ds);
+	xi->in.resize(ZSTD_DStreamInSize());
+	xi->input.src = &xi->in[0];
+	xi->input.size = 0;
+	xi->input.pos = 0;
+#else
+	delete xi;
+	throw noZstd(file_name);
+#endif
+      }
+    // closeInput is called by libxml2, including on a parse error.
+    return xmlReadIO(readInput, closeInput, xi, file_name.c_str(), NULL, 0);
+  }
+
+} // cfglib::
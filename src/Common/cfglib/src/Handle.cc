@@ -120,4 +120,29 @@ namespace cfglib {
   std::string Handle::getId(Serialisable const *obj) {
     return int_to_string(identifiers[obj]);
   }
+
+  void Handle::setAttributeFilter(std::vector < std::string > const &patterns) {
+    attribute_filter = patterns;
+  }
+
+  bool Handle::isFilteringAttributes() const {
+    return !attribute_filter.empty();
+  }
+
+  bool Handle::selectsAttribute(std::string const &name) const {
+    if (attribute_filter.empty())
+      return true;
+    for (size_t i = 0; i < attribute_filter.size(); i++)
+      {
+	std::string const &pattern = attribute_filter[i];
+	if (!pattern.empty() && pattern[pattern.size() - 1] == '*')
+	  {
+	    if (name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0)
+	      return true;
+	  }
+	else if (name == pattern)
+	  return true;
+      }
+    return false;
+  }
 }				// cfglib::
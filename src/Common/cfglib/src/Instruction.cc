@@ -22,6 +22,8 @@
 
 #include <string>
 #include <iostream>
+#include <sstream>
+#include <stdlib.h>
 #include <assert.h>
 #include "Handle.h"
 #include "Helper.h"
@@ -34,10 +36,10 @@ namespace cfglib {
   /* forward declarations and #includes */
 
   /*! constructor */
-  Instruction::Instruction() {
+  Instruction::Instruction():opcode(-1), tokenised(false) {
     dbg_instr(std::cerr << "Instruction basic constructor called" << std::endl;
 	);
-  } Instruction::Instruction(std::string const &code, asm_type type):code(code), type(type) {
+  } Instruction::Instruction(std::string const &code, asm_type type):code(code), type(type), opcode(-1), tokenised(false) {
     dbg_instr(std::cerr << "Instruction constructor called" << std::endl;
 	);
   }
@@ -52,6 +54,9 @@ namespace cfglib {
   //TODO Register the instruction and its clone in the handle, if required.
   Instruction *Instruction::Clone(CloneHandle & handle) {
     Instruction *I = new Instruction(this->code, this->type);
+    I->opcode = this->opcode;
+    I->operands = this->operands;
+    I->tokenised = this->tokenised;
     //handle attributes
     this->CloneAttributesFor(I, handle);
     return I;
@@ -60,6 +65,9 @@ namespace cfglib {
   //TP
   Instruction *Instruction::Clone(void) {
     Instruction *I = new Instruction(this->code, this->type);
+    I->opcode = this->opcode;
+    I->operands = this->operands;
+    I->tokenised = this->tokenised;
 
     //handle attributes
     std::vector < string > attrList = getAttributeList();
@@ -109,13 +117,70 @@ namespace cfglib {
     assert(false);
   }
 
+  /* Operands are serialised as kind:reg:value:text, separated by ';'
+   * (kind is R, I, M or O, see operand_kind). The text is the last
+   * field, assembly operands contain no ';'. */
+  static char operand_kind_char[] = { 'R', 'I', 'M', 'O' };
+
+  static std::string operands_to_string(const OperandList & operands)
+  {
+    std::ostringstream os;
+    for (size_t i = 0; i < operands.size(); i++)
+      {
+	if (i != 0)
+	  os << ';';
+	os << operand_kind_char[operands[i].kind] << ':' << operands[i].reg << ':' << operands[i].value << ':' << operands[i].text;
+      }
+    return os.str();
+  }
+
+  static OperandList operands_from_string(const std::string & s)
+  {
+    OperandList result;
+    size_t begin = 0;
+    while (begin < s.size())
+      {
+	size_t end = s.find(';', begin);
+	if (end == std::string::npos)
+	  end = s.size();
+	Operand op;
+	const char *str = s.c_str() + begin;
+	switch (str[0])
+	  {
+	  case 'R': op.kind = RegisterOperand; break;
+	  case 'I': op.kind = ImmediateOperand; break;
+	  case 'M': op.kind = MemoryOperand; break;
+	  case 'O': op.kind = OtherOperand; break;
+	  default:
+	    std::cerr << "Malformed operands " << s << std::endl;
+	    assert(false);
+	  }
+	char *next;
+	assert(str[1] == ':');
+	op.reg = strtol(str + 2, &next, 10);
+	assert(*next == ':');
+	op.value = strtol(next + 1, &next, 10);
+	assert(*next == ':');
+	op.text = s.substr(next + 1 - s.c_str(), s.c_str() + end - (next + 1));
+	result.push_back(op);
+	begin = end + 1;
+      }
+    return result;
+  }
+
   /*! Serialisation function. Implements the
    * `Node` interface. */
   std::ostream & Instruction::WriteXml(std::ostream & os, Handle & hand)
   {
     using helper::escape_xml;
+    // Filtered snapshots only keep the instructions with selected attributes
+    if (hand.isFilteringAttributes() && !this->HasSelectedAttributes(hand))
+      return os;
     os << "  <INSTRUCTION "
-	<< " id=\"" << hand.identify(this) << "\" " << " asm_type=\"" << escape_xml(asm_string_from_type(this->type)) << "\" " << " code=\"" << (escape_xml(this->code)) << "\" " << " >" << std::endl;
+	<< " id=\"" << hand.identify(this) << "\" " << " asm_type=\"" << escape_xml(asm_string_from_type(this->type)) << "\" " << " code=\"" << (escape_xml(this->code)) << "\" ";
+    if (this->tokenised)
+      os << " operands=\"" << escape_xml(operands_to_string(this->operands)) << "\" ";
+    os << " >" << std::endl;
 
     this->WriteXmlAttributes(os, hand);
 
@@ -134,6 +199,9 @@ namespace cfglib {
     string id = tag->getAttributeString("id");
     assert(id != "");
     hand.addID_serialisable(id, this);
+    // operands are absent from the programs extracted before they were tokenised
+    if (tag->hasAttribute("operands"))
+      this->SetOperands(operands_from_string(tag->getAttributeString("operands")));
     this->ReadXmlAttributes(tag, hand);
   }
 
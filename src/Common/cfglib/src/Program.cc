@@ -30,6 +30,7 @@
 #include "Handle.h"
 #include "CloneHandle.h"
 #include "Factory.h"
+#include "CompressedStream.h"
 
 /* this namespace is the global namespace */
 namespace cfglib {
@@ -227,9 +228,36 @@ namespace cfglib {
   }
 
   void Program::serialise_program(std::string & file_name) {
-    std::ofstream output_file_stream;
-    output_file_stream.open(file_name.c_str());
-    this->serialise_program(output_file_stream);
+    compression_kind kind = compressionOf(file_name);
+    if (kind == NoCompression)
+      {
+	std::ofstream output_file_stream;
+	output_file_stream.open(file_name.c_str());
+	this->serialise_program(output_file_stream);
+      }
+    else
+      {
+	// Compressed on the fly, chunk after chunk
+	CompressedOfstream output_file_stream(file_name, kind);
+	this->serialise_program(output_file_stream);
+	output_file_stream.close();
+	if (!output_file_stream)
+	  throw string("ERROR WHILE WRITING FILE : " + file_name);
+      }
+  }
+
+  void Program::serialise_program(std::string & file_name, std::vector < std::string > const &patterns) {
+    this->hand.setAttributeFilter(patterns);
+    try
+      {
+	this->serialise_program(file_name);
+      }
+    catch(...)
+      {
+	this->hand.setAttributeFilter(std::vector < std::string > ());
+	throw;
+      }
+    this->hand.setAttributeFilter(std::vector < std::string > ());
   }
 
 } // cfglib::
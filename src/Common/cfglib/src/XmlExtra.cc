@@ -21,6 +21,7 @@ See CREDITS.txt for credits of authorship
 ------------------------------------------------------------------------ */
 
 #include "XmlExtra.h"
+#include "CompressedStream.h"
 #include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 
@@ -44,7 +45,7 @@ XmlDocument::XmlDocument(string fn)
 int XmlDocument::openDocument(string fn)
 {
   fileName = fn;
-  document = xmlParseFile(fileName.c_str());
+  document = cfglib::readXmlFile(fileName);
   if (!document)
     throw string("ERROR WHILE OPENING XML DOCUMENT : " + fn);
   return true;
@@ -154,6 +155,12 @@ string XmlTag::getAttributeString(string AttributeName) const
   return string("");
 }
 
+// Presence of an attribute
+bool XmlTag::hasAttribute(string AttributeName) const
+{
+  return xmlTag && xmlHasProp(xmlTag, (xmlChar *) AttributeName.c_str());
+}
+
 // Return the contents of a node
 string XmlTag::getContent() const
 {
@@ -60,3 +60,18 @@ int FileLoader::GetLatencyDataValue(string vinstr) {
   }
   return it->second ;
 }
+
+
+/**
+   @return the value assigned to a key (vkey) that is not an instruction, such as
+   a pipeline cost, vdefault if not found (the "_DEFAULT_VALUE_" symbol does not
+   apply). The key may be quoted in the file.
+*/
+int FileLoader::GetDataValue(string vkey, int vdefault) {
+  for (LatencyTableType::iterator it = LatencyTable.begin(); it != LatencyTable.end(); it++) {
+    string key = it->first;
+    Utl::rmSpaces(key);
+    if (key == vkey || key == "\"" + vkey + "\"") return it->second;
+  }
+  return vdefault;
+}
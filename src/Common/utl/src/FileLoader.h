@@ -17,6 +17,7 @@ class FileLoader {
  public:
    void loadDataLatency(string archiname, const string & dataPath);
    int GetLatencyDataValue(string vinstr);
+   int GetDataValue(string vkey, int vdefault);
  private :
    LatencyTableType LatencyTable;
 };
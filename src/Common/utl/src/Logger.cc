@@ -20,10 +20,17 @@
 
    ------------------------------------------------------------------------ */
 
+#include <mutex>
+#include <stdexcept>
 #include "Logger.h"
 
 //singleton declaration
 Logger * Logger::instance = NULL;
+bool Logger::FATAL_EXCEPTION = false;
+
+// Messages may be logged concurrently (workers of a cache sweep).
+// Recursive, since some of the public methods call each other.
+static recursive_mutex logger_mutex;
 
 Logger::Logger ()
 {
@@ -37,6 +44,7 @@ Logger::~Logger ()
 void
 Logger::kill ()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (instance)
     {
       delete instance;
@@ -47,6 +55,7 @@ Logger::kill ()
 void
 Logger::clean ()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (instance)
     {
       instance->error_state = false, instance->infos.clear ();
@@ -57,6 +66,7 @@ Logger::clean ()
 
 bool Logger::getErrorState ()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (!instance)
     {
       return false;
@@ -66,6 +76,7 @@ bool Logger::getErrorState ()
 
 bool Logger::isDebugMode ()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (!instance) instance = new Logger ();
   return instance->TRACE_MODE;
 }
@@ -73,6 +84,7 @@ bool Logger::isDebugMode ()
 void
 Logger::addError (const string & s)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (!instance)
     {
       instance = new Logger ();
@@ -84,6 +96,7 @@ Logger::addError (const string & s)
 void
 Logger::addWarning (const string & s)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (!instance)
     {
       instance = new Logger ();
@@ -94,6 +107,7 @@ Logger::addWarning (const string & s)
 void
 Logger::addInfo (const string & s)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (!instance)
     {
       instance = new Logger ();
@@ -104,17 +118,21 @@ Logger::addInfo (const string & s)
 void
 Logger::addFatal (const string & s)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (instance)
     {
       instance->print ();
     }
   cerr << "[FATAL]\t" << s << endl;
+  if (FATAL_EXCEPTION)
+    throw runtime_error (s);
   exit (-1);
 }
 
 void
 Logger::print ()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (instance && isDebugMode ())
     {
       for (size_t i = 0; i < instance->infos.size (); i++)
@@ -132,6 +150,7 @@ Logger::print ()
 void
 Logger::printDebug (const string & mess)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (isDebugMode ())
     {
       cout << mess << endl;
@@ -142,6 +161,7 @@ Logger::printDebug (const string & mess)
 void
 Logger::printVersion()
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   if (isDebugMode ())
     cout << "Heptane Analysis, version " << HEPTANE_VERSION << endl;
 }
@@ -149,12 +169,20 @@ Logger::printVersion()
 void
 Logger::print (const string & mess)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
   cout << mess << endl;
 }
 
 
 void Logger::setOptionTrace(bool b)
 {
+  lock_guard < recursive_mutex > lock (logger_mutex);
  if (!instance) instance = new Logger ();
   instance->TRACE_MODE = b;
 }
+
+void Logger::setFatalException(bool b)
+{
+  lock_guard < recursive_mutex > lock (logger_mutex);
+  FATAL_EXCEPTION = b;
+}
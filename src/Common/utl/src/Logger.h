@@ -31,7 +31,8 @@ See CREDITS.txt for credits of authorship
  - info:        print on cout (print function)
  - warning:     print on cerr (print function)
  - error:       print on cerr (print function)
- - fatal:       print on cerr (addFatal function)
+ - fatal:       print on cerr (addFatal function), then stop the program
+                (or throw a runtime_error, see setFatalException)
 
  Basic usage during an analysis to add a message:
     Logger::addInfo("mesg");
@@ -68,6 +69,8 @@ private:
   vector < string > infos;
   vector < string > warnings;
   vector < string > errors;
+  /** addFatal throws a runtime_error instead of stopping the program (server mode) */
+  static bool FATAL_EXCEPTION;
  public:
   /** delete the singleton */
   static void kill ();
@@ -95,6 +98,8 @@ private:
   /** Print the version of  Heptane in debug mode */
   static void printVersion();
   static void setOptionTrace(bool b);
+  /** When b is true, addFatal throws a runtime_error (with the fatal message) instead of stopping the program */
+  static void setFatalException(bool b);
 };
 
 #endif
@@ -4,6 +4,8 @@
  * and open the template in the editor.
  */
 #include "UtlCfgLib.h"
+#include "arch.h"
+#include "Utl.h"
 
 bool UtlCfgLib::isCondJump(Instruction *i) { 
     if(!i->HasAttribute(InstructionIsConditionalAttributeName))
@@ -38,4 +40,42 @@ bool UtlCfgLib::isBackwardJump(Instruction *i) {
 }
 bool UtlCfgLib::isJump(Instruction *i) {
     return isForwardJump(i) || isBackwardJump(i);
-}
\ No newline at end of file
+}
+
+static int registerNumber(const string &name) {
+    // isRegisterName also accepts the MSP430 indirect mode (@rn)
+    if (name == "" || name[0] == '@' || !Arch::isRegisterName(name))
+        return -1;
+    return Arch::getRegisterNumber(name);
+}
+
+void UtlCfgLib::tokenizeOperands(Instruction *i) {
+    vector<string> v = Arch::splitInstruction(i->GetCode());
+    OperandList operands;
+    for (size_t k = 1; k < v.size(); k++) {
+        Operand op;
+        op.text = v[k];
+        size_t open = op.text.find('(');
+        if (op.text == "") {
+            // OtherOperand
+        } else if ((op.reg = registerNumber(op.text)) != -1) {
+            op.kind = RegisterOperand;
+        } else if (Utl::isDecNumber(op.text)) {
+            op.kind = ImmediateOperand;
+            op.value = strtol(op.text.c_str(), NULL, 10);
+        } else if (Utl::isHexNumber(op.text)) {
+            op.kind = ImmediateOperand;
+            op.value = strtol(op.text.c_str(), NULL, 16);
+        } else if (open != string::npos && open > 0 && op.text[op.text.size() - 1] == ')'
+                   && Utl::isDecNumber(op.text.substr(0, open))) {
+            // offset(base), other addressing modes are kept as OtherOperand
+            op.reg = registerNumber(op.text.substr(open + 1, op.text.size() - open - 2));
+            if (op.reg != -1) {
+                op.kind = MemoryOperand;
+                op.value = strtol(op.text.c_str(), NULL, 10);
+            }
+        }
+        operands.push_back(op);
+    }
+    i->SetOperands(operands);
+}
@@ -29,6 +29,11 @@ namespace UtlCfgLib {
     bool isForwardJump(cfglib::Instruction *i);
     bool isBackwardJump(cfglib::Instruction *i);
     bool isJump(cfglib::Instruction *i);
+
+    /** Tokenises the operands of a Code instruction into register
+        numbers, immediates and offset(base) memory operands, and stores
+        them on the instruction (see cfglib::Operand) */
+    void tokenizeOperands(cfglib::Instruction *i);
 };
 
 #endif /* UTLCFGLIB_H */
@@ -55,3 +55,9 @@ bool Analysis::CheckPerformCleanup (bool printTime )
     }
   return res;
 }
+
+void Analysis::GetAttributeDependencies (set < string > &reads, set < string > &writes)
+{
+  reads.insert (AnyAttributeSlot);
+  writes.insert (AnyAttributeSlot);
+}
@@ -31,6 +31,7 @@ See CREDITS.txt for credits of authorship
 #define ANALYSIS_H
 
 #include <vector>
+#include <set>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -45,6 +46,11 @@ See CREDITS.txt for credits of authorship
 using namespace std;
 using namespace cfglib;
 
+/** Attribute slots for Analysis::GetAttributeDependencies, in addition to attribute names
+    (a name ending with '*' stands for all the attributes with this prefix, e.g. contextual attributes) */
+#define AnyAttributeSlot "*"
+#define CodeAddressSlot "address:code"	///< code addresses, set by HeptaneExtract
+#define DataAddressSlot "address:data"	///< data addresses of load/store instructions (DATAADDRESS)
 
 /**
  * Common interface of every analysis step
@@ -106,6 +112,12 @@ public:
   bool CheckPerformCleanup (bool printTime);
   void setName(string v)  { name = v;};
   string getName()  { return name;}
+
+  /** Attribute slots read and written by the analysis, used to run independent analyses
+      concurrently (AnalysisScheduler). The default (AnyAttributeSlot) makes the analysis
+      conflict with any other one.
+   */
+  virtual void GetAttributeDependencies (set < string > &reads, set < string > &writes);
 };
 
 #endif
@@ -25,6 +25,8 @@ See CREDITS.txt for credits of authorship
 #include "SharedAttributes/SharedAttributes.h"
 #include "Specific/HtmlPrint/HtmlPrint.h"
 #include "Generic/AnalysisHelper.h"
+#include "arch.h"
+#include "UtlCfgLib.h"
 
 #define PREFIX_CONTEXT "_c"
 
@@ -76,7 +78,8 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
   int ncalls, ntrue;
   bool res = true;
 
-  NonSerialisableIntegerAttribute visited(1);
+  // Nodes already pushed, kept aside from the node attributes (concurrent analyses, see AnalysisScheduler)
+  set < Node * >visited;
   ncalls = ntrue = 0;
 
   Cfg *c = config->getEntryPoint();
@@ -85,21 +88,20 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
   Node *n = c->GetStartNode();
   vector < Node * >vn;
   vn.push_back(n);
-  n->SetAttribute(VisitedInternalAttributeName, visited);
+  visited.insert(n);
 
   while (vn.size() != 0)
     {
       Node *n = vn[0];
       c = n->GetCfg();
-      assert(n->HasAttribute(VisitedInternalAttributeName));
+      assert(visited.count(n) == 1);
 
       // Scan the successors of n in the CFG
       vector < Node * >sucs = c->GetSuccessors(n);
       for (unsigned int i = 0; i < sucs.size(); i++)
 	{
-	  if (sucs[i]->HasAttribute(VisitedInternalAttributeName) == false)
+	  if (visited.insert(sucs[i]).second)
 	    {
-	      sucs[i]->SetAttribute(VisitedInternalAttributeName, visited);
 	      vn.push_back(sucs[i]);
 	    }
 	}
@@ -112,9 +114,8 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
 	  if (! callee->IsExternal())
 	    {
 	      Node *entry = callee->GetStartNode();
-	      if (! entry->HasAttribute(VisitedInternalAttributeName))
+	      if (visited.insert(entry).second)
 		{
-		  entry->SetAttribute(VisitedInternalAttributeName, visited);
 		  vn.push_back(entry);
 		}
 	    }
@@ -128,17 +129,6 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
       vn.erase(vn.begin());
     }
 
-  // Remove all "visited" attributes
-  vector < Cfg * >lcfg = p->GetAllCfgs();
-  for (unsigned int i = 0; i < lcfg.size(); i++)
-    {
-      vector < Node * >vn = lcfg[i]->GetAllNodes();
-      for (unsigned int n = 0; n < vn.size(); n++)
-	{
-	  vn[n]->RemoveAttribute(VisitedInternalAttributeName);
-	}
-    }
-
   return res;
 }
 
@@ -148,6 +138,32 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
 // Assumes there is an "address" attribute for every
 //   instruction of the basic block
 // ----------------------------------------------------------------
+// --------------------------------------------------
+// Instruction types: the opcodes resolved once by
+// ProgramCheck avoid parsing the code of the
+// instructions at every query
+// --------------------------------------------------
+InstructionType *AnalysisHelper::getInstructionType(Instruction * instr)
+{
+  int opcode = instr->GetOpcode();
+  if (opcode == -1)
+    return Arch::getInstructionTypeFromAsm(instr->GetCode());
+  return Arch::getInstructionTypeFromOpcode(opcode);
+}
+
+bool AnalysisHelper::isLoad(Instruction * instr)
+{
+  if (!getInstructionType(instr)->isLoad())
+    return false;
+  string code = instr->GetCode();
+  return !Arch::isPcLoadInstruction(code);
+}
+
+bool AnalysisHelper::isStore(Instruction * instr)
+{
+  return getInstructionType(instr)->isStore();
+}
+
 t_address AnalysisHelper::getStartAddress(Node * n)
 {
   vector < Instruction * >vi = n->GetAsm();
@@ -157,6 +173,66 @@ t_address AnalysisHelper::getStartAddress(Node * n)
   return (attr.getCodeAddress());
 }
 
+// --------------------------------------------------
+// Branch instruction ending a basic block
+// (the delay slots, if any, follow the branch)
+// --------------------------------------------------
+Instruction *AnalysisHelper::getBranchInstruction(Node * n)
+{
+  vector < Instruction * >vi = n->GetAsm();
+  int ibranch = (int) vi.size() - 1 - Arch::getNBInstrInDelaySlot();
+  if (ibranch < 0)
+    return NULL;
+  InstructionType *type = getInstructionType(vi[ibranch]);
+  if (type->isConditionalJump() || type->isUnconditionalJump() || type->isCall() || type->isReturn())
+    return vi[ibranch];
+  return NULL;
+}
+
+// --------------------------------------------------
+// Loop control branches: conditional branches of
+// the loop body (nested loops excluded) with one
+// successor staying in the loop and the other one
+// leaving it (loop test at the head, exit or latch
+// branch). A branch with both successors in the loop
+// (continue-like branch to the head) is not a loop
+// control branch: it does not follow the "stay then
+// leave once" pattern of the per-entry bounds.
+// --------------------------------------------------
+vector < Node * >AnalysisHelper::getLoopControlBranches(Cfg * c, Loop * l)
+{
+  vector < Node * >res;
+  vector < Node * >vn = l->GetAllNodesNotNested();
+  for (unsigned int i = 0; i < vn.size(); i++)
+    {
+      Node *n = vn[i];
+      if (n->IsCall() || n->isIsolatedNopNode())
+	continue;
+      Instruction *branch = getBranchInstruction(n);
+      if (branch == NULL || !getInstructionType(branch)->isConditionalJump())
+	continue;
+      if (getLoopStaySuccessor(c, l, n) != NULL)
+	res.push_back(n);
+    }
+  return res;
+}
+
+// --------------------------------------------------
+// Successor of n staying in loop l when the other
+// successor leaves it, NULL otherwise
+// --------------------------------------------------
+Node *AnalysisHelper::getLoopStaySuccessor(Cfg * c, Loop * l, Node * n)
+{
+  vector < Node * >succs = c->GetSuccessors(n);
+  if (succs.size() != 2)
+    return NULL;
+  bool in0 = l->FindInLoop(succs[0]);
+  bool in1 = l->FindInLoop(succs[1]);
+  if (in0 == in1)
+    return NULL;
+  return in0 ? succs[0] : succs[1];
+}
+
 //-----------------------------------------------
 // compute context for each cfg
 //
@@ -241,6 +317,24 @@ static bool CheckInstrHaveAddresses(Cfg * c, Node * n, void *param)
       Exits the analysis at first error found */
 void AnalysisHelper::ProgramCheck(Program * p)
 {
+  // Resolve the opcodes of the instructions once for all the analyses,
+  // and tokenise the operands of programs extracted without them
+  vector < Cfg * >cfgs = p->GetAllCfgs();
+  for (size_t c = 0; c < cfgs.size(); c++)
+    {
+      vector < Node * >nodes = cfgs[c]->GetAllNodes();
+      for (size_t n = 0; n < nodes.size(); n++)
+	{
+	  vector < Instruction * >vi = nodes[n]->GetAsm();
+	  for (size_t i = 0; i < vi.size(); i++)
+	    if (vi[i]->IsCode())
+	      {
+		vi[i]->SetOpcode(Arch::getOpcodeFromAsm(vi[i]->GetCode()));
+		if (!vi[i]->HasOperands())
+		  UtlCfgLib::tokenizeOperands(vi[i]);
+	      }
+	}
+    }
 
   // Check call that the program call graph is not cyclic, exit if cyclic
   CallGraph cg(p);
@@ -52,8 +52,7 @@ typedef unsigned long t_address;
 typedef bool t_node_function (Cfg * c, Node *, void *param);
 typedef bool t_node_function_six (Cfg * c, Node *, void *param, string in, string out, string type_analysis);
 
-// Name of internal attribute used by node scanning function applyToAllNodesRecursive
-#define VisitedInternalAttributeName "visited"
+class InstructionType;
 
 
 /**
@@ -91,9 +90,30 @@ class AnalysisHelper
   */
   static bool computeContext (Program * p);
 
+  /** Returns the InstructionType of an instruction, found from its opcode
+      when resolved by ProgramCheck (from its code otherwise) */
+  static InstructionType *getInstructionType (Instruction * instr);
+
+  /** Returns true if instr is a load (see Arch::isLoad) */
+  static bool isLoad (Instruction * instr);
+
+  /** Returns true if instr is a store (see Arch::isStore) */
+  static bool isStore (Instruction * instr);
+
   /** Returns the start address of a basic block */
   static t_address getStartAddress (Node * n);
 
+  /** Returns the branch instruction (jump, call or return) ending a basic block,
+      skipping the delay slots, NULL if the block does not end with a branch */
+  static Instruction *getBranchInstruction (Node * n);
+
+  /** Returns the nodes of loop l (nested loops excluded) ending with a conditional
+      branch with one successor in the loop and one out of it (loop control branches) */
+  static vector < Node * > getLoopControlBranches (Cfg * c, Loop * l);
+
+  /** Returns the successor of n in loop l when the other successor of n leaves l, NULL otherwise */
+  static Node *getLoopStaySuccessor (Cfg * c, Loop * l, Node * n);
+
   /** Apply function f to every node of CFG c. The parameter param is
       passed to function f. This method is not recursive. Whenever
       a node n in CFG c is a call to another CFG, f is called on n but
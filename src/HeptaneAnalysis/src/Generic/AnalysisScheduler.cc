@@ -0,0 +1,161 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <sstream>
+#include <stdexcept>
+#include "AnalysisScheduler.h"
+#include "Generic/Config.h"
+
+static mutex scheduler_mutex;
+static condition_variable scheduler_cv;
+
+AnalysisScheduler::AnalysisScheduler (Config * vcfg, int vnbthreads, bool vprintTime)
+{
+  cfg = vcfg;
+  nbthreads = vnbthreads;
+  printTime = vprintTime;
+  nbdone = 0;
+}
+
+AnalysisScheduler::~AnalysisScheduler ()
+{
+  // Pending analyses are only left after a fatal error (server mode, see Logger::setFatalException)
+  for (unsigned int i = 0; i < analyses.size (); i++)
+    delete analyses[i];
+}
+
+bool AnalysisScheduler::isSchedulable (Analysis * a)
+{
+  set < string > r, w;
+  a->GetAttributeDependencies (r, w);
+  return r.count (AnyAttributeSlot) == 0 && w.count (AnyAttributeSlot) == 0;
+}
+
+void AnalysisScheduler::addAnalysis (Analysis * a)
+{
+  set < string > r, w;
+  a->GetAttributeDependencies (r, w);
+  analyses.push_back (a);
+  reads.push_back (r);
+  writes.push_back (w);
+}
+
+bool AnalysisScheduler::intersect (const set < string > &s1, const set < string > &s2)
+{
+  for (set < string >::const_iterator i1 = s1.begin (); i1 != s1.end (); i1++)
+    for (set < string >::const_iterator i2 = s2.begin (); i2 != s2.end (); i2++)
+      {
+	bool w1 = (*i1)[i1->size () - 1] == '*', w2 = (*i2)[i2->size () - 1] == '*';
+	string p1 = w1 ? i1->substr (0, i1->size () - 1) : *i1;
+	string p2 = w2 ? i2->substr (0, i2->size () - 1) : *i2;
+	if (p1 == p2) return true;
+	if (w1 && p2.compare (0, p1.size (), p1) == 0) return true;
+	if (w2 && p1.compare (0, p2.size (), p2) == 0) return true;
+      }
+  return false;
+}
+
+// Runs the ready analyses up to the completion of all the pending ones
+void AnalysisScheduler::worker ()
+{
+  config = cfg;
+  unique_lock < mutex > lock (scheduler_mutex);
+  while (nbdone < analyses.size ())
+    {
+      if (ready.empty ())
+	{
+	  scheduler_cv.wait (lock);
+	  continue;
+	}
+      unsigned int i = ready.back ();
+      ready.pop_back ();
+
+      lock.unlock ();
+      string error;
+      try
+	{
+	  bool res = analyses[i]->CheckPerformCleanup (printTime);
+	  if (!res) Logger::addFatal ("Config: call to analysis failed");
+	}
+      catch (const exception & e)	// fatal error in the server mode, reported by run
+	{
+	  error = e.what ();
+	}
+      lock.lock ();
+      if (error != "" && failure == "") failure = error;
+
+      nbdone++;
+      for (unsigned int s = 0; s < successors[i].size (); s++)
+	if (--nbpreds[successors[i][s]] == 0) ready.push_back (successors[i][s]);
+      scheduler_cv.notify_all ();
+    }
+}
+
+void AnalysisScheduler::run ()
+{
+  unsigned int n = analyses.size ();
+  if (n == 0) return;
+
+  // Dependency DAG, from the XML order
+  successors.assign (n, vector < unsigned int >());
+  nbpreds.assign (n, 0);
+  ready.clear ();
+  nbdone = 0;
+  failure = "";
+  for (unsigned int i = 0; i < n; i++)
+    {
+      for (unsigned int j = 0; j < i; j++)
+	if (intersect (writes[j], reads[i]) || intersect (writes[j], writes[i]) || intersect (reads[j], writes[i]))
+	  {
+	    successors[j].push_back (i);
+	    nbpreds[i]++;
+	  }
+      if (nbpreds[i] == 0) ready.insert (ready.begin (), i);
+    }
+
+  stringstream infostr;
+  infostr << "AnalysisScheduler: " << n << " analyses, " << ready.size () << " initially independent (" << nbthreads << " threads)";
+  Logger::addInfo (infostr.str ());
+
+  Logger::clean ();
+  Attributed::SetConcurrentAccess (true);
+  unsigned int nbworkers = min ((unsigned int) nbthreads, n);
+  vector < thread > workers;
+  for (unsigned int t = 0; t < nbworkers; t++)
+    workers.push_back (thread (&AnalysisScheduler::worker, this));
+  for (unsigned int t = 0; t < nbworkers; t++)
+    workers[t].join ();
+  Attributed::SetConcurrentAccess (false);
+
+  for (unsigned int i = 0; i < n; i++)
+    delete analyses[i];
+  analyses.clear ();
+  reads.clear ();
+  writes.clear ();
+
+  if (failure != "") throw runtime_error (failure);	// already reported by Logger::addFatal
+  Logger::print ();
+  if (Logger::getErrorState ()) Logger::addFatal ("AnalysisScheduler: analyses failed");
+}
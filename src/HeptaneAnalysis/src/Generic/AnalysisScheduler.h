@@ -0,0 +1,85 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef ANALYSIS_SCHEDULER_H
+#define ANALYSIS_SCHEDULER_H
+
+#include <vector>
+#include <set>
+#include <string>
+#include "Analysis.h"
+
+class Config;
+
+/**
+ * Concurrent execution of a sequence of analyses (ANALYSIS tag with threads > 1).
+ *
+ * The analyses added to the scheduler are run on the same Program. The attribute
+ * slots read and written by every analysis (Analysis::GetAttributeDependencies) give
+ * a dependency DAG: an analysis depends on the previous analyses writing a slot
+ * it reads or writes, or reading a slot it writes. Independent analyses are run
+ * concurrently on worker threads, the dependent ones in the order of the XML file,
+ * so that the results are the same as with a sequential execution.
+ *
+ * Used in:
+ *  - Generic/Config.cc
+ */
+class AnalysisScheduler
+{
+ private:
+  /** Configuration installed in the worker threads */
+  Config *cfg;
+  int nbthreads;
+  bool printTime;
+
+  /** Pending analyses, in the XML order, with their dependencies */
+  vector < Analysis * > analyses;
+  vector < set < string > > reads, writes;
+
+  /** DAG: successors and number of unfinished predecessors of every analysis */
+  vector < vector < unsigned int > > successors;
+  vector < unsigned int > nbpreds;
+  vector < unsigned int > ready;
+  unsigned int nbdone;
+  /** Fatal error of an analysis run by a worker (server mode) */
+  string failure;
+
+  /** @return true if the slot sets s1 and s2 have a common slot ('*' suffix: prefix of slots) */
+  static bool intersect (const set < string > &s1, const set < string > &s2);
+
+  void worker ();
+
+ public:
+  AnalysisScheduler (Config * vcfg, int vnbthreads, bool vprintTime);
+  ~AnalysisScheduler ();
+
+  /** @return true if the analysis declares its dependencies (it can be run concurrently) */
+  static bool isSchedulable (Analysis * a);
+
+  /** Add an analysis (deleted by the scheduler once run) */
+  void addAnalysis (Analysis * a);
+
+  /** Run the pending analyses and wait for their completion */
+  void run ();
+};
+
+#endif
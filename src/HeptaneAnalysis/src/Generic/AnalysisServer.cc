@@ -0,0 +1,321 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <sstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include "AnalysisServer.h"
+#include "Generic/Config.h"
+#include "Generic/AnalysisHelper.h"
+#include "Generic/Timer.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "Logger.h"
+
+// ---------------------------------------------------
+//
+//  Minimal JSON support: flat objects of the requests
+//
+// ---------------------------------------------------
+
+/** Parse a JSON string starting at line[i] (a quote). @return false if malformed */
+static bool
+parseString (const string & line, size_t & i, string & s)
+{
+  s = "";
+  for (i++; i < line.size (); i++)
+    {
+      char c = line[i];
+      if (c == '"')
+	{
+	  i++;
+	  return true;
+	}
+      if (c == '\\')
+	{
+	  if (++i == line.size ())
+	    return false;
+	  c = line[i];
+	  if (c == 'n') c = '\n';
+	  else if (c == 't') c = '\t';
+	  else if (c != '"' && c != '\\' && c != '/') return false;
+	}
+      s += c;
+    }
+  return false;
+}
+
+static void
+skipSpaces (const string & line, size_t & i)
+{
+  while (i < line.size () && isspace (line[i]))
+    i++;
+}
+
+/** Parse a flat JSON object (string or number values) into fields. @return false if malformed */
+static bool
+parseRequest (const string & line, map < string, string > &fields)
+{
+  size_t i = 0;
+  skipSpaces (line, i);
+  if (i == line.size () || line[i++] != '{')
+    return false;
+  skipSpaces (line, i);
+  if (i < line.size () && line[i] == '}')
+    return true;
+  while (i < line.size ())
+    {
+      string name, value;
+      skipSpaces (line, i);
+      if (i == line.size () || line[i] != '"' || !parseString (line, i, name))
+	return false;
+      skipSpaces (line, i);
+      if (i == line.size () || line[i++] != ':')
+	return false;
+      skipSpaces (line, i);
+      if (i < line.size () && line[i] == '"')
+	{
+	  if (!parseString (line, i, value))
+	    return false;
+	}
+      else
+	while (i < line.size () && line[i] != ',' && line[i] != '}' && !isspace (line[i]))
+	  value += line[i++];
+      fields[name] = value;
+      skipSpaces (line, i);
+      if (i == line.size ())
+	return false;
+      if (line[i] == '}')
+	return true;
+      if (line[i++] != ',')
+	return false;
+    }
+  return false;
+}
+
+/** @return s as a JSON string */
+static string
+quote (const string & s)
+{
+  string res = "\"";
+  for (size_t i = 0; i < s.size (); i++)
+    {
+      char c = s[i];
+      if (c == '"' || c == '\\') res += '\\', res += c;
+      else if (c == '\n') res += "\\n";
+      else if (c == '\t') res += "\\t";
+      else if ((unsigned char) c >= 0x20) res += c;
+    }
+  return res + "\"";
+}
+
+// ---------------------------------------------------
+//
+//  Requests
+//
+// ---------------------------------------------------
+
+AnalysisServer::~AnalysisServer ()
+{
+  flush ("");
+}
+
+void
+AnalysisServer::flush (const string & file)
+{
+  for (map < string, Program * >::iterator it = programs.begin (); it != programs.end ();)
+    if (file == "" || it->first.compare (0, file.size () + 1, file + "|") == 0)
+      {
+	delete it->second;
+	programs.erase (it++);
+      }
+    else
+      it++;
+  if (file == "")
+    mtimes.clear ();
+  else
+    mtimes.erase (file);
+}
+
+void
+AnalysisServer::serve (istream & in, ostream & vout)
+{
+  // The log of the analyses is written on cout: sent to cerr, out only receives the responses
+  ostream out (vout.rdbuf ());
+  streambuf *coutbuf = cout.rdbuf (cerr.rdbuf ());
+  Logger::setFatalException (true);
+
+  string line;
+  while (getline (in, line))
+    {
+      map < string, string > request;
+      if (line.find_first_not_of (" \t\r") == string::npos)
+	continue;
+      if (!parseRequest (line, request))
+	{
+	  out << "{\"status\": \"error\", \"message\": \"malformed request\"}" << endl;
+	  continue;
+	}
+      string id = quote (request["id"]);
+      string command = request["command"];
+      if (command == "quit")
+	break;
+      if (command == "flush")
+	{
+	  flush ("");
+	  out << "{\"id\": " << id << ", \"status\": \"ok\"}" << endl;
+	  continue;
+	}
+      if (command != "" || request["config"] == "")
+	{
+	  out << "{\"id\": " << id << ", \"status\": \"error\", \"message\": \"unknown request\"}" << endl;
+	  continue;
+	}
+
+      Timer timer;
+      float time = 0.0;
+      timer.initTimer ();
+      try
+      {
+	string wcet = analyse (request["config"]);
+	timer.addTimer (time);
+	out << "{\"id\": " << id << ", \"status\": \"ok\", \"wcet\": " << quote (wcet) << ", \"time\": " << time << "}" << endl;
+      }
+      catch (const exception & e)
+      {
+	out << "{\"id\": " << id << ", \"status\": \"error\", \"message\": " << quote (e.what ()) << "}" << endl;
+      }
+      catch (const string & e)	// XmlDocument errors
+      {
+	out << "{\"id\": " << id << ", \"status\": \"error\", \"message\": " << quote (e) << "}" << endl;
+      }
+    }
+
+  Logger::setFatalException (false);
+  cout.rdbuf (coutbuf);
+}
+
+string
+AnalysisServer::analyse (const string & configFile)
+{
+  Config *saved = config;
+  Config *cfg = new Config ();
+  cfg->server = this;
+  config = cfg;
+  Logger::clean ();
+
+  string wcet = "-1";
+  try
+  {
+    cfg->FillArchitectureFromXml (configFile);
+    cfg->ExecuteFromXml (configFile, false);
+
+    // Retrieve the WCET, attached to the program entry point (IPET step with its results kept)
+    Cfg *c = (cfg->p != NULL) ? cfg->p->GetEntryPoint () : NULL;
+    if (c != NULL && c->HasAttribute (WCETAttributeName))
+      {
+	Attribute & attr = c->GetAttribute (WCETAttributeName);
+	SerialisableStringAttribute *sa = dynamic_cast < SerialisableStringAttribute * >(&attr);
+	if (sa != NULL)
+	  wcet = sa->GetValue ();
+	else
+	  wcet = to_string (((ExternalWCETAttributeNameType &) attr).GetValue ());
+      }
+  }
+  catch (...)
+  {
+    // Request aborted in the middle of a step whose results are not kept
+    if (Attributed::InOverlay ())
+      Attributed::DiscardOverlay ();
+    delete cfg->p;
+    delete cfg;
+    config = saved;
+    throw;
+  }
+  delete cfg->p;
+  delete cfg;
+  config = saved;
+  return wcet;
+}
+
+// ---------------------------------------------------
+//
+//  Resident programs
+//
+// ---------------------------------------------------
+
+Program *
+AnalysisServer::getProgram (const string & file, const string & ep, string & key)
+{
+  struct stat st;
+  if (stat (file.c_str (), &st) != 0)
+    Logger::addFatal ("AnalysisServer: cannot access " + file);
+  map < string, time_t >::iterator m = mtimes.find (file);
+  if (m != mtimes.end () && m->second != st.st_mtime)
+    flush (file);
+  mtimes[file] = st.st_mtime;
+
+  key = file + "|" + ep;
+  map < string, Program * >::iterator it = programs.find (key);
+  if (it == programs.end ())
+    {
+      Program *p = Program::unserialise_program_file (file);
+      if (p == NULL)
+	Logger::addFatal ("AnalysisServer: impossible to open file " + file);
+      // The checks and the contexts use the program of the configuration (deleted with it on a fatal error)
+      config->p = p;
+      AnalysisHelper::ProgramCheck (p);
+      if (!p->SetEntryPoint (ep))
+	Logger::addFatal ("Config: Bad entry point name " + ep);
+      AnalysisHelper::computeContext (p);
+      config->p = NULL;
+      it = programs.insert (make_pair (key, p)).first;
+    }
+  return it->second->Clone ();
+}
+
+Program *
+AnalysisServer::getResult (const string & key)
+{
+  map < string, Program * >::iterator it = programs.find (key);
+  return (it == programs.end ())? NULL : it->second->Clone ();
+}
+
+void
+AnalysisServer::keepResult (const string & key, Program * p)
+{
+  map < string, Program * >::iterator it = programs.find (key);
+  if (it != programs.end ())
+    delete it->second;
+  programs[key] = p->Clone ();
+}
+
+string
+AnalysisServer::getStepKey (const string & name, ParamAnalysis * pa)
+{
+  // Every parameter the results depend on is part of the key (the output file and attributes only affect the dump)
+  if (name == "DATAADDRESS" && pa->keep_results)
+    {
+      ParamDataAddress *pda = (ParamDataAddress *) pa;
+      return "|DATAADDRESS sp=" + to_string (pda->sp) + " widening_delay=" + to_string (pda->widening_delay);
+    }
+  return "";
+}
@@ -0,0 +1,90 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef ANALYSIS_SERVER_H
+#define ANALYSIS_SERVER_H
+
+#include <map>
+#include <string>
+#include <iostream>
+#include <time.h>
+#include "Analysis.h"
+
+class ParamAnalysis;
+
+/**
+ * Server mode (HeptaneAnalysis -server): the analysis requests are read on
+ * the standard input, one JSON object per line, and answered on the standard
+ * output in the same way:
+ *
+ *   {"id": "r1", "config": "path/to/configWCET.xml"}
+ *     -> {"id": "r1", "status": "ok", "wcet": "15030", "time": 0.12}
+ *     -> {"id": "r1", "status": "error", "message": "..."}
+ *   {"command": "flush"}   forget the resident programs
+ *   {"command": "quit"}
+ *
+ * The programs read by the ENTRYPOINT steps stay resident between the
+ * requests, checked and with the contexts of their entry point, so that a
+ * request only pays for a copy of them. The results of the configuration-
+ * independent steps that directly follow (DATAADDRESS) are kept as well.
+ * A program is read again when its file was modified. A fatal error of a
+ * request is reported in its response, the server going on with the next one.
+ * The log of the analyses goes to the standard error.
+ *
+ * Used in:
+ *  - main.cc
+ *  - Generic/Config.cc
+ */
+class AnalysisServer
+{
+ private:
+  /** Resident programs and results of the steps applied to them, by key (see getStepKey) */
+  map < string, Program * > programs;
+  /** Modification time of the file of every resident program */
+  map < string, time_t > mtimes;
+
+  /** Forget the resident programs read from file (all of them when file is empty) */
+  void flush (const string & file);
+
+  /** Run the analyses of a configuration file. @return the WCET of the entry point */
+  string analyse (const string & configFile);
+
+ public:
+  ~AnalysisServer ();
+
+  /** Answer the requests of in on out, up to a quit command or the end of in */
+  void serve (istream & in, ostream & out);
+
+  /** @return a copy of the program of file with ep as entry point, and its key */
+  Program *getProgram (const string & file, const string & ep, string & key);
+
+  /** @return a copy of the results kept for key, NULL if none */
+  Program *getResult (const string & key);
+
+  /** Keep a copy of p, results of the steps of key */
+  void keepResult (const string & key, Program * p);
+
+  /** @return the key of a step whose results can be kept (configuration-independent), with all the parameters of the step, "" otherwise */
+  static string getStepKey (const string & name, ParamAnalysis * pa);
+};
+
+#endif
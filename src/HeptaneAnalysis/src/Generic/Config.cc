@@ -41,9 +41,17 @@
 #include "Specific/SESEAnalysis/SESEAnalysis.h"
 #include "arch.h"
 #include "Specific/DummyAnalysis/DummyAnalysis.h"
+#include "Specific/CacheSweep/CacheSweep.h"
+#include "Specific/BranchPredAnalysis/BranchPredAnalysis.h"
+#include "Specific/CRPDAnalysis/CRPDAnalysis.h"
+#include "Specific/Simulation/SimulationAnalysis.h"
 #include "Generic/Timer.h"
+#include "Generic/AnalysisScheduler.h"
+#include "Generic/AnalysisServer.h"
+#include "Utl.h"
 
-Config *config = new Config ();	// global object.
+static Config *main_config = new Config ();
+thread_local Config *config = main_config;	// global object (per thread, see Config.h).
 
 #define ON "on"
 #define OFF "off"
@@ -66,6 +74,8 @@ Config::Config ()
   memory_store_latency = 0;
   input_output_dir = "./";
   entrypoint=string("");
+  p = NULL;
+  server = NULL;
   initParameters();
 }
 
@@ -139,44 +149,7 @@ Config::FillArchitectureFromXml (string xml_file)
       // Initialization of cache parameters
       else if (currName == "CACHE")
 	{
-	  CacheParam *cp = new CacheParam (ltarch[i]);
-	  if ((cp->type == ICACHE) && perfectIcache )
-	    {
-	      Logger::addFatal ("Config: picache/icache directives are incompatible");
-	    }
-	  else
-	    if (( cp->type == DCACHE) && perfectDcache )
-	      {
-		Logger::addFatal ("Config: pdcache/dcache directives are incompatible");
-	      }
-	    else
-	      { 
-		t_cache_type tCache = cp->type;
-		if ((tCache == ICACHE || tCache == PERFECTICACHE) && cp->level > nb_icache_levels) nb_icache_levels = cp->level;
-		if ((tCache == DCACHE || tCache == PERFECTDCACHE) && cp->level > nb_dcache_levels) nb_dcache_levels = cp->level;
-		if (tCache == PERFECTICACHE)
-		  {
-		    if (perfectIcache) Logger::addFatal ("Config: configuration file should have atmost one perfect instruction cache directive");
-		    if (cp->level != 1)
-		      {
-			Logger::addWarning ("Config: the level for a  perfect instruction cache must be 1, set to 1");
-			cp->level = 1;
-		      }
-		    perfectIcache = true;
-		  }
-		else
-		  if ( tCache == PERFECTDCACHE)
-		    {
-		      if (perfectDcache)  Logger::addFatal ("Config: configuration file should have atmost one perfect data cache directive");
-		      if (cp->level != 1)
-			{
-			  Logger::addWarning ("Config: the level for a  perfect instruction cache must be 1, set to 1");
-			  cp->level = 1;
-			}
-		      perfectDcache = true;
-		    }
-		cache_params[cp->level].push_back (cp);
-	      }
+	  addCache (new CacheParam (ltarch[i]));
 	}      
       else // Initialization of memory parameters.
 	if (currName == "MEMORY")
@@ -200,16 +173,22 @@ Config::FillArchitectureFromXml (string xml_file)
 	  else; // Comments are ignored.
     }
 
-  if (!perfectIcache && !perfectDcache && (nb_icache_levels != nb_dcache_levels))
-    Logger::addFatal ("Config: configuration file should have the same levels for caches, except the perfect caches.");
-  
+  checkCacheHierarchy ();
+
   if (!has_memory)
     Logger::addFatal ("Config: configuration file should have one unique MEMORY tag");
   if (!target_found)
     Logger::addFatal ("Config: configuration file should have a TARGET tag");
 
-  // Creating the dependant architecture instance (MIPS, ARM, MSP430, ...)
-  Arch::init (arch_name, arch_endianness == "BIG", dataPath);
+  // Creating the dependant architecture instance (MIPS, ARM, MSP430, ...),
+  // kept while unchanged (successive requests of the server mode)
+  static string arch_key;
+  string key = arch_name + " " + arch_endianness + " " + dataPath;
+  if (key != arch_key)
+    {
+      Arch::init (arch_name, arch_endianness == "BIG", dataPath);
+      arch_key = key;
+    }
 
   // Initialization of latencies per cache level
   /*  for (unsigned int i = 1; i <= cache_params.size (); i++)
@@ -225,6 +204,61 @@ Config::FillArchitectureFromXml (string xml_file)
   */
 }
 
+// ---------------------------------------------------
+//
+//  Add a cache to the hierarchy (from the ARCHITECTURE
+//  section or from a design point of a cache sweep)
+//
+// ---------------------------------------------------
+void
+Config::addCache (CacheParam * cp)
+{
+  if ((cp->type == ICACHE) && perfectIcache )
+    {
+      Logger::addFatal ("Config: picache/icache directives are incompatible");
+    }
+  else
+    if (( cp->type == DCACHE) && perfectDcache )
+      {
+	Logger::addFatal ("Config: pdcache/dcache directives are incompatible");
+      }
+    else
+      { 
+	t_cache_type tCache = cp->type;
+	if ((tCache == ICACHE || tCache == PERFECTICACHE) && cp->level > nb_icache_levels) nb_icache_levels = cp->level;
+	if ((tCache == DCACHE || tCache == PERFECTDCACHE) && cp->level > nb_dcache_levels) nb_dcache_levels = cp->level;
+	if (tCache == PERFECTICACHE)
+	  {
+	    if (perfectIcache) Logger::addFatal ("Config: configuration file should have atmost one perfect instruction cache directive");
+	    if (cp->level != 1)
+	      {
+		Logger::addWarning ("Config: the level for a  perfect instruction cache must be 1, set to 1");
+		cp->level = 1;
+	      }
+	    perfectIcache = true;
+	  }
+	else
+	  if ( tCache == PERFECTDCACHE)
+	    {
+	      if (perfectDcache)  Logger::addFatal ("Config: configuration file should have atmost one perfect data cache directive");
+	      if (cp->level != 1)
+		{
+		  Logger::addWarning ("Config: the level for a  perfect instruction cache must be 1, set to 1");
+		  cp->level = 1;
+		}
+	      perfectDcache = true;
+	    }
+	cache_params[cp->level].push_back (cp);
+      }
+}
+
+void
+Config::checkCacheHierarchy ()
+{
+  if (!perfectIcache && !perfectDcache && (nb_icache_levels != nb_dcache_levels))
+    Logger::addFatal ("Config: configuration file should have the same levels for caches, except the perfect caches.");
+}
+
 /** TO BE REVISITED/ADPATED 
     Fill the architecture parameters by adding a cache to the current configuration
 void
@@ -295,12 +329,16 @@ ParamAnalysis * Config::getParameters(string directive, string input_output_dir,
   if (directive == "HTMLPRINT") { return new ParamHtmlPrint (analysis); }
   if (directive == "CACHESTATISTICS") { return new ParamCacheStatistics (analysis);}
 
-  // Analysis ::= ICACHE | PIPELINE | IPET | DATAADDRESS | DCACHE | DUMMYANALYSIS
+  // Analysis ::= ICACHE | PIPELINE | IPET | DATAADDRESS | DCACHE | DUMMYANALYSIS | SWEEP | BRANCHPRED | CRPD | SIMULATION
   if (directive == "ICACHE") { return new ParamICache (analysis); }
   if (directive == "DATAADDRESS") { return new ParamDataAddress (analysis); }
   if (directive == "DCACHE") { return new ParamDCache (analysis); }
   if (directive == "PIPELINE") { return  new ParamPipeline (analysis); }
   if (directive == "IPET") { return  new ParamIPET (analysis); }
+  if (directive == "SWEEP") { return  new ParamCacheSweep (analysis); }
+  if (directive == "BRANCHPRED") { return  new ParamBranchPred (analysis); }
+  if (directive == "CRPD") { return  new ParamCRPD (analysis); }
+  if (directive == "SIMULATION") { return  new ParamSimulation (analysis); }
   // Fatal error otherwise.
   string error_msg = "Config: unknown analysis type " + directive;
   Logger::addFatal (error_msg);
@@ -365,11 +403,14 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
   if (directive == "DATAADDRESS") 
     {
       ParamDataAddress *ps = (ParamDataAddress *) pa;
-      if (arch_name == "MIPS") return new MIPSAddressAnalysis (p, ps->sp);
-      if (arch_name == "ARM") return new ARMAddressAnalysis (p, ps->sp);
-      if (arch_name == "MSP430") return new MSP430AddressAnalysis (p, ps->sp);
-      if (arch_name == "RISCV") return new RISCVAddressAnalysis (p, ps->sp);
-      Logger::addFatal ("Config : AddressAnalysis not defined for " + arch_name + " architecture");
+      AddressAnalysis *aa = NULL;
+      if (arch_name == "MIPS") aa = new MIPSAddressAnalysis (p, ps->sp);
+      else if (arch_name == "ARM") aa = new ARMAddressAnalysis (p, ps->sp);
+      else if (arch_name == "MSP430") aa = new MSP430AddressAnalysis (p, ps->sp);
+      else if (arch_name == "RISCV") aa = new RISCVAddressAnalysis (p, ps->sp);
+      else Logger::addFatal ("Config : AddressAnalysis not defined for " + arch_name + " architecture");
+      aa->setWideningDelay (ps->widening_delay);
+      return aa;
     }
 
   if (directive == "DCACHE")
@@ -397,7 +438,33 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
   if (directive == "IPET")
     {
       ParamIPET *ps = (ParamIPET *) pa;
-      return new IPETAnalysis (p, ps->solver, ps->pipeline, ps->attach_WCET_info, ps->generate_node_freq, getNbICacheLevels (), getNbDCacheLevels (), cache_params);
+      return new IPETAnalysis (p, ps->solver, ps->pipeline, ps->attach_WCET_info, ps->generate_node_freq, getNbICacheLevels (), getNbDCacheLevels (), cache_params, ps->nbthreads, ps->presolve, ps->inprocess, ps->compositional);
+    }
+  if (directive == "SWEEP")
+    {
+      ParamCacheSweep *ps = (ParamCacheSweep *) pa;
+      return new CacheSweep (p, ps->points, ps->analyses, ps->nbthreads, input_output_dir + "/" + ps->table_file);
+    }
+  if (directive == "BRANCHPRED")
+    {
+      ParamBranchPred *ps = (ParamBranchPred *) pa;
+      return new BranchPredAnalysis (p, ps->predictor, ps->btb_nbentries);
+    }
+  if (directive == "CRPD")
+    {
+      ParamCRPD *ps = (ParamCRPD *) pa;
+      return new CRPDAnalysis (p, ps->level, input_output_dir + "/" + ps->crpd_file);
+    }
+  if (directive == "SIMULATION")
+    {
+      ParamSimulation *ps = (ParamSimulation *) pa;
+      if (arch_name != "RISCV")
+	Logger::addFatal ("Config: SIMULATION not defined for " + arch_name + " architecture");
+      // the timing file may be given from the installation directory
+      string timing_file = ps->timing_file;
+      if (timing_file != "" && timing_file[0] != '/') timing_file = input_output_dir + "/" + timing_file;
+      return new SimulationAnalysis (p, input_output_dir + "/" + ps->binary_file, timing_file, ps->nbthreads, ps->sp,
+				     (ps->report_file == "") ? "" : input_output_dir + "/" + ps->report_file, ps->max_instructions);
     }
 
   // Already testesd before in getParameters() ?
@@ -419,6 +486,8 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
   ListXmlTag lt;
   bool b;
   string ep;
+  // Server mode: key of the resident program p is a copy of, "" when p was modified since
+  string resident_key;
 
   // Directory section
   // -----------------
@@ -435,6 +504,11 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
   float time = 0.0;
   timer_AllAnalysis.initTimer();
 
+  // Independent analyses run concurrently on the program when threads > 1
+  int nbthreads = lt[0].getAttributeInt ("threads");
+  if (nbthreads <= 0) nbthreads = 1;
+  AnalysisScheduler scheduler (this, nbthreads, printTime);
+
   // Just call the appropriate function to fill-in analysis dependent parameters from the xml
   // --------------------------------------------------------
   ListXmlTag ltanalysis = lt[0].getAllChildren ();
@@ -454,17 +528,50 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
       pa = getParameters(analysis_name, input_output_dir, ltanalysis[i]);
       assert (pa != NULL);
 
+      // The pending concurrent analyses have to be completed before a change of program,
+      // of entry point, an attribute overlay or a dump of the program.
+      // The configuration-independent steps applied to a resident program are run sequentially as well.
+      bool barrier = (pa->input_file != "") || (analysis_name == "ENTRYPOINT") || !pa->keep_results || (pa->output_file != "") || (resident_key != "");
+      if (barrier) scheduler.run ();
+
       // Call the analysis
       // -----------------
       // Decide on which program the analysis should be applied and check the program suitability for WCET before going on
       b = false;
+      bool restored = false;	// server mode: p restored from a resident program, the step is not applied
       if (pa->input_file != "")
 	{
 	  if (p != NULL) delete p;
-	  p = Program::unserialise_program_file (input_output_dir + "/" + pa->input_file);
-	  AnalysisHelper::ProgramCheck (p);
+	  p = NULL;
+	  string file = input_output_dir + "/" + pa->input_file;
+	  resident_key = "";
+	  if (server != NULL && analysis_name == "ENTRYPOINT")
+	    {
+	      // Copy of the resident program, checked and with the contexts of its entry point
+	      ep = ((ParamEntryPoint*) pa)->entrypoint;
+	      p = server->getProgram (file, ep, resident_key);
+	      restored = true;
+	    }
+	  else
+	    {
+	      p = Program::unserialise_program_file (file);
+	      AnalysisHelper::ProgramCheck (p);
+	    }
 	  b = true;
 	}
+      else if (resident_key != "")
+	{
+	  // Results of a configuration-independent step already applied to the resident program
+	  string step = AnalysisServer::getStepKey (analysis_name, pa);
+	  resident_key = (step == "") ? "" : resident_key + step;
+	  Program *r = (resident_key == "") ? NULL : server->getResult (resident_key);
+	  if (r != NULL)
+	    {
+	      delete p;
+	      p = r;
+	      restored = true;
+	    }
+	}
       if (analysis_name == "ENTRYPOINT")
 	{
 	  ep = ((ParamEntryPoint*) pa)->entrypoint ;
@@ -473,23 +580,31 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 	}
       if (b)
 	{
-	  AnalysisHelper::computeContext(p);
+	  if (!restored) AnalysisHelper::computeContext(p);
 	  initParameters();
 	  Logger::print( "\n*** Begin analysis for entry point: " + ep);
 	}
       
-      // Clone the program should the analysis results are not kept
-      Program *pgm = NULL;
-      if (! pa->keep_results) pgm = p->Clone (); else { pgm = p; entrypoint=ep;}
-      assert (pgm != NULL);
+      // Results not kept: the attributes set or removed by the step go to an overlay,
+      // discarded at the end of the step (the program is not copied)
+      Program *pgm = p;
+      if (! pa->keep_results) Attributed::BeginOverlay (); else entrypoint=ep;
 
-      if ( analysis_name != "ENTRYPOINT")
+      if ( analysis_name != "ENTRYPOINT" && !restored)
 	{
 
 	  // create the associated analysis object (a) for the current analysis.
 	  a = mkAnalyzerObject(analysis_name, p, pa);
 	  a->setName(analysis_name);
 	  assert (a != NULL);
+
+	  if (nbthreads > 1 && !barrier && AnalysisScheduler::isSchedulable (a))
+	    {
+	      scheduler.addAnalysis (a);
+	      delete pa;
+	      continue;
+	    }
+	  scheduler.run ();
 	  
 	  // Assumed: the first print order is the SIMPLEPRINT.
 	  if ( (analysis_name == "SIMPLEPRINT") && printTime) 
@@ -507,7 +622,8 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 	  bool res = a->CheckPerformCleanup (printTime);
 	  if (!res) Logger::addFatal ("Config: call to analysis failed");
 	  Logger::print ();
-	  if (Logger::getErrorState ()) exit (-1);
+	  if (Logger::getErrorState ()) Logger::addFatal ("Config: analysis " + analysis_name + " failed");
+	  if (resident_key != "") server->keepResult (resident_key, p);
 	  
 	  // For debug only
 	  if ((analysis_name == "IPET") && Logger::isDebugMode ())
@@ -538,15 +654,26 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
       if (ofile != "")
 	{
 	  string xml_file = input_output_dir + "/" + ofile;
-	  pgm->serialise_program (xml_file);
+	  try
+	    {
+	      if (pa->output_attributes.size () != 0)
+		pgm->serialise_program (xml_file, pa->output_attributes);
+	      else
+		pgm->serialise_program (xml_file);
+	    }
+	  catch (string const &msg)
+	    {
+	      Logger::addFatal (msg);
+	    }
 	}
       
-      if (!pa->keep_results) { delete pgm; }
+      if (!pa->keep_results) Attributed::DiscardOverlay ();
 
       // Cleaning for the next step.
       delete pa; pa = NULL;
       delete a; a = NULL;
     }
+  scheduler.run ();
 }
 
 // ---------------------------------------------------
@@ -653,24 +780,7 @@ CacheParam::CacheParam (XmlTag const &tag)
 	assert (this->level > 0 && this->level <= NB_MAX_CACHE_LEVEL);
 	this->latency = tag.getAttributeInt ("latency");
 	assert (this->latency >= 0);
-	string RP = tag.getAttributeString ("replacement_policy");
-	assert (RP == "LRU" || RP == "PLRU" || RP == "FIFO" || RP == "MRU" || RP == "RANDOM" || RP == "RR" || RP == "PSEUDO_RR" || RP == "UNKNOWN");
-	if (RP == "LRU")
-	  this->replacement_policy = LRU;
-	else if (RP == "PLRU")
-	  this->replacement_policy = PLRU;
-	else if (RP == "FIFO")
-	  this->replacement_policy = FIFO;
-	else if (RP == "MRU")
-	  this->replacement_policy = MRU;
-	else if (RP == "RANDOM")
-	  this->replacement_policy = RANDOM;
-	else if (RP == "RR")
-	  this->replacement_policy = RR;
-	else if (RP == "PSEUDO_RR")
-	  this->replacement_policy = PSEUDO_RR;
-	else if (RP == "UNKNOWN")
-	  this->replacement_policy = UNKNOWN;
+	this->replacement_policy = getReplacementPolicy (tag.getAttributeString ("replacement_policy"));
       }
     else // perfect data cache / perfect instruction cache
       {
@@ -682,6 +792,20 @@ CacheParam::CacheParam (XmlTag const &tag)
       }
 }
 
+t_replacement_policy
+CacheParam::getReplacementPolicy (string RP)
+{
+  if (RP == "LRU") return LRU;
+  if (RP == "PLRU") return PLRU;
+  if (RP == "FIFO") return FIFO;
+  if (RP == "MRU") return MRU;
+  if (RP == "RANDOM") return RANDOM;
+  if (RP == "RR") return RR;
+  if (RP == "PSEUDO_RR") return PSEUDO_RR;
+  if (RP != "UNKNOWN") Logger::addFatal ("Config: unknown replacement policy " + RP);
+  return UNKNOWN;
+}
+
 // ---------------------------------------------------
 //
 //  To obtained configuration of all the caches
@@ -708,6 +832,9 @@ ParamAnalysis::ParamAnalysis (XmlTag const &tag)
   keep_results = false;
   this->input_file = tag.getAttributeString ("input_file");
   this->output_file = tag.getAttributeString ("output_file");
+  this->output_attributes = Utl::split (tag.getAttributeString ("attributes"), ", ");
+  if (this->output_attributes.size () != 0 && this->output_file == "")
+    Logger::addWarning ("Config: attributes without output_file in " + tag.getName () + ", ignored");
   string keep_s = tag.getAttributeString ("keepresults");
   this->keep_results = (keep_s == ON);
 }
@@ -825,6 +952,14 @@ ParamDataAddress::ParamDataAddress (XmlTag const &tag):
   ParamAnalysis (tag)
 {
   this->sp = tag.getAttributeHexa("sp");
+  string s = tag.getAttributeString ("widening_delay");
+  this->widening_delay = -1;
+  if (s != "")
+    {
+      if (s.find_first_not_of ("0123456789") != string::npos)
+	Logger::addFatal ("Config: DATAADDRESS, widening_delay must be a non negative integer (" + s + ")");
+      this->widening_delay = Utl::string2int (s);
+    }
 }
 
 // Pipeline analysis
@@ -834,6 +969,52 @@ ParamPipeline::ParamPipeline (XmlTag const &tag):
 {
 }
 
+// Branch prediction analysis
+// --------------------------
+ParamBranchPred::ParamBranchPred (XmlTag const &tag):
+  ParamAnalysis (tag)
+{
+  string s = tag.getAttributeString ("predictor");
+  if (s == "static") this->predictor = BP_STATIC;
+  else if (s == "not-taken") this->predictor = BP_NOTTAKEN;
+  else if (s == "onebit") this->predictor = BP_ONEBIT;
+  else if (s == "twobit") this->predictor = BP_TWOBIT;
+  else Logger::addFatal ("Config: BRANCHPRED, unknown predictor " + s + " (static, not-taken, onebit or twobit)");
+
+  this->btb_nbentries = tag.getAttributeInt ("btb_nbentries");
+  if (this->btb_nbentries < 0) Logger::addFatal ("Config: BRANCHPRED, negative btb_nbentries");
+  if (this->btb_nbentries == 0 && (this->predictor == BP_ONEBIT || this->predictor == BP_TWOBIT))
+    Logger::addFatal ("Config: BRANCHPRED, the " + s + " predictor keeps its state in the BTB (btb_nbentries > 0)");
+}
+
+// Cache-related preemption delay
+// ------------------------------
+ParamCRPD::ParamCRPD (XmlTag const &tag):
+  ParamAnalysis (tag)
+{
+  this->level = tag.getAttributeInt ("level");
+  if (this->level <= 0) this->level = 1;
+  this->crpd_file = tag.getAttributeString ("crpd_file");
+  if (this->crpd_file == "") Logger::addFatal ("Config: CRPD, crpd_file not set");
+}
+
+// Simulation of the executable
+// ----------------------------
+ParamSimulation::ParamSimulation (XmlTag const &tag):
+  ParamAnalysis (tag)
+{
+  this->binary_file = tag.getAttributeString ("binaryfile");
+  if (this->binary_file == "") Logger::addFatal ("Config: SIMULATION, binaryfile not set");
+  this->timing_file = tag.getAttributeString ("timing_file");
+  this->nbthreads = tag.getAttributeInt ("threads");
+  if (this->nbthreads <= 0) this->nbthreads = 1;
+  this->sp = tag.getAttributeHexa ("sp");
+  if (this->sp == 0) this->sp = 0x7FFFE000;	// same default as DATAADDRESS in the templates
+  this->report_file = tag.getAttributeString ("report_file");
+  string s = tag.getAttributeString ("maxinstructions");
+  this->max_instructions = (s == "") ? 10000000000ULL : strtoull (s.c_str (), NULL, 10);
+}
+
 // WCET calculation
 // ----------------
 ParamIPET::ParamIPET (XmlTag const &tag):
@@ -859,8 +1040,123 @@ ParamIPET::ParamIPET (XmlTag const &tag):
   assert (s == ON || s == OFF);
   pipeline = ( s == ON );
 
+  // Number of threads generating the constraints of the Cfgs (optional, 1 by default)
+  this->nbthreads = tag.getAttributeInt ("threads");
+  if (this->nbthreads <= 0) this->nbthreads = 1;
+
+  // Reduction of the ILP system before it is solved (optional, off by default)
+  s = tag.getAttributeString ("presolve");
+  assert (s == ON || s == OFF || s == "");
+  this->presolve = (s == ON);
+
+  // In-process resolution of the ILP system, before the external solver (optional, off by default)
+  s = tag.getAttributeString ("inprocess");
+  assert (s == ON || s == OFF || s == "");
+  this->inprocess = (s == ON);
+
+  // WCET computed from per function and context summaries (optional, off by default)
+  s = tag.getAttributeString ("compositional");
+  assert (s == ON || s == OFF || s == "");
+  this->compositional = (s == ON);
+}
+
+
+// Cache design-space sweep
+// ------------------------
+// Every attribute of a CACHE child may hold a comma separated list
+// of values; the design points are the cartesian product of all the
+// lists of all the caches.
+static vector < string > getSweepValues (XmlTag const &tag, string name)
+{
+  vector < string > vs = Utl::split (tag.getAttributeString (name), ", ");
+  if (vs.size () == 0) Logger::addFatal ("Config: SWEEP, attribute " + name + " missing in CACHE");
+  return vs;
+}
+
+// All the caches described by a CACHE child of the SWEEP directive
+static vector < CacheParam * > getSweepCaches (XmlTag const &tag)
+{
+  vector < CacheParam * > res;
+  string stype = tag.getAttributeString ("type");
+  assert (stype == "icache" || stype == "dcache" || stype =="pdcache" || stype =="picache");
+  int level = tag.getAttributeInt ("level");
+  assert (level > 0 && level <= NB_MAX_CACHE_LEVEL);
+  vector < string > latencies = getSweepValues (tag, "latency");
+
+  if ((stype == "picache") || (stype == "pdcache"))
+    {
+      for (unsigned int l = 0; l < latencies.size (); l++)
+	{
+	  CacheParam *cp = new CacheParam ();
+	  cp->type = (stype == "picache") ? PERFECTICACHE : PERFECTDCACHE;
+	  cp->level = level;
+	  cp->latency = Utl::string2int (latencies[l]);
+	  res.push_back (cp);
+	}
+      return res;
+    }
+
+  vector < string > sets = getSweepValues (tag, "nbsets");
+  vector < string > ways = getSweepValues (tag, "nbways");
+  vector < string > lines = getSweepValues (tag, "cachelinesize");
+  vector < string > policies = getSweepValues (tag, "replacement_policy");
+  for (unsigned int s = 0; s < sets.size (); s++)
+    for (unsigned int w = 0; w < ways.size (); w++)
+      for (unsigned int c = 0; c < lines.size (); c++)
+	for (unsigned int l = 0; l < latencies.size (); l++)
+	  for (unsigned int r = 0; r < policies.size (); r++)
+	    {
+	      CacheParam *cp = new CacheParam ();
+	      cp->type = (stype == "icache") ? ICACHE : DCACHE;
+	      cp->level = level;
+	      cp->nbsets = Utl::string2int (sets[s]);
+	      cp->nbways = Utl::string2int (ways[w]);
+	      cp->cachelinesize = Utl::string2int (lines[c]);
+	      cp->latency = Utl::string2int (latencies[l]);
+	      cp->replacement_policy = CacheParam::getReplacementPolicy (policies[r]);
+	      assert (cp->nbsets != 0 && cp->nbways != 0 && cp->cachelinesize != 0 && cp->latency >= 0);
+	      res.push_back (cp);
+	    }
+  return res;
 }
 
+ParamCacheSweep::ParamCacheSweep (XmlTag const &tag):
+  ParamAnalysis (tag)
+{
+  this->nbthreads = tag.getAttributeInt ("threads");
+  if (this->nbthreads <= 0) this->nbthreads = 1;
+  this->table_file = tag.getAttributeString ("table_file");
+  if (this->table_file == "") Logger::addFatal ("Config: SWEEP, table_file not set");
+
+  // Design points: cartesian product of the caches of every CACHE child
+  points.push_back (vector < CacheParam * > ());
+  ListXmlTag children = tag.getAllChildren ();
+  for (unsigned int i = 0; i < children.size (); i++)
+    {
+      string name = children[i].getName ();
+      if (name == "comment") continue;
+      if (name != "CACHE")
+	{
+	  if (name != "ICACHE" && name != "DCACHE" && name != "PIPELINE" && name != "IPET")
+	    Logger::addFatal ("Config: SWEEP, unsupported analysis " + name + " (only ICACHE, DCACHE, PIPELINE and IPET)");
+	  analyses.push_back (children[i]);
+	  continue;
+	}
+      vector < CacheParam * > alternatives = getSweepCaches (children[i]);
+      vector < vector < CacheParam * > > product;
+      for (unsigned int p = 0; p < points.size (); p++)
+	for (unsigned int a = 0; a < alternatives.size (); a++)
+	  {
+	    vector < CacheParam * > point = points[p];
+	    point.push_back (alternatives[a]);
+	    product.push_back (point);
+	  }
+      points = product;
+    }
+  if (points[0].size () == 0) Logger::addFatal ("Config: SWEEP, no CACHE to sweep");
+  if (analyses.size () == 0 || analyses.back ().getName () != "IPET")
+    Logger::addFatal ("Config: SWEEP, the last swept analysis should be IPET");
+}
 
 // Entry point analysis
 ParamEntryPoint::ParamEntryPoint (XmlTag const &tag):
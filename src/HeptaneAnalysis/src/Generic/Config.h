@@ -72,6 +72,11 @@ typedef enum
 // Max number of cache levels in the hierarchy
 #define NB_MAX_CACHE_LEVEL 3
 
+// Branch predictors (static: backward taken / forward not taken, nottaken: always not taken,
+// onebit: last outcome, twobit: saturating counter)
+typedef enum
+{ BP_STATIC, BP_NOTTAKEN, BP_ONEBIT, BP_TWOBIT } t_branch_predictor;
+
 // Configuration of a single cache, whatever its position in the hierarchy
 // -----------------------------------------------------------------------
 class CacheParam
@@ -87,6 +92,9 @@ public:
   }
   CacheParam (XmlTag const &tag);
   ~CacheParam ();
+
+  /** @return the replacement policy named RP (LRU, PLRU, FIFO, ...), fatal error if unknown */
+  static t_replacement_policy getReplacementPolicy (string RP);
 };
 
 
@@ -105,6 +113,8 @@ class ParamAnalysis;
 class ConfigAnalysis;
 class WCETAnalysis;
 class ConfigICache;
+class CacheSweep;
+class AnalysisServer;
 class Config
 {
 
@@ -134,6 +144,9 @@ private:
   int MaxLevelCacheAnalysis; // the max level of the ICacheAnalysis, DCacheAnalysis (useful for cleaning the shared attributes)
   bool perfectIcache, perfectDcache;
 
+  /** Server mode: server keeping the programs resident between the requests (NULL otherwise) */
+  AnalysisServer *server;
+
 public:
 
   /// Analyzed program location
@@ -178,7 +191,15 @@ public:
   const map < int, vector < CacheParam * > >&GetCaches ();
 
   friend class ConfigICache;
+  friend class CacheSweep;
+  friend class AnalysisServer;
 private:
+  /** Add a cache to the hierarchy, checking its compatibility with the caches already there */
+  void addCache (CacheParam * cp);
+
+  /** Check the consistency of the whole cache hierarchy (same number of levels for instruction and data caches) */
+  void checkCacheHierarchy ();
+
   int  getPerfectIcacheLatency();
   int  getPerfectDcacheLatency();
 
@@ -198,7 +219,9 @@ private:
 };
 
 // Externals: pointer on configuration (global)
-extern Config *config;
+// The pointer is per thread: the workers of a cache sweep (CacheSweep) install
+// the configuration of the design point they analyse, the other threads keep the main one.
+extern thread_local Config *config;
 
 
 // -------------------------------------------------------
@@ -215,6 +238,7 @@ class ParamAnalysis
 public:
   string input_file;
   string output_file;
+  vector < string > output_attributes;	// attributes kept in output_file (empty: all)
   bool keep_results;
     ParamAnalysis ();
     ParamAnalysis (XmlTag const &tag);
@@ -282,6 +306,7 @@ class ParamDataAddress:public ParamAnalysis
 {
 public:
   int sp;
+  int widening_delay;		// visits of a loop head before widening, -1: no widening
   ParamDataAddress (XmlTag const &tag);
 };
 
@@ -293,6 +318,40 @@ public:
   ParamPipeline (XmlTag const &tag);
 };
 
+// Branch prediction analysis
+// --------------------------
+class ParamBranchPred:public ParamAnalysis
+{
+public:
+  t_branch_predictor predictor;
+  int btb_nbentries;
+  ParamBranchPred (XmlTag const &tag);
+};
+
+// Cache-related preemption delay
+// ------------------------------
+class ParamCRPD:public ParamAnalysis
+{
+public:
+  int level;
+  string crpd_file;
+  ParamCRPD (XmlTag const &tag);
+};
+
+// Simulation of the executable
+// ----------------------------
+class ParamSimulation:public ParamAnalysis
+{
+public:
+  string binary_file;
+  string timing_file;
+  int nbthreads;
+  int sp;
+  string report_file;
+  unsigned long long max_instructions;
+  ParamSimulation (XmlTag const &tag);
+};
+
 // WCET calculation
 // ----------------
 class ParamIPET:public ParamAnalysis
@@ -303,6 +362,10 @@ public:
   bool generate_node_freq;
   ParamIPET (XmlTag const &tag);
   bool pipeline;
+  int nbthreads;
+  bool presolve;
+  bool inprocess;
+  bool compositional;
 };
 
 // Entry point analysis
@@ -322,6 +385,20 @@ public:
   ParamCacheStatistics (XmlTag const &tag);
 };
 
+// Cache design-space sweep
+// --------------------------------------
+class ParamCacheSweep:public ParamAnalysis
+{
+public:
+  int nbthreads;
+  string table_file;
+  /** Cache hierarchies to be analysed (one vector of caches per design point) */
+  vector < vector < CacheParam * > > points;
+  /** Analyses (ICACHE, DCACHE, PIPELINE, IPET) applied to every design point */
+  ListXmlTag analyses;
+  ParamCacheSweep (XmlTag const &tag);
+};
+
 // DummyAnalysis
 // --------------------------------------
 class ParamDummyAnalysis:public ParamAnalysis
@@ -215,6 +215,18 @@ public:
     return rhs.p_ == p_ || *p_ == *(rhs.p_);
   };
 
+  /** Shared instance (read-only) */
+  inline const T *get () const
+  {
+    return p_.get ();
+  };
+
+  /** @return true if the instance is not shared with another cow_ptr */
+  inline bool unique () const
+  {
+    return p_.unique ();
+  };
+
 private:
   heptane_shared_ptr < T > p_;
 
@@ -185,9 +185,26 @@
 /** Branch prediction attribute
  * ---------------------
  *
+ * Bounds per loop entry on the BTB misses, right and wrong predictions
+ * of the loop control branches, attached to loops by BranchPredAnalysis
+ * for every execution context (name: BaseAttrName + "#" + contextName).
+ *
+ * Attribute type: SerialisableIntegerAttribute
  */
 #define BRPRED_LOOP_NBMISSBTB "Loop_NB_MissBTB"
 #define BRPRED_LOOP_NBGOODPRED "Loop_Nb_GoodPrediction"
 #define BRPRED_LOOP_NBWRONGPRED "Loop_Nb_WrongPrediction"
 
+/** Observed execution attributes
+ * ---------------------
+ *
+ * Number of executions of a node and cycles spent in it during the
+ * simulation of the program (all contexts), attached to nodes by
+ * SimulationAnalysis.
+ *
+ * Attribute type: SerialisableUnsignedLongAttribute
+ */
+#define ObservedFrequencyAttributeName "ObservedFrequency"
+#define ObservedCyclesAttributeName "ObservedCycles"
+
 #endif // SHARED_ATTRIBUTES_H
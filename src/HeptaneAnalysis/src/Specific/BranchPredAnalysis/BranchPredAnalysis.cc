@@ -0,0 +1,210 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <sstream>
+#include "Specific/BranchPredAnalysis/BranchPredAnalysis.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "arch.h"
+
+// ----------------------
+// BranchPredAnalysis class
+// ----------------------
+
+BranchPredAnalysis::BranchPredAnalysis(Program * p, t_branch_predictor vpredictor, int vbtb_nbentries):Analysis(p)
+{
+  predictor = vpredictor;
+  btb_nbentries = vbtb_nbentries;
+}
+
+// ----------------------------------------------------------------
+// Checks if all required attributes are in the CFG
+// (loop bounds, execution contexts)
+// ----------------------------------------------------------------
+bool BranchPredAnalysis::CheckInputAttributes()
+{
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      if (lcfg[c]->IsExternal() || lcfg[c]->IsEmpty())
+	continue;
+      if (!lcfg[c]->HasAttribute(ContextListAttributeName))
+	{
+	  Logger::addError("BranchPredAnalysis: no context attached to " + lcfg[c]->getStringName());
+	  return false;
+	}
+      vector < Loop * >vl = lcfg[c]->GetAllLoops();
+      for (unsigned int l = 0; l < vl.size(); l++)
+	if (!vl[l]->HasAttribute(MaxiterAttributeName))
+	  {
+	    Logger::addError("BranchPredAnalysis: loop without maxiter in " + lcfg[c]->getStringName());
+	    return false;
+	  }
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Branches of a set of nodes and of their callees
+// (addresses of the branch instructions, each function is
+// scanned once)
+// ----------------------------------------------------------------
+bool BranchPredAnalysis::collectBranches(vector < Node * >vn, set < t_address > &branches, set < Cfg * >&callees)
+{
+  bool known = true;
+  for (unsigned int i = 0; i < vn.size(); i++)
+    {
+      Node *n = vn[i];
+      if (n->isIsolatedNopNode())
+	continue;
+      Instruction *branch = AnalysisHelper::getBranchInstruction(n);
+      if (branch != NULL)
+	{
+	  AddressAttribute attr = (AddressAttribute &) branch->GetAttribute(AddressAttributeName);
+	  branches.insert(attr.getCodeAddress());
+	}
+      if (n->IsCall())
+	{
+	  Cfg *callee = n->GetCallee();
+	  if (callee->IsExternal() || callee->HasAttribute(ExternalWCETAttributeName))
+	    known = false;
+	  else if (callees.insert(callee).second)
+	    known = collectBranches(callee->GetAllNodes(), branches, callees) && known;
+	}
+    }
+  return known;
+}
+
+// ----------------------------------------------------------------
+// Successor reached when the branch ending n is taken.
+// The fall-through successor is the first one after the
+// branch in the address space, the other one is the target.
+// ----------------------------------------------------------------
+Node *BranchPredAnalysis::getTakenSuccessor(Cfg * c, Node * n)
+{
+  vector < Instruction * >vi = n->GetAsm();
+  AddressAttribute attr = (AddressAttribute &) vi.back()->GetAttribute(AddressAttributeName);
+  t_address last = attr.getCodeAddress();
+
+  vector < Node * >succs = c->GetSuccessors(n);
+  Node *fallthrough = NULL;
+  for (unsigned int s = 0; s < succs.size(); s++)
+    {
+      t_address a = AnalysisHelper::getStartAddress(succs[s]);
+      if (a > last && (fallthrough == NULL || a < AnalysisHelper::getStartAddress(fallthrough)))
+	fallthrough = succs[s];
+    }
+  for (unsigned int s = 0; s < succs.size(); s++)
+    if (succs[s] != fallthrough)
+      return succs[s];
+  return NULL;
+}
+
+// ----------------------------------------------------------------
+// Bounds of a loop, per loop entry.
+//
+// A loop control branch has one successor in the loop and one out
+// of it (see AnalysisHelper::getLoopControlBranches), the staying
+// direction is given by the loop structure. It is executed at most
+// maxiter+1 times per loop entry (the head is executed once more
+// than the body): all its executions but one stay in the loop, the
+// last one (if any) leaves it.
+//  - static predictor: one wrong prediction (exit) if the predicted
+//    direction (taken for a backward target) is the one staying in
+//    the loop, all of them otherwise.
+//  - onebit/twobit predictors: at most 2 (resp. 3) wrong predictions
+//    if the branch is persistent in the BTB (unknown initial state,
+//    then exit), all of them otherwise.
+// The taken direction misses in the BTB once per entry if the branch
+// is persistent or only taken on exit, every time otherwise.
+// The bounds do not depend on the context, they are attached for
+// every context of the function as the other contextual attributes.
+// ----------------------------------------------------------------
+void BranchPredAnalysis::analyseLoop(Cfg * c, Loop * l)
+{
+  SerialisableIntegerAttribute bound = (SerialisableIntegerAttribute &) l->GetAttribute(MaxiterAttributeName);
+  long nbexec = bound.GetValue() + 1;
+
+  set < t_address > branches;
+  set < Cfg * >callees;
+  bool persistent = collectBranches(l->GetAllNodes(), branches, callees) && (int) branches.size() <= btb_nbentries;
+
+  long nbwrong = 0, nbgood = 0, nbmissbtb = 0;
+  vector < Node * >vb = AnalysisHelper::getLoopControlBranches(c, l);
+  for (unsigned int b = 0; b < vb.size(); b++)
+    {
+      Node *stay = AnalysisHelper::getLoopStaySuccessor(c, l, vb[b]);
+      Node *taken = getTakenSuccessor(c, vb[b]);
+      bool stay_taken = (taken == stay);
+      long wrong;
+      if (predictor == BP_STATIC || predictor == BP_NOTTAKEN)
+	{
+	  bool predicted_taken = (predictor == BP_STATIC && taken != NULL
+				  && AnalysisHelper::getStartAddress(taken) <= AnalysisHelper::getStartAddress(vb[b]));
+	  wrong = (predicted_taken == stay_taken) ? 1 : nbexec;
+	}
+      else if (persistent)
+	wrong = (predictor == BP_ONEBIT) ? 2 : 3;
+      else
+	wrong = nbexec;
+      wrong = min(wrong, nbexec);
+      nbwrong += wrong;
+      nbgood += nbexec - wrong;
+      if (btb_nbentries != 0)
+	nbmissbtb += (persistent || !stay_taken) ? 1 : nbexec;
+    }
+
+  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
+  for (unsigned int ic = 0; ic < contexts.size(); ic++)
+    {
+      string contextName = contexts[ic]->getStringId();
+      SerialisableIntegerAttribute attr_wrong(nbwrong), attr_good(nbgood), attr_missbtb(nbmissbtb);
+      l->SetAttribute(AnalysisHelper::mkContextAttrName(BRPRED_LOOP_NBWRONGPRED, contextName), attr_wrong);
+      l->SetAttribute(AnalysisHelper::mkContextAttrName(BRPRED_LOOP_NBGOODPRED, contextName), attr_good);
+      l->SetAttribute(AnalysisHelper::mkContextAttrName(BRPRED_LOOP_NBMISSBTB, contextName), attr_missbtb);
+    }
+}
+
+// ----------------------------------------------
+// Performs the analysis
+// Returns true if successful, false otherwise
+// ----------------------------------------------
+bool BranchPredAnalysis::PerformAnalysis()
+{
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      if (lcfg[c]->IsExternal() || lcfg[c]->IsEmpty())
+	continue;
+      vector < Loop * >vl = lcfg[c]->GetAllLoops();
+      for (unsigned int l = 0; l < vl.size(); l++)
+	analyseLoop(lcfg[c], vl[l]);
+    }
+  return true;
+}
+
+/* Remove all private attributes */
+void BranchPredAnalysis::RemovePrivateAttributes()
+{
+}
@@ -0,0 +1,92 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef BRANCH_PRED_ANALYSIS_H
+#define BRANCH_PRED_ANALYSIS_H
+
+#include <set>
+#include "Analysis.h"
+#include "Generic/Config.h"
+
+/**
+ * Static branch predictor analysis (BRANCHPRED directive).
+ *
+ * Bounds, for every loop and execution context, the number of
+ * wrong predictions, right predictions and BTB misses of the loop
+ * control branches (conditional branches with one successor in the
+ * loop and one out of it) per entry in the loop. The bounds are
+ * attached to the loop (attributes BRPRED_LOOP_NBWRONGPRED,
+ * BRPRED_LOOP_NBGOODPRED and BRPRED_LOOP_NBMISSBTB, see
+ * SharedAttributes.h), and used by IPETAnalysis to add the branch
+ * prediction costs of the architecture (_BRANCHPRED_WRONGPRED_ and
+ * _BRANCHPRED_MISSBTB_ entries of the latency data file).
+ *
+ * Predictors:
+ *  - static: backward taken, forward not taken
+ *  - not-taken: always not taken (FlexPRET)
+ *  - onebit: last outcome, the state being kept in the BTB entry
+ *  - twobit: saturating counter, the state being kept in the BTB entry
+ *
+ * The BTB is a fully associative LRU table of btb_nbentries branches
+ * (0 for no BTB, static and not-taken predictors only). A loop control branch is
+ * persistent in the BTB when the loop, its nested loops and its callees
+ * contain at most btb_nbentries distinct branches: it then misses in the
+ * BTB once per loop entry.
+ *
+ * Used in:
+ *  - GNUmakefile
+ *  - Generic/Config.h
+ *  - Generic/Config.cc
+ */
+class BranchPredAnalysis:public Analysis
+{
+ private:
+  t_branch_predictor predictor;
+  int btb_nbentries;
+
+  /** Adds to branches the addresses of the branches of nodes vn and of their callees (visited
+      functions are in callees), @return false if some callee is unknown (external function) */
+  bool collectBranches (vector < Node * >vn, set < t_address > &branches, set < Cfg * >&callees);
+
+  /** @return the successor of n reached when its branch is taken (NULL if none) */
+  Node *getTakenSuccessor (Cfg * c, Node * n);
+
+  /** Bounds for loop l of Cfg c (per loop entry) */
+  void analyseLoop (Cfg * c, Loop * l);
+
+ public:
+
+  /** Constructor */
+  BranchPredAnalysis (Program * p, t_branch_predictor vpredictor, int vbtb_nbentries);
+
+  /** Checks if all required attributes are in the CFG (loop bounds, contexts) */
+  bool CheckInputAttributes ();
+
+  /** Performs the analysis */
+  bool PerformAnalysis ();
+
+  /** Remove all private attributes */
+  void RemovePrivateAttributes ();
+
+};
+
+#endif
@@ -0,0 +1,461 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "Specific/CRPDAnalysis/CRPDAnalysis.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "CallGraph.h"
+#include "arch.h"
+
+// ----------------------
+// CRPDAnalysis class
+// ----------------------
+
+CRPDAnalysis::CRPDAnalysis(Program * p, int vlevel, string vcrpd_file):Analysis(p)
+{
+  level = vlevel;
+  crpd_file = vcrpd_file;
+}
+
+// -------------------------------------------------
+// @return the CHMC of an instruction in a context,
+// "" if the cache was not analysed
+// -------------------------------------------------
+string CRPDAnalysis::getCHMC(Instruction * vinstr, Context * ctx, CacheParam * cp)
+{
+  string name;
+  if (cp->type == ICACHE)
+    name = CHMCAttributeNameCode(cp->level);
+  else
+    {
+      if (!AnalysisHelper::isLoad(vinstr)) return "";
+      name = CHMCAttributeNameData(cp->level);
+    }
+  name = AnalysisHelper::mkContextAttrName(name, ctx);
+  if (!vinstr->HasAttribute(name)) return "";
+  return ((SerialisableStringAttribute &) vinstr->GetAttribute(name)).GetValue();
+}
+
+// -------------------------------------------------
+// Cache lines accessed by an instruction in a context
+// (the instruction itself for an icache, the loaded
+// data for a dcache)
+// -------------------------------------------------
+set < t_address > CRPDAnalysis::getAccessedBlocks(Instruction * vinstr, Context * ctx, CacheParam * cp)
+{
+  set < t_address > blocks;
+  unsigned int linesize = cp->cachelinesize;
+
+  if (cp->type == ICACHE)
+    {
+      t_address addr = ((AddressAttribute &) vinstr->GetAttribute(AddressAttributeName)).getCodeAddress();
+      blocks.insert(addr - (addr % linesize));
+      return blocks;
+    }
+
+  if (!AnalysisHelper::isLoad(vinstr)) return blocks;
+  string attributeName = AnalysisHelper::mkContextAttrName(AddressAttributeName, ctx);
+  if (!vinstr->HasAttribute(attributeName)) attributeName = AddressAttributeName;	// only the stack accesses are contextual
+  if (!vinstr->HasAttribute(attributeName)) return blocks;
+
+  vector < AddressInfo > a = ((AddressAttribute &) vinstr->GetAttribute(attributeName)).getListInfo();
+  for (size_t i = 0; i < a.size(); i++)
+    {
+      if (a[i].getSegment() == "code") continue;
+      const vector < pair < string, string > >&ranges = a[i].getAdrSize();
+      for (size_t r = 0; r < ranges.size(); r++)
+	{
+	  t_address from = atol(ranges[r].first.c_str());
+	  unsigned int range = atoi(ranges[r].second.c_str());
+	  t_address to = from + range - 1;
+	  for (t_address k = from - (from % linesize); k <= to - (to % linesize); k += linesize)
+	    blocks.insert(k);
+	}
+    }
+  return blocks;
+}
+
+// -------------------------------------------------
+// Backward transfer function of an instruction:
+// a hit (AH, FM) makes its lines useful before the
+// access, a miss (AM, NC) on a single line reloads
+// it anyway, it is no longer useful before.
+// -------------------------------------------------
+void CRPDAnalysis::transferUCB(Instruction * vinstr, Context * ctx, CacheParam * cp, set < t_address > &live)
+{
+  string chmc = getCHMC(vinstr, ctx, cp);
+  if (chmc == "" || chmc == "AU") return;
+
+  set < t_address > blocks = getAccessedBlocks(vinstr, ctx, cp);
+  if (chmc == "AH" || chmc == "FM")
+    live.insert(blocks.begin(), blocks.end());
+  else if (blocks.size() == 1)
+    live.erase(*(blocks.begin()));
+}
+
+static bool largerSet(const set < t_address > &a, const set < t_address > &b)
+{
+  return a.size() > b.size();
+}
+
+// -------------------------------------------------
+// ECB and maximal UCB sets of the entry point
+// -------------------------------------------------
+CRPDAnalysis::t_crpd_cache CRPDAnalysis::analyseCache(CacheParam * cp, const vector < ContextualNode > &nodes)
+{
+  t_crpd_cache res;
+  res.type = (cp->type == ICACHE) ? "icache" : "dcache";
+  res.nbsets = cp->nbsets;
+  res.nbways = cp->nbways;
+  res.cachelinesize = cp->cachelinesize;
+  res.reloadtime = getReloadTime(cp);
+
+  // ECB: all the lines accessed at this level
+  for (size_t n = 0; n < nodes.size(); n++)
+    {
+      vector < Instruction * >vi = nodes[n].node->GetAsm();
+      for (size_t i = 0; i < vi.size(); i++)
+	{
+	  string chmc = getCHMC(vi[i], nodes[n].context, cp);
+	  if (chmc == "" || chmc == "AU") continue;
+	  set < t_address > blocks = getAccessedBlocks(vi[i], nodes[n].context, cp);
+	  res.ecb.insert(blocks.begin(), blocks.end());
+	}
+    }
+
+  // UCB: backward fixed point on the contextual nodes (UCB at the node entries)
+  map < ContextualNode, set < t_address > > ucb_in;
+  set < ContextualNode > work(nodes.begin(), nodes.end());
+  while (!work.empty())
+    {
+      ContextualNode current = *(work.begin());
+      work.erase(work.begin());
+
+      set < t_address > live;
+      vector < ContextualNode > succ = GetContextualSuccessors(current);
+      for (size_t s = 0; s < succ.size(); s++)
+	{
+	  map < ContextualNode, set < t_address > >::const_iterator it = ucb_in.find(succ[s]);
+	  if (it != ucb_in.end()) live.insert(it->second.begin(), it->second.end());
+	}
+      vector < Instruction * >vi = current.node->GetAsm();
+      for (size_t i = vi.size(); i > 0; i--)
+	transferUCB(vi[i - 1], current.context, cp, live);
+
+      map < ContextualNode, set < t_address > >::iterator it = ucb_in.find(current);
+      if (it == ucb_in.end() || it->second != live)
+	{
+	  ucb_in[current] = live;
+	  vector < ContextualNode > pred = GetContextualPredecessors(current);
+	  work.insert(pred.begin(), pred.end());
+	}
+    }
+
+  // UCB sets at every program point (before every instruction)
+  set < set < t_address > > points;
+  for (size_t n = 0; n < nodes.size(); n++)
+    {
+      set < t_address > live;
+      vector < ContextualNode > succ = GetContextualSuccessors(nodes[n]);
+      for (size_t s = 0; s < succ.size(); s++)
+	live.insert(ucb_in[succ[s]].begin(), ucb_in[succ[s]].end());
+      points.insert(live);
+      vector < Instruction * >vi = nodes[n].node->GetAsm();
+      for (size_t i = vi.size(); i > 0; i--)
+	{
+	  transferUCB(vi[i - 1], nodes[n].context, cp, live);
+	  points.insert(live);
+	}
+    }
+
+  // Only the maximal sets bound the preemption costs
+  vector < set < t_address > > sorted(points.begin(), points.end());
+  sort(sorted.begin(), sorted.end(), largerSet);
+  for (size_t i = 0; i < sorted.size(); i++)
+    {
+      bool included = false;
+      for (size_t k = 0; k < res.ucb.size() && !included; k++)
+	included = includes(res.ucb[k].begin(), res.ucb[k].end(), sorted[i].begin(), sorted[i].end());
+      if (!included) res.ucb.push_back(sorted[i]);
+    }
+  return res;
+}
+
+// -------------------------------------------------
+// Reload time of a line: latencies of the next
+// levels of the hierarchy and of the memory
+// -------------------------------------------------
+int CRPDAnalysis::getReloadTime(CacheParam * cp)
+{
+  int reload = config->getMemoryLoadLatency();
+  const map < int, vector < CacheParam * > >&hierarchy = config->GetCaches();
+  for (map < int, vector < CacheParam * > >::const_iterator it = hierarchy.begin(); it != hierarchy.end(); it++)
+    {
+      if (it->first <= cp->level) continue;
+      for (size_t c = 0; c < it->second.size(); c++)
+	if (it->second[c]->type == cp->type) reload += it->second[c]->latency;
+    }
+  return reload;
+}
+
+// -------------------------------------------------
+// Reload cost of a single preemption
+// -------------------------------------------------
+long CRPDAnalysis::preemptionCost(const t_crpd_task & preempted, const t_crpd_task & preempting)
+{
+  long cost = 0;
+  for (size_t c = 0; c < preempted.caches.size(); c++)
+    {
+      const t_crpd_cache & cache = preempted.caches[c];
+      for (size_t e = 0; e < preempting.caches.size(); e++)
+	{
+	  const t_crpd_cache & evicting = preempting.caches[e];
+	  if (evicting.type != cache.type) continue;
+	  if (evicting.nbsets != cache.nbsets || evicting.nbways != cache.nbways || evicting.cachelinesize != cache.cachelinesize)
+	    Logger::addFatal("CRPDAnalysis: tasks " + preempted.name + " and " + preempting.name + " have different " + cache.type + " geometries");
+
+	  // Cache sets containing an evicting line
+	  set < unsigned int > ecb_sets;
+	  for (set < t_address >::const_iterator it = evicting.ecb.begin(); it != evicting.ecb.end(); it++)
+	    ecb_sets.insert((*it / cache.cachelinesize) % cache.nbsets);
+
+	  long worst = 0;
+	  for (size_t u = 0; u < cache.ucb.size(); u++)
+	    {
+	      map < unsigned int, unsigned int > ucb_per_set;
+	      for (set < t_address >::const_iterator it = cache.ucb[u].begin(); it != cache.ucb[u].end(); it++)
+		ucb_per_set[(*it / cache.cachelinesize) % cache.nbsets]++;
+
+	      long evicted = 0;
+	      for (map < unsigned int, unsigned int >::const_iterator it = ucb_per_set.begin(); it != ucb_per_set.end(); it++)
+		{
+		  // One evicting line may cause a chain of reloads of the useful lines of its set
+		  if (ecb_sets.find(it->first) == ecb_sets.end()) continue;
+		  evicted += min(it->second, (unsigned int) cache.nbways);
+		}
+	      worst = max(worst, evicted);
+	    }
+	  cost += worst * cache.reloadtime;
+	}
+    }
+  return cost;
+}
+
+// -------------------------------------------------
+// Reading/writing the CRPD file
+// -------------------------------------------------
+static string addressList(const set < t_address > &s)
+{
+  ostringstream os;
+  for (set < t_address >::const_iterator it = s.begin(); it != s.end(); it++)
+    {
+      if (it != s.begin()) os << " ";
+      os << "0x" << hex << *it << dec;
+    }
+  return os.str();
+}
+
+static set < t_address > parseAddressList(string str)
+{
+  set < t_address > s;
+  istringstream is(str);
+  string word;
+  while (is >> word)
+    s.insert(strtoul(word.c_str(), NULL, 16));
+  return s;
+}
+
+vector < CRPDAnalysis::t_crpd_task > CRPDAnalysis::readTasks(string skip)
+{
+  vector < t_crpd_task > tasks;
+  ifstream exists(crpd_file.c_str());
+  if (!exists.good()) return tasks;
+  exists.close();
+
+  XmlDocument doc(crpd_file);
+  XmlTag root = doc.getRootTag();
+  if (root.getAttributeInt("level") != level)
+    Logger::addFatal("CRPDAnalysis: " + crpd_file + " holds the results of another cache level");
+
+  ListXmlTag ltasks = root.searchChildren("TASK");
+  for (size_t t = 0; t < ltasks.size(); t++)
+    {
+      t_crpd_task task;
+      task.name = ltasks[t].getAttributeString("name");
+      if (task.name == skip) continue;
+      ListXmlTag lcaches = ltasks[t].searchChildren("CACHE");
+      for (size_t c = 0; c < lcaches.size(); c++)
+	{
+	  t_crpd_cache cache;
+	  cache.type = lcaches[c].getAttributeString("type");
+	  cache.nbsets = lcaches[c].getAttributeInt("nbsets");
+	  cache.nbways = lcaches[c].getAttributeInt("nbways");
+	  cache.cachelinesize = lcaches[c].getAttributeInt("cachelinesize");
+	  cache.reloadtime = lcaches[c].getAttributeInt("reloadtime");
+	  ListXmlTag lecb = lcaches[c].searchChildren("ECB");
+	  if (lecb.size() == 1) cache.ecb = parseAddressList(lecb[0].getContent());
+	  ListXmlTag lucb = lcaches[c].searchChildren("UCB");
+	  for (size_t u = 0; u < lucb.size(); u++)
+	    cache.ucb.push_back(parseAddressList(lucb[u].getContent()));
+	  task.caches.push_back(cache);
+	}
+      tasks.push_back(task);
+    }
+  return tasks;
+}
+
+void CRPDAnalysis::writeTasks(const vector < t_crpd_task > &tasks)
+{
+  ofstream os(crpd_file.c_str());
+  if (!os.is_open())
+    {
+      Logger::addError("CRPDAnalysis: cannot open " + crpd_file);
+      return;
+    }
+
+  os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << endl;
+  os << "<CRPD level=\"" << level << "\">" << endl;
+  for (size_t t = 0; t < tasks.size(); t++)
+    {
+      os << "  <TASK name=\"" << tasks[t].name << "\">" << endl;
+      for (size_t c = 0; c < tasks[t].caches.size(); c++)
+	{
+	  const t_crpd_cache & cache = tasks[t].caches[c];
+	  os << "    <CACHE type=\"" << cache.type << "\" nbsets=\"" << cache.nbsets << "\" nbways=\"" << cache.nbways
+	     << "\" cachelinesize=\"" << cache.cachelinesize
+	     << "\" reloadtime=\"" << cache.reloadtime << "\">" << endl;
+	  os << "      <ECB>" << addressList(cache.ecb) << "</ECB>" << endl;
+	  for (size_t u = 0; u < cache.ucb.size(); u++)
+	    os << "      <UCB>" << addressList(cache.ucb[u]) << "</UCB>" << endl;
+	  os << "    </CACHE>" << endl;
+	}
+      os << "  </TASK>" << endl;
+    }
+  for (size_t i = 0; i < tasks.size(); i++)
+    for (size_t j = 0; j < tasks.size(); j++)
+      {
+	if (i == j) continue;
+	os << "  <PREEMPTION preempted=\"" << tasks[i].name << "\" preempting=\"" << tasks[j].name
+	   << "\" cost=\"" << preemptionCost(tasks[i], tasks[j]) << "\"/>" << endl;
+      }
+  os << "</CRPD>" << endl;
+}
+
+// ----------------------------------------------------------------
+// Checks if all required attributes are in the CFG
+// (contexts, CHMC of at least one cache of the level)
+// ----------------------------------------------------------------
+bool CRPDAnalysis::CheckInputAttributes()
+{
+  Cfg *entry = p->GetEntryPoint();
+  if (!entry->HasAttribute(ContextListAttributeName))
+    {
+      Logger::addError("CRPDAnalysis: no context attached to " + entry->getStringName());
+      return false;
+    }
+
+  const map < int, vector < CacheParam * > >&hierarchy = config->GetCaches();
+  map < int, vector < CacheParam * > >::const_iterator it = hierarchy.find(level);
+  if (it == hierarchy.end())
+    {
+      Logger::addError("CRPDAnalysis: no cache at level " + to_string(level));
+      return false;
+    }
+
+  // A cache is kept if one of its accesses is classified
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (size_t c = 0; c < it->second.size(); c++)
+    {
+      CacheParam *cp = it->second[c];
+      if (cp->type != ICACHE && cp->type != DCACHE) continue;
+      bool classified = false;
+      for (size_t f = 0; f < lcfg.size() && !classified; f++)
+	{
+	  if (!lcfg[f]->HasAttribute(ContextListAttributeName)) continue;
+	  const ContextList & contexts = (ContextList &) lcfg[f]->GetAttribute(ContextListAttributeName);
+	  if (contexts.size() == 0) continue;
+	  Context *ctx = contexts[0];
+	  vector < Node * >vn = lcfg[f]->GetAllNodes();
+	  for (size_t n = 0; n < vn.size() && !classified; n++)
+	    {
+	      vector < Instruction * >vi = vn[n]->GetAsm();
+	      for (size_t i = 0; i < vi.size() && !classified; i++)
+		classified = (getCHMC(vi[i], ctx, cp) != "");
+	    }
+	}
+      if (classified) caches.push_back(cp);
+      else Logger::addInfo("CRPDAnalysis: the " + string(cp->type == ICACHE ? "ICACHE" : "DCACHE") + " analysis of level " + to_string(level) + " was not applied, cache ignored");
+    }
+  if (caches.size() == 0)
+    {
+      Logger::addError("CRPDAnalysis: the ICACHE or DCACHE analysis of level " + to_string(level) + " should be applied first");
+      return false;
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Performs the analysis
+// ----------------------------------------------------------------
+bool CRPDAnalysis::PerformAnalysis()
+{
+  // Contextual nodes of the entry point and its callees
+  CallGraph call_graph(p);
+  vector < ContextualNode > nodes;
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (size_t f = 0; f < lcfg.size(); f++)
+    {
+      if (call_graph.isDeadCode(lcfg[f]) || !lcfg[f]->HasAttribute(ContextListAttributeName)) continue;
+      const ContextList & contexts = (ContextList &) lcfg[f]->GetAttribute(ContextListAttributeName);
+      vector < Node * >vn = lcfg[f]->GetAllNodes();
+      for (size_t c = 0; c < contexts.size(); c++)
+	for (size_t n = 0; n < vn.size(); n++)
+	  nodes.push_back(ContextualNode(contexts[c], vn[n]));
+    }
+
+  t_crpd_task task;
+  task.name = p->GetEntryPoint()->getStringName();
+  for (size_t c = 0; c < caches.size(); c++)
+    {
+      task.caches.push_back(analyseCache(caches[c], nodes));
+      const t_crpd_cache & res = task.caches.back();
+      size_t maxucb = 0;
+      for (size_t u = 0; u < res.ucb.size(); u++) maxucb = max(maxucb, res.ucb[u].size());
+      stringstream infostr;
+      infostr << "CRPDAnalysis: " << task.name << ", " << res.type << " L" << level << ": " << res.ecb.size() << " ECBs, at most " << maxucb << " UCBs";
+      Logger::addInfo(infostr.str());
+    }
+
+  vector < t_crpd_task > tasks = readTasks(task.name);
+  tasks.push_back(task);
+  writeTasks(tasks);
+  return true;
+}
+
+// Remove all private attributes
+void CRPDAnalysis::RemovePrivateAttributes()
+{
+}
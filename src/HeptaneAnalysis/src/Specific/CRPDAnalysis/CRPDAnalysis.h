@@ -0,0 +1,131 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef CRPD_ANALYSIS_H
+#define CRPD_ANALYSIS_H
+
+#include <set>
+#include <map>
+#include "Analysis.h"
+#include "Generic/Config.h"
+#include "Generic/ContextHelper.h"
+
+/**
+ * Cache-related preemption delay analysis (CRPD directive).
+ *
+ * Computes, for the caches of a level, the evicting cache blocks (ECB)
+ * of the analysed entry point, i.e. the cache lines accessed by its code
+ * (ICACHE) and by its loads (DCACHE), and its useful cache blocks (UCB)
+ * at every program point. A cache line is useful at a program point if,
+ * on some path, its next access is classified always-hit or first-miss by
+ * the cache analysis (i.e. the hit relies on the MUST or PS abstract cache
+ * states): a preemption evicting it costs one reload.
+ *
+ * Each entry point is analysed by its own configuration. The results of
+ * every task are kept in the same XML file (crpd_file): the task entry is
+ * replaced on each run, and the bounds on the preemption costs of every
+ * pair of tasks (preempted, preempting) are recomputed:
+ *    cost = sum over caches of reloadtime * max over program points of the
+ *           sum over the cache sets containing an ECB of the preempting
+ *           task of min(number of UCBs of the preempted task, nbways).
+ * The number of ECBs of a set is not a bound: in a set-associative set,
+ * one evicting line may cause a chain of reloads of the useful lines
+ * (e.g. by shifting their LRU ages), whatever the replacement policy.
+ * The reload time of a line is the latency of the next levels of the
+ * hierarchy plus the memory load latency.
+ *
+ * Input: CHMC attributes of the ICACHE/DCACHE analyses of the level, and
+ * data addresses (DATAADDRESS) for the data cache.
+ *
+ * Used in:
+ *  - GNUmakefile
+ *  - Generic/Config.h
+ *  - Generic/Config.cc
+ */
+class CRPDAnalysis:public Analysis
+{
+ public:
+  /** UCB/ECB of a task for one cache */
+  typedef struct
+  {
+    string type;		// icache or dcache
+    int nbsets, nbways, cachelinesize;
+    int reloadtime;
+    set < t_address > ecb;
+    vector < set < t_address > > ucb;	// maximal UCB sets over the program points
+  } t_crpd_cache;
+
+  /** UCB/ECB of a task (entry point) */
+  typedef struct
+  {
+    string name;
+    vector < t_crpd_cache > caches;
+  } t_crpd_task;
+
+ private:
+  int level;
+  string crpd_file;
+
+  /** Caches of the level with a CHMC classification */
+  vector < CacheParam * > caches;
+
+  /** Cache lines of cache cp accessed by instruction vinstr in context ctx */
+  set < t_address > getAccessedBlocks (Instruction * vinstr, Context * ctx, CacheParam * cp);
+
+  /** @return the CHMC of instruction vinstr in context ctx for cache cp, "" if not classified */
+  string getCHMC (Instruction * vinstr, Context * ctx, CacheParam * cp);
+
+  /** Backward transfer function of an instruction on the UCB set live */
+  void transferUCB (Instruction * vinstr, Context * ctx, CacheParam * cp, set < t_address > &live);
+
+  /** Computes the ECB and the maximal UCB sets of the entry point for cache cp */
+  t_crpd_cache analyseCache (CacheParam * cp, const vector < ContextualNode > &nodes);
+
+  /** @return the reload time of a cache line of cp */
+  int getReloadTime (CacheParam * cp);
+
+  /** Reads the tasks of crpd_file (if any), except the one named skip */
+  vector < t_crpd_task > readTasks (string skip);
+
+  /** Writes all tasks and their pairwise preemption costs in crpd_file */
+  void writeTasks (const vector < t_crpd_task > &tasks);
+
+  /** @return the bound on the reload cost of task preempted when preempted once by task preempting */
+  static long preemptionCost (const t_crpd_task & preempted, const t_crpd_task & preempting);
+
+ public:
+
+  /** Constructor */
+  CRPDAnalysis (Program * p, int vlevel, string vcrpd_file);
+
+  /** Checks if all required attributes are in the CFG (contexts, CHMC) */
+  bool CheckInputAttributes ();
+
+  /** Performs the analysis */
+  bool PerformAnalysis ();
+
+  /** Remove all private attributes */
+  void RemovePrivateAttributes ();
+
+};
+
+#endif
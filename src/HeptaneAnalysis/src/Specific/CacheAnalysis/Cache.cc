@@ -33,9 +33,67 @@
 #include <cassert>
 
 #include "Cache.h"
+#include "Logger.h"
 
 using namespace std;
 
+/** Mix v into the hash value h (abstract cache sets hashing) */
+static size_t
+HashCombine (size_t h, size_t v)
+{
+  return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+/**************************************************
+ *
+ *  Replacement policies
+ *
+ *************************************************/
+
+unsigned int
+GuaranteedLifeSpan (t_replacement_policy policy, unsigned int nbways)
+{
+  switch (policy)
+    {
+    case LRU:
+      return nbways;
+    case PLRU:
+      {
+	// a line is evicted once the log2(nbways) tree bits on its path point to it
+	unsigned int depth = 0;
+	while ((1U << depth) < nbways) { depth++; }
+	return (nbways == 1) ? 1 : depth + 1;
+      }
+    case MRU:
+      return (nbways == 1) ? 1 : 2;
+    case FIFO:
+    case RANDOM:
+      return 1;
+    default:
+      Logger::addFatal ("CacheAnalysis: invalid replacement policy");
+    }
+  return 1;
+}
+
+unsigned int
+PersistenceLifeSpan (t_replacement_policy policy, unsigned int nbways)
+{
+  if (policy == FIFO)
+    {
+      // while a line is cached, every conflicting line is inserted at most once after it
+      return nbways;
+    }
+  return GuaranteedLifeSpan (policy, nbways);
+}
+
+void
+ClearCacheSetTables ()
+{
+  CacheSetTable < MUST >::getTable ().clear ();
+  CacheSetTable < MAY >::getTable ().clear ();
+  CacheSetTable < PS >::getTable ().clear ();
+}
+
 /**************************************************
  *
  *  MUST implementation
@@ -43,32 +101,32 @@ using namespace std;
  *************************************************/
 
 /** Constructor */
-MUST::MUST (unsigned int nbways, unsigned int nbways_removed)
+MUST::MUST (unsigned int nbways, t_replacement_policy policy)
 {
   nb_ways = nbways;
-  nb_ways_removed = nbways_removed;
-  contents.resize (nb_ways);
+  nb_ways_analysis = GuaranteedLifeSpan (policy, nbways);
+  contents.resize (nb_ways_analysis);
 }
 
 /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
 bool
 MUST::Absent (t_address addr) const
 {
-  return GetAge (addr) >= nb_ways;
+  return GetAge (addr) >= nb_ways_analysis;
 }
 
 /** returns the age in the abstract cache of the cache line containing addr
-    between [0..nb_ways-1] if present
-    nb_ways+nb_ways_removed otherwise
+    between [0..nb_ways_analysis-1] if present
+    nb_ways otherwise
 */
 unsigned int
 MUST::GetAge (t_address addr) const
 {
-  for (unsigned int i = 0; i < nb_ways; i++)
+  for (unsigned int i = 0; i < nb_ways_analysis; i++)
     {
       if (contents[i].find (addr) != contents[i].end ()) { return i; }
     }
-  return nb_ways + nb_ways_removed;
+  return nb_ways;
 }
 
 /** Print the Abstract Cache Set for debugging purpose */
@@ -77,7 +135,7 @@ MUST::Print () const
 {
   cout << hex;
 
-  for (unsigned int i = 0; i < nb_ways; i++)
+  for (unsigned int i = 0; i < nb_ways_analysis; i++)
     {
       cout << "{";
       unsigned int cpt = 0;
@@ -88,7 +146,7 @@ MUST::Print () const
 	  cpt++;
 	}
       cout << "}";
-      if (i + 1 < nb_ways) { cout << " | "; }
+      if (i + 1 < nb_ways_analysis) { cout << " | "; }
     }
   cout << endl << dec;
 }
@@ -97,14 +155,14 @@ MUST::Print () const
 void
 MUST::Update (t_address addr)
 {
-  assert (nb_ways > 0);
+  assert (nb_ways_analysis > 0);
   assert (contents[0].size () <= 1);
 
   if (contents[0].find (addr) != contents[0].end ()) { return; } //nothing change in the set addr is alone in the first way
 
   bool found = false;
-  int pos = nb_ways;
-  for (unsigned int i = 1; i < nb_ways && !found; i++)
+  int pos = nb_ways_analysis;
+  for (unsigned int i = 1; i < nb_ways_analysis && !found; i++)
     {
       if (contents[i].erase (addr) == 1)
 	{
@@ -133,12 +191,12 @@ MUST::Update (t_address addr)
 void
 MUST::Update (const set < t_address > &addrs)
 {
-  assert (nb_ways > 0);
+  assert (nb_ways_analysis > 0);
   assert (contents[0].size () <= 1);
 
   unsigned int max_age = 0;
   // Find max_age: the age of the oldest accessed block.
-  for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end () && max_age < nb_ways; it++)
+  for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end () && max_age < nb_ways_analysis; it++)
     {
       max_age = max (max_age, GetAge (*it));
     }
@@ -146,10 +204,10 @@ MUST::Update (const set < t_address > &addrs)
   // only one line in addrs at the MRU position (the cache set is unchanged)
   if (max_age == 0) { return; } 
 
-  if (max_age < nb_ways) { contents[max_age].insert (contents[max_age - 1].begin (), contents[max_age - 1].end ()); }
+  if (max_age < nb_ways_analysis) { contents[max_age].insert (contents[max_age - 1].begin (), contents[max_age - 1].end ()); }
 
   //update the age
-  for (unsigned int i = min (max_age, nb_ways) - 1; i > 0; i--)
+  for (unsigned int i = min (max_age, nb_ways_analysis) - 1; i > 0; i--)
     {
       contents[i] = contents[i - 1];
     }
@@ -168,10 +226,10 @@ MUST::Join (const MUST & c)
 
   //build the resulting ACS
   vector < set < t_address > >result;
-  result.resize (nb_ways);
+  result.resize (nb_ways_analysis);
 
   //compute the addr present in both ACS and keep there maximal age
-  for (unsigned int i = 0; i < nb_ways; i++)
+  for (unsigned int i = 0; i < nb_ways_analysis; i++)
     {
       for (set < t_address >::const_iterator iter = contents[i].begin (); iter != contents[i].end (); iter++)
 	{
@@ -211,8 +269,23 @@ MUST::Join (const MUST & c)
 bool
 MUST::Equals (const MUST & c) const
 {
-  assert (nb_ways == c.nb_ways);
-  return this->contents == c.contents;
+  return nb_ways == c.nb_ways && nb_ways_analysis == c.nb_ways_analysis && this->contents == c.contents;
+}
+
+/** Hash value, equal for abstract cache sets that are Equals */
+size_t
+MUST::Hash () const
+{
+  size_t h = HashCombine (nb_ways, nb_ways_analysis);
+  for (unsigned int i = 0; i < contents.size (); i++)
+    {
+      h = HashCombine (h, i);
+      for (set < t_address >::const_iterator iter = contents[i].begin (); iter != contents[i].end (); iter++)
+	{
+	  h = HashCombine (h, *iter);
+	}
+    }
+  return h;
 }
 
 /**************************************************
@@ -377,8 +450,23 @@ MAY::Join (const MAY & c)
 bool
 MAY::Equals (const MAY & c) const
 {
-  assert (nb_ways == c.nb_ways);
-  return this->contents == c.contents;
+  return nb_ways == c.nb_ways && this->contents == c.contents;
+}
+
+/** Hash value, equal for abstract cache sets that are Equals */
+size_t
+MAY::Hash () const
+{
+  size_t h = nb_ways;
+  for (unsigned int i = 0; i < contents.size (); i++)
+    {
+      h = HashCombine (h, i);
+      for (set < t_address >::const_iterator iter = contents[i].begin (); iter != contents[i].end (); iter++)
+	{
+	  h = HashCombine (h, *iter);
+	}
+    }
+  return h;
 }
 
 
@@ -389,10 +477,11 @@ MAY::Equals (const MAY & c) const
  *************************************************/
 
 /** Constructor */
-PS::PS (unsigned int nbways, unsigned int nbways_removed)
+PS::PS (unsigned int nbways, t_replacement_policy policy)
 {
   nb_ways = nbways;
-  nb_ways_removed = nbways_removed;
+  nb_ways_analysis = PersistenceLifeSpan (policy, nbways);
+  refresh = (policy != FIFO);
 }
 
 /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
@@ -404,13 +493,13 @@ PS::Absent (t_address addr) const
     {
       return true;
     }
-  assert (it_this->second.size () < nb_ways);	//check for evicted
+  assert (it_this->second.size () < nb_ways_analysis);	//check for evicted
   return false;
 }
 
 /** returns the age in the abstract cache of the cache line containing addr
-    between [0..nb_ways-1] if present
-    nb_ways+nb_ways_removed otherwise
+    between [nb_ways-nb_ways_analysis..nb_ways-1] if present
+    nb_ways otherwise
 */
 unsigned int
 PS::GetAge (t_address addr) const
@@ -420,8 +509,8 @@ PS::GetAge (t_address addr) const
     {
       return nb_ways;
     }
-  assert (it_this->second.size () < nb_ways);	//check for evicted
-  return it_this->second.size () + nb_ways_removed;
+  assert (it_this->second.size () < nb_ways_analysis);	//check for evicted
+  return it_this->second.size () + nb_ways - nb_ways_analysis;
 }
 
 /** Print the Abstract Cache Set for debugging purpose */
@@ -458,8 +547,9 @@ PS::Update (t_address addr)
 
   for (map < t_address, set < t_address > >::iterator it_this = contents.begin (); it_this != contents.end (); it_this++)
     {
+      if (it_this->first == addr) { continue; }
       it_this->second.insert (addr);
-      if (it_this->second.size () == nb_ways)
+      if (it_this->second.size () == nb_ways_analysis)
 	{
 	  to_evict.insert (it_this->first);
 	}
@@ -471,8 +561,17 @@ PS::Update (t_address addr)
       evicted.insert (*it);
     }
 
-  contents[addr].clear ();
-  evicted.erase (addr);
+  if (refresh)
+    {
+      contents[addr].clear ();
+      evicted.erase (addr);
+    }
+  else if (evicted.find (addr) == evicted.end ())
+    {
+      // FIFO: a hit does not rejuvenate the line, its conflicts are counted from its first load.
+      // A line possibly evicted may be hit at any position, thus it stays evicted.
+      contents[addr];
+    }
 }
 
 /** Update function when a set of addresses is accessed
@@ -495,7 +594,7 @@ PS::Update (const set < t_address > &addrs)
 	  absent.erase (it_this->first);
 	}
 
-      if (it_this->second.size () >= nb_ways)
+      if (it_this->second.size () >= nb_ways_analysis)
 	{
 	  to_evict.insert (it_this->first);
 	}
@@ -512,7 +611,7 @@ PS::Update (const set < t_address > &addrs)
     {
       contents[*it].insert (addrs.begin (), addrs.end ());
       contents[*it].erase (*it);
-      if (contents[*it].size () >= nb_ways)
+      if (contents[*it].size () >= nb_ways_analysis)
 	{
 	  to_evict.insert (*it);
 	}
@@ -538,7 +637,7 @@ PS::Join (const PS & c)
       if (evicted.find (it_c->first) != evicted.end ())	{ continue; }			//if in this->evicted no need to insert it
       contents[it_c->first].insert (it_c->second.begin (), it_c->second.end ());
       map < t_address, set < t_address > >::iterator it_this = contents.find (it_c->first);
-      if (it_this->second.size () >= nb_ways)
+      if (it_this->second.size () >= nb_ways_analysis)
 	{
 	  evicted.insert (it_this->first);
 	  contents.erase (it_this);
@@ -559,6 +658,26 @@ PS::Join (const PS & c)
 bool
 PS::Equals (const PS & c) const
 {
-  assert (nb_ways == c.nb_ways);
-  return this->contents == c.contents && this->evicted == c.evicted;
+  return nb_ways == c.nb_ways && nb_ways_analysis == c.nb_ways_analysis && refresh == c.refresh
+    && this->contents == c.contents && this->evicted == c.evicted;
+}
+
+/** Hash value, equal for abstract cache sets that are Equals */
+size_t
+PS::Hash () const
+{
+  size_t h = HashCombine (HashCombine (nb_ways, nb_ways_analysis), refresh);
+  for (map < t_address, set < t_address > >::const_iterator it = contents.begin (); it != contents.end (); it++)
+    {
+      h = HashCombine (h, it->first);
+      for (set < t_address >::const_iterator iter = it->second.begin (); iter != it->second.end (); iter++)
+	{
+	  h = HashCombine (h, *iter);
+	}
+    }
+  for (set < t_address >::const_iterator iter = evicted.begin (); iter != evicted.end (); iter++)
+    {
+      h = HashCombine (h, *iter);
+    }
+  return h;
 }
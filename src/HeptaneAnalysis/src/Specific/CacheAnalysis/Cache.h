@@ -30,6 +30,8 @@
 
 #include <set>
 #include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <cassert>
@@ -39,9 +41,163 @@
 #include "Generic/cow_ptr.h"
 
 #include "Analysis.h"		//useful for t_address type
+#include "Generic/Config.h"		//useful for t_replacement_policy type
 
 using namespace std;
 
+/** Minimal number of entries of a CacheSetTable before its first purge */
+#define CACHESETTABLE_MIN_PURGE 4096
+
+/**************************************************
+ *
+ * CacheSetTable
+ *
+ * Hash-consing of the abstract cache sets of type T (MUST, MAY or PS):
+ * equal sets share a single canonical instance, so that two sets are
+ * equal iff they have the same address, and the results of Join and
+ * Update are memoised per (set, set) and (set, address).
+ *
+ * The canonical instances are shared with the table, a write access
+ * through a cow_ptr thus copies them first.
+ * There is one table per thread and type T: the abstract caches of an
+ * analysis are never shared with another thread. The tables are
+ * cleared at the end of every cache analysis (ClearCacheSetTables), so
+ * that they do not grow from one request to the next in server mode.
+ *
+ *************************************************/
+
+template < typename T > class CacheSetTable
+{
+ private:
+  typedef pair < const T *, const T * > t_join_key;
+  typedef pair < const T *, t_address > t_update_key;
+
+  /** Canonical instances, by hash value */
+  unordered_map < size_t, vector < cow_ptr < T > > > sets;
+  size_t nb_canonical;
+
+  /** Memoised results of Join and Update */
+  map < t_join_key, cow_ptr < T > > joins;
+  map < t_update_key, cow_ptr < T > > updates;
+
+  /** Number of entries from which the table is purged */
+  size_t purge_limit;
+
+  CacheSetTable ()
+    {
+      nb_canonical = 0;
+      purge_limit = CACHESETTABLE_MIN_PURGE;
+    }
+
+  size_t size () const
+  {
+    return nb_canonical + joins.size () + updates.size ();
+  }
+
+  /** Forgets the memoised results and the canonical instances no longer used by an abstract cache */
+  void purge ()
+  {
+    joins.clear ();
+    updates.clear ();
+    for (typename unordered_map < size_t, vector < cow_ptr < T > > >::iterator it = sets.begin (); it != sets.end ();)
+      {
+	vector < cow_ptr < T > > &bucket = it->second;
+	for (size_t i = 0; i < bucket.size ();)
+	  {
+	    if (bucket[i].unique ())
+	      {
+		bucket[i] = bucket.back ();
+		bucket.pop_back ();
+		nb_canonical--;
+	      }
+	    else
+	      i++;
+	  }
+	if (bucket.empty ())
+	  it = sets.erase (it);
+	else
+	  it++;
+      }
+    purge_limit = max ((size_t) CACHESETTABLE_MIN_PURGE, 2 * nb_canonical);
+  }
+
+ public:
+  /** Forgets all the canonical instances and memoised results (no abstract cache may use them any more) */
+  void clear ()
+  {
+    unordered_map < size_t, vector < cow_ptr < T > > > ().swap (sets);
+    joins.clear ();
+    updates.clear ();
+    nb_canonical = 0;
+    purge_limit = CACHESETTABLE_MIN_PURGE;
+  }
+
+  /** @return the table of the current thread */
+  static CacheSetTable < T > &getTable ()
+  {
+    static thread_local CacheSetTable < T > table;
+    return table;
+  }
+
+  /** @return the canonical instance equal to s */
+  cow_ptr < T > intern (const T & s)
+  {
+    if (size () >= purge_limit)
+      purge ();
+
+    vector < cow_ptr < T > > &bucket = sets[s.Hash ()];
+    for (size_t i = 0; i < bucket.size (); i++)
+      {
+	if (bucket[i].get ()->Equals (s))
+	  return bucket[i];
+      }
+    cow_ptr < T > canonical (new T (s));
+    bucket.push_back (canonical);
+    nb_canonical++;
+    return canonical;
+  }
+
+  /** @return the canonical instance of the join of the canonical instances a and b */
+  cow_ptr < T > join (const cow_ptr < T > &a, const cow_ptr < T > &b)
+  {
+    if (a.get () == b.get ())
+      return a;
+    t_join_key key (a.get (), b.get ());
+    typename map < t_join_key, cow_ptr < T > >::iterator it = joins.find (key);
+    if (it != joins.end ())
+      return it->second;
+
+    T result (*a);
+    result.Join (*b);
+    cow_ptr < T > canonical = intern (result);
+    joins.insert (make_pair (key, canonical));
+    return canonical;
+  }
+
+  /** @return the canonical instance of the canonical instance a updated by an access to addr */
+  cow_ptr < T > update (const cow_ptr < T > &a, t_address addr)
+  {
+    t_update_key key (a.get (), addr);
+    typename map < t_update_key, cow_ptr < T > >::iterator it = updates.find (key);
+    if (it != updates.end ())
+      return it->second;
+
+    T result (*a);
+    result.Update (addr);
+    cow_ptr < T > canonical = intern (result);
+    updates.insert (make_pair (key, canonical));
+    return canonical;
+  }
+
+  /** @return the canonical instance of the canonical instance a updated by an access to one of addrs (not memoised) */
+  cow_ptr < T > update (const cow_ptr < T > &a, const set < t_address > &addrs)
+  {
+    T result (*a);
+    result.Update (addrs);
+    return intern (result);
+  }
+};
+
 /**************************************************
  *
  * AbstractCache
@@ -53,7 +209,7 @@ using namespace std;
 template < typename T > class AbstractCache
 {
  private:
-  /** internal structure */
+  /** internal structure: canonical instances of the abstract cache sets (see CacheSetTable) */
   vector < cow_ptr < T > >contents;
   unsigned int nb_sets;
   unsigned int nb_ways;
@@ -84,19 +240,19 @@ template < typename T > class AbstractCache
       nb_sets = nbsets;
       nb_ways = nbways;
       cacheline_size = cachelinesize;
-      cow_ptr < T > tmp (new T (nb_ways));
+      cow_ptr < T > tmp = CacheSetTable < T >::getTable ().intern (T (nb_ways));
       contents.resize (nb_sets, tmp);
     }
 
   /** Constructor for the MUST and PS Abstract cache only
-      nbways_removed is used to return a correct age to the function getAge when non LRU policy is used
+      nbways is the real associativity, the abstract cache sets derive from the replacement policy how many ways they can guarantee
   */
-  AbstractCache (unsigned int nbsets, unsigned int nbways, unsigned int nbways_removed, unsigned int cachelinesize)
+  AbstractCache (unsigned int nbsets, unsigned int nbways, t_replacement_policy policy, unsigned int cachelinesize)
     {
       nb_sets = nbsets;
       nb_ways = nbways;
       cacheline_size = cachelinesize;
-      cow_ptr < T > tmp (new T (nb_ways, nbways_removed));
+      cow_ptr < T > tmp = CacheSetTable < T >::getTable ().intern (T (nb_ways, policy));
       contents.resize (nb_sets, tmp);
     }
 
@@ -118,9 +274,10 @@ template < typename T > class AbstractCache
 	return false;
       }
 
+    // canonical instances: equal sets have the same address
     for (unsigned int s = 0; s < nb_sets; s++)
       {
-	if (c.contents[s]->Equals (*(contents[s])) == false)
+	if (c.contents[s].get () != contents[s].get ())
 	  {
 	    return false;
 	  }
@@ -196,9 +353,10 @@ template < typename T > class AbstractCache
   void Join (const AbstractCache < T > &c)
   {
     assert (c.nb_sets == nb_sets && c.nb_ways == nb_ways && c.cacheline_size == cacheline_size);
+    CacheSetTable < T > &table = CacheSetTable < T >::getTable ();
     for (unsigned int s = 0; s < nb_sets; s++)
       {
-	contents[s]->Join (*(c.contents[s]));
+	contents[s] = table.join (contents[s], c.contents[s]);
       }
   }
 
@@ -211,15 +369,14 @@ template < typename T > class AbstractCache
       {
 	addr = computeStartLine (addr);
 	int s = computeSet (addr);
+	CacheSetTable < T > &table = CacheSetTable < T >::getTable ();
 	if (cac == "A")
 	  {
-	    contents[s]->Update (addr);
+	    contents[s] = table.update (contents[s], addr);
 	  }
 	else			//cac=="U" || cac="UN"
 	  {
-	    T before = *(contents[s]);
-	    contents[s]->Update (addr);
-	    contents[s]->Join (before);
+	    contents[s] = table.join (table.update (contents[s], addr), contents[s]);
 	  }
       }
   }
@@ -253,20 +410,64 @@ template < typename T > class AbstractCache
 	  }
 	else
 	  {
-	    contents[it->first]->Update (it->second);
+	    contents[it->first] = CacheSetTable < T >::getTable ().update (contents[it->first], it->second);
 	  }
       }
     else			//Otherwise, we have to use the update function for unpredictable accesses
       {
 	for (map < int, set < t_address > >::iterator it = inserted.begin (); it != inserted.end (); it++)
 	  {
-	    contents[it->first]->Update (it->second);	//safe for UNCERTAIN AND ALWAYS based on the semantic of unpredictable accesses
+	    //safe for UNCERTAIN AND ALWAYS based on the semantic of unpredictable accesses
+	    contents[it->first] = CacheSetTable < T >::getTable ().update (contents[it->first], it->second);
 	  }
       }
   }
 };
 
 
+/**************************************************
+ *
+ *  Replacement policies
+ *
+ *  The MUST and PS abstract cache sets are LRU age vectors whose length
+ *  depends on the policy. No dedicated PLRU, FIFO or MRU abstract set is
+ *  used: without knowledge of the initial cache contents, a non-relational
+ *  must domain for these policies gives the same classifications.
+ *
+ *  - PLRU (tree bits): a line x is the victim of a miss only when the
+ *    log2(n) bits on its path all point to it. A bit on the path of x is
+ *    set towards x only by an access to a line of the other subtree of
+ *    that node, and the subtrees of distinct nodes are disjoint, so the
+ *    number of bits pointing to x is at most the number of distinct
+ *    lines accessed since x, and no hit evicts. Tracking these bit counts
+ *    is the LRU age vector of length log2(n)+1. A more precise domain
+ *    would need the relative placement of the lines in the tree.
+ *  - FIFO: a hit leaves the line at an unknown position, so one access to
+ *    another line may evict it. A line is known to be younger only after
+ *    a miss, and a miss is only certain when the cache is known to be
+ *    empty, which is not assumed. The gain of FIFO is in persistence (PS):
+ *    conflicts are counted from the first load of the line.
+ *  - MRU: the access setting the last MRU bit clears all the others, so
+ *    after x and one other line, x may be the next victim (life span 2).
+ *
+ *************************************************/
+
+/** @return the number of distinct cache lines a cache set of associativity nbways is guaranteed to keep
+    under the replacement policy (minimum life span: nbways for LRU, log2(nbways)+1 for PLRU, 2 for MRU, 1 for FIFO and RANDOM).
+    Used as the length of the MUST abstract cache sets.
+*/
+unsigned int GuaranteedLifeSpan (t_replacement_policy policy, unsigned int nbways);
+
+/** @return the number of distinct conflicting cache lines that may evict a cache line since its first load
+    under the replacement policy. Same as GuaranteedLifeSpan, except for FIFO where hits do not change
+    the order of the lines, so that a line can only be evicted by nbways distinct conflicting lines.
+    Used by the PS abstract cache sets.
+*/
+unsigned int PersistenceLifeSpan (t_replacement_policy policy, unsigned int nbways);
+
+/** Clears the CacheSetTables (MUST, MAY and PS) of the current thread, once the abstract caches of an analysis are deleted */
+void ClearCacheSetTables ();
+
 /**************************************************
  *
  *  AbstractCacheSet MUST
@@ -276,17 +477,16 @@ template < typename T > class AbstractCache
 class MUST
 {
  private:
-  unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
-  //(cf. cache abstract factory in ICacheAnalysis.cc or DCacheAnalysis.cc)
-  unsigned int nb_ways_removed;	//used in function GetAge and useful when a non LRU policy is used
+  unsigned int nb_ways;		//associativity of the cache
+  unsigned int nb_ways_analysis;	//number of ways guaranteed by the replacement policy (minimum life span, cf. GuaranteedLifeSpan)
   vector < set < t_address > >contents;	//abstract cache sets
 
  public:
 
   /** Constructor */
-  explicit MUST (unsigned int nbways, unsigned int nbways_removed);
+  explicit MUST (unsigned int nbways, t_replacement_policy policy);
 
-  /** @return the age in the abstract cache of the cache line containing addr between [0..nb_ways-1] if present,  nb_ways+nb_ways_removed otherwise
+  /** @return the age in the abstract cache of the cache line containing addr between [0..nb_ways_analysis-1] if present, nb_ways otherwise
    */
   unsigned int GetAge (t_address addr) const;
 
@@ -310,6 +510,9 @@ class MUST
   /** returns true if this is equal to c and false otherwise */
   bool Equals (const MUST &) const;
 
+  /** Hash value, equal for abstract cache sets that are Equals (see CacheSetTable) */
+  size_t Hash () const;
+
 };
 
 /**************************************************
@@ -352,6 +555,9 @@ class MAY
   /** returns true if this is equal to c and false otherwise */
   bool Equals (const MAY &) const;
 
+  /** Hash value, equal for abstract cache sets that are Equals (see CacheSetTable) */
+  size_t Hash () const;
+
 };
 
 /**************************************************
@@ -363,20 +569,20 @@ class MAY
 class PS
 {
  private:
-  unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
-  //(cf. cache abstract factory in ICacheAnalysis.cc or DCacheAnalysis.cc)
-  unsigned int nb_ways_removed;	//used in function GetAge and useful when a non LRU policy is used
+  unsigned int nb_ways;		//associativity of the cache
+  unsigned int nb_ways_analysis;	//number of conflicts leading to a possible eviction (cf. PersistenceLifeSpan)
+  bool refresh;			//true if an access makes the cache line the youngest one again (false for FIFO)
   map < t_address, set < t_address > >contents;	//abstract cache sets
   set < t_address > evicted;	//used to reduce the size of the map (contents). No need to maintain the conflicts of evicted cache lines
 
  public:
 
   /** Constructor */
-  explicit PS (unsigned int nbways, unsigned int nbways_removed);
+  explicit PS (unsigned int nbways, t_replacement_policy policy);
 
   /** returns the age in the abstract cache of the cache line containing addr
-      between [0..nb_ways-1] if present
-      nb_ways+nb_ways_removed otherwise
+      between [nb_ways-nb_ways_analysis..nb_ways-1] if present
+      nb_ways otherwise
   */
   unsigned int GetAge (t_address addr) const;
 
@@ -400,6 +606,9 @@ class PS
   /** returns true if this is equal to c and false otherwise */
   bool Equals (const PS &) const;
 
+  /** Hash value, equal for abstract cache sets that are Equals (see CacheSetTable) */
+  size_t Hash () const;
+
 };
 
 #endif
@@ -21,69 +21,236 @@ See CREDITS.txt for credits of authorship
 ------------------------------------------------------------------------ */
 
 /**
- AbstractCacheStateAttribute definition with the names used by the Instruction and Data cache analysis
+ Store of the abstract cache states used by the Instruction and Data cache analysis
   */
 
 #ifndef CACHE_ANALYSIS_H
 #define CACHE_ANALYSIS_H
 
-
-/*************************************************************************************************************************
- Names of internal attributes
- **************************************************************************************************************************/
-
-// ACSMAY_in and ACSMAY_out, of type AbstractCacheStateAttribute<MAY>, attached to nodes
-#define ACSMAYInName "ACSMAY_in"
-#define ACSMAYOutName "ACSMAY_out"
-
-// ACSMUST_in and ACSMUST_out, of type AbstractCacheStateAttribute<MUST>, attached to nodes
-#define ACSMUSTInName "ACSMUST_in"
-#define ACSMUSTOutName "ACSMUST_out"
-
-// ACSPS_in and ACSPS_out, of type AbstractCacheStateAttribute<PS>, attached to nodes (PS: persistent)
-#define ACSPSInName "ACSPS_in"
-#define ACSPSOutName "ACSPS_out"
+#include <map>
+#include <set>
+#include <vector>
+#include <functional>
+#include "Specific/CacheAnalysis/Cache.h"
+#include "Generic/ContextHelper.h"
+#include "Generic/AnalysisHelper.h"
 
 
 /*************************************************************************************************************************
- AbstractCache state attribute
+ Abstract cache states of a fixed point
  **************************************************************************************************************************/
 
 // ------------------------------------------------------
-// AbstractCache state attribute
-// for now, implements no serialisation function (empty)
-// just want to attach the abstract cache states to the nodes,
-// not to serialise them
+// Abstract cache states (MUST, MAY or PS) of a fixed point
+// computation, private to the cache analysis.
 //
-// generic type T stands for MUST, MAY or PS (see Cache.h for more details)
+// An input state is only kept for the contextual nodes where
+// the flow joins: nodes with several or no predecessors,
+// targets of backedges, entries of the analysed region (PS).
+// The input state of any other node is the output state of
+// its single predecessor, recomputed on demand from the
+// closest kept state. During the classification, a kept
+// state is released as soon as all the nodes depending on
+// it are classified.
 //
+// generic type T stands for MUST, MAY or PS (see Cache.h for more details)
 // -----------------------------------------------------
-/**
- * Abstract cache state attribute (attached to CFG nodes)
- */
-template < typename T > class AbstractCacheStateAttribute:public NonSerialisableAttribute
+template < typename T > class ACSStore
 {
 public:
-  /** corresponding AbstractCache<T> */
-  AbstractCache < T > cache;
+  /** Abstract execution of the accesses of a contextual node */
+  typedef std::function < void (ContextualNode &, AbstractCache < T > &) > t_transfer;
+
+private:
+  t_transfer transfer;
+  /** State of the nodes not reached yet */
+  AbstractCache < T > initial;
+  set < Edge * > backedges;
+
+  /** Analysed region (PS: nodes of the outer loops), all the nodes when not restricted */
+  bool restricted;
+  set < ContextualNode > region;
+
+  /** Kept input states */
+  map < ContextualNode, AbstractCache < T > > states;
+  /** Number of nodes still to be classified for every kept state */
+  map < ContextualNode, unsigned int > pending;
+
+  /** @return the predecessors of cn in the analysed region, backedges excluded if asked */
+  vector < ContextualNode > getPredecessors (const ContextualNode & cn, bool excludeBackedges)
+  {
+    vector < ContextualNode > preds, all = GetContextualPredecessors (cn);
+    for (size_t i = 0; i < all.size (); i++)
+      if (inRegion (all[i]) && (!excludeBackedges || AnalysisHelper::FilterBackedge (cn.node, all[i].node, backedges)))
+	preds.push_back (all[i]);
+    return preds;
+  }
+
+  /** @return true if the input state of cn is kept (else it is the output of its single predecessor) */
+  bool isKept (const ContextualNode & cn)
+  {
+    vector < ContextualNode > preds = getPredecessors (cn, false);
+    return preds.size () != 1 || !AnalysisHelper::FilterBackedge (cn.node, preds[0].node, backedges);
+  }
+
+  /** @return the node keeping the state from which the input state of cn is computed */
+  ContextualNode getKeeper (const ContextualNode & cn)
+  {
+    ContextualNode current = cn;
+    while (!isKept (current))
+      current = getPredecessors (current, false)[0];
+    return current;
+  }
+
+  /** Add to work the kept nodes whose input state depends on the output state of cn */
+  void insertDependents (const ContextualNode & cn, bool excludeBackedges, set < ContextualNode > &work)
+  {
+    vector < ContextualNode > succ = GetContextualSuccessors (cn);
+    for (size_t i = 0; i < succ.size (); i++)
+      {
+	if (!inRegion (succ[i]) || (excludeBackedges && !AnalysisHelper::FilterBackedge (succ[i].node, cn.node, backedges)))
+	  continue;
+	if (isKept (succ[i]))
+	  work.insert (succ[i]);
+	else
+	  insertDependents (succ[i], excludeBackedges, work);
+      }
+  }
+
+  /** Recompute the input state of a kept node from its predecessors.
+      @return true if the state changed */
+  bool update (const ContextualNode & cn, bool excludeBackedges)
+  {
+    vector < ContextualNode > preds = getPredecessors (cn, excludeBackedges);
+    if (preds.size () == 0)
+      return false;
+    AbstractCache < T > new_in = getOut (preds[0]);
+    for (size_t i = 1; i < preds.size (); i++)
+      new_in.Join (getOut (preds[i]));
+
+    typename map < ContextualNode, AbstractCache < T > >::iterator it = states.find (cn);
+    if (it == states.end ())
+      {
+	if (new_in.Equals (initial))
+	  return false;
+	states.insert (make_pair (cn, new_in));
+	return true;
+      }
+    if (it->second.Equals (new_in))
+      return false;
+    it->second = new_in;
+    return true;
+  }
+
+public:
+  /** Constructor: states computed by vtransfer from vinitial. When vrestricted, the analysis is
+      restricted to a region made of the nodes given by addToRegion */
+  ACSStore (t_transfer vtransfer, const AbstractCache < T > &vinitial, const set < Edge * > &vbackedges, bool vrestricted = false)
+  {
+    transfer = vtransfer;
+    initial = vinitial;
+    backedges = vbackedges;
+    restricted = vrestricted;
+  }
+
+  void addToRegion (const ContextualNode & cn)
+  {
+    assert (restricted);
+    region.insert (cn);
+  }
+
+  bool inRegion (const ContextualNode & cn) const
+  {
+    return !restricted || region.find (cn) != region.end ();
+  }
+
+  /** @return the input state of a node of the region */
+  AbstractCache < T > getIn (const ContextualNode & cn)
+  {
+    ContextualNode keeper = getKeeper (cn);
+    typename map < ContextualNode, AbstractCache < T > >::iterator it = states.find (keeper);
+    AbstractCache < T > acs = (it == states.end ())? initial : it->second;
+    // Forward along the single-predecessor nodes up to cn
+    vector < ContextualNode > path;
+    for (ContextualNode current = cn; current != keeper; current = getPredecessors (current, false)[0])
+      path.push_back (current);
+    for (size_t i = path.size (); i > 0; i--)
+      {
+	ContextualNode pred = (i == path.size ())? keeper : path[i];
+	transfer (pred, acs);
+      }
+    return acs;
+  }
+
+  /** @return the output state of a node of the region */
+  AbstractCache < T > getOut (const ContextualNode & cn)
+  {
+    AbstractCache < T > acs = getIn (cn);
+    ContextualNode current = cn;
+    transfer (current, acs);
+    return acs;
+  }
+
+  /** Fixed point computation from the nodes of start, whose output states are
+      propagated first. Every node depending on them is visited at least once.
+      Backedges are ignored if asked (first step of the MUST analysis). */
+  void fixpoint (const set < ContextualNode > &start, bool excludeBackedges)
+  {
+    set < ContextualNode > work, next, visited;
+    for (set < ContextualNode >::const_iterator it = start.begin (); it != start.end (); it++)
+      insertDependents (*it, excludeBackedges, work);
+    while (!work.empty ())
+      {
+	for (set < ContextualNode >::iterator it = work.begin (); it != work.end (); it++)
+	  {
+	    bool changed = update (*it, excludeBackedges);
+	    if (visited.insert (*it).second || changed)
+	      insertDependents (*it, excludeBackedges, next);
+	  }
+	work.swap (next);
+	next.clear ();
+      }
+  }
+
+  /** Count the nodes of the region to be classified, for every kept state */
+  static bool addUses (Cfg * c, Node * n, void *param)
+  {
+    ACSStore < T > *store = (ACSStore < T > *)param;
+    assert (c->HasAttribute (ContextListAttributeName));
+    const ContextList & contexts = (ContextList &) c->GetAttribute (ContextListAttributeName);
+    for (ContextList::const_iterator context = contexts.begin (); context != contexts.end (); context++)
+      {
+	ContextualNode cn (*context, n);
+	if (store->inRegion (cn))
+	  store->pending[store->getKeeper (cn)]++;
+      }
+    return true;
+  }
 
-  /** Constructor */
-  AbstractCacheStateAttribute < T > (const AbstractCache < T > &ca)
+  /** To be called before the classification of the nodes of p, for the early release of the states */
+  void prepareClassification (Program * p)
   {
-    cache = ca;
-  };
+    AnalysisHelper::applyToAllNodesRecursive (p, addUses, this);
+  }
 
-  /** Cloning function */
-  AbstractCacheStateAttribute < T > *clone ()
+  /** The classification of a node is done: release the state it depends on when it is no longer used */
+  void release (const ContextualNode & cn)
   {
-    return new AbstractCacheStateAttribute < T > (cache);
-  };
+    ContextualNode keeper = getKeeper (cn);
+    typename map < ContextualNode, unsigned int >::iterator it = pending.find (keeper);
+    assert (it != pending.end () && it->second > 0);
+    if (--(it->second) == 0)
+      {
+	pending.erase (it);
+	states.erase (keeper);
+      }
+  }
 
-  /** Printing function */
-  void Print (std::ostream & os)
+  /** Number of kept states (statistics) */
+  size_t size () const
   {
-    os << "(type NonSerialisableAbstractCacheStateAttribute, name " << name << ")";
-  };
+    return states.size ();
+  }
 };
 
 #endif
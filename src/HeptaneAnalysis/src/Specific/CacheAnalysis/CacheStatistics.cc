@@ -107,7 +107,7 @@ void CacheStatistics::PerformAnalysis ( CacheParam * aCache, const vector < Cfg
 		  const vector < Instruction * >&instr = CurrentNode->GetAsm ();
 		  for (size_t i = 0; i < instr.size (); ++i)
 		    {
-		      if ( (aCache->type == DCACHE || aCache->type == PERFECTDCACHE) && ! Arch::isLoad (instr[i]->GetCode ()))
+		      if ( (aCache->type == DCACHE || aCache->type == PERFECTDCACHE) && ! AnalysisHelper::isLoad(instr[i]))
 			continue;
 		      string chmc = getCHMC (contexts[ct], instr[i], aCache);
 		      size_t occurrences = getOccurrencesCount (frequency, contexts[ct], instr[i], aCache);
@@ -250,7 +250,7 @@ CacheStatistics::getCHMC (Context * context, Instruction * inst, CacheParam * ca
       break;
     case DCACHE:
     case PERFECTDCACHE:
-      assert (Arch::isLoad (inst->GetCode ()));
+      assert (AnalysisHelper::isLoad(inst));
       chmc_name = AnalysisHelper::mkContextAttrName( CHMCAttributeNameData (cache->level), context);
       break;
     default:
@@ -445,7 +445,7 @@ void CacheStatistics::CheckInstrHaveCacheCategorizationAttribute ()
 				  has_icache_info[l-1] = false;
 			      }
 			 
-			    if (has_dcache && Arch::isLoad (instr->GetCode ()))
+			    if (has_dcache && AnalysisHelper::isLoad(instr))
 			      {
 				if (! instr->HasAttribute (AnalysisHelper::mkContextAttrName( CHMCAttributeNameData (l), vcontext)))
 				  has_dcache_info[l-1] = false;
@@ -57,10 +57,6 @@
 #include "Generic/Timer.h"
 #include "arch.h"
 
-// inlines...
-#define getACSNode(T, NODE, IDATTR) ((AbstractCacheStateAttribute < T > &)NODE->GetAttribute(IDATTR))
-#define getACSContextualNode(T, ELEM, IDATTR) getACSNode(T, ELEM.node,IDATTR)
-
 /*************************************************************************************************************************
  CacheFactory functions
 **************************************************************************************************************************/
@@ -68,95 +64,21 @@
 /** Returns an empty Must cache */
 AbstractCache < MUST > DCacheAnalysis::CacheFactoryMUST() const
 {
-  // default initialization (LRU)
-  unsigned int nb_ways_analysis = nb_ways;
-  unsigned int nb_ways_removed = 0;
-
-  // Compute length of ACS for Must analysis depending on the replacement policy
-  switch (replacement_policy)
-    {
-    case LRU:
-      nb_ways_analysis = nb_ways;
-      nb_ways_removed = 0;
-      break;
-    case PLRU:
-      if (nb_ways == 1)
-	{
-	  nb_ways_analysis = 1;
-	}
-      else
-	{
-	  double n = log((double)nb_ways) / log(2.0) + 1;
-	  nb_ways_analysis = static_cast < unsigned int >(n);
-	}
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case MRU:
-      nb_ways_analysis = (nb_ways == 1) ? 1 : 2;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case FIFO:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case RANDOM:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    default:
-      Logger::addFatal("DCacheAnalysis: the replacement policy is not implemented");
-    }
-
-  return AbstractCache < MUST > (nb_sets, nb_ways_analysis, nb_ways_removed, cacheline_size);
+  // The abstract cache sets derive the guaranteed number of ways from the replacement policy
+  return AbstractCache < MUST > (nb_sets, nb_ways, replacement_policy, cacheline_size);
 }
 
 /* Returns an empty PS cache */
 AbstractCache < PS > DCacheAnalysis::CacheFactoryPS() const
 {
-  // default initialization (LRU)
-  unsigned int nb_ways_analysis = nb_ways;
-  unsigned int nb_ways_removed = 0;
-
-  // Compute length of ACS for PS analysis depending on the replacement policy
-  switch (replacement_policy)
-    {
-    case LRU:
-      nb_ways_analysis = nb_ways;
-      nb_ways_removed = 0;
-      break;
-    case PLRU:
-      if (nb_ways == 1)
-	{
-	  nb_ways_analysis = 1;
-	}
-      else
-	{
-	  double n = log((double)nb_ways) / log((double)2) + 1;
-	  nb_ways_analysis = static_cast < unsigned int >(n);
-	}
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case MRU:
-      nb_ways_analysis = (nb_ways == 1) ? 1 : 2;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case FIFO:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case RANDOM:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    default:
-      Logger::addFatal("DCacheAnalysis: the replacement policy is not implemented");
-    }
-
-  return AbstractCache < PS > (nb_sets, nb_ways_analysis, nb_ways_removed, cacheline_size);
+  // The abstract cache sets derive the guaranteed number of ways from the replacement policy
+  return AbstractCache < PS > (nb_sets, nb_ways, replacement_policy, cacheline_size);
 }
 
 /* Build an empty May cache */
-/*TODO: implementation of an infinite ACS for the PLRU and RANDOM May analysis (check MLS/Evict bound)*/
+/* No MAY analysis for PLRU with more than 2 ways: interleaving hits on lines
+   accessed after x, x may survive any number of distinct accesses (no evict
+   bound). No MAY analysis for RANDOM either. */
 AbstractCache < MAY > DCacheAnalysis::CacheFactoryMAY() const
 {
   // default initialization (LRU)
@@ -227,7 +149,7 @@ static bool CheckInstrHaveDataAccessAttribute(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      if (! vi[i]->HasAttribute(id))
 		{
@@ -249,8 +171,7 @@ static bool CheckInstrHaveDataAddresses(Cfg * c, Node * n, void *param)
   vector < Instruction * >vi = n->GetAsm();
   for (size_t i = 0; i < vi.size(); i++)
     {
-      string vinstr = vi[i]->GetCode();
-      if (Arch::isLoad(vinstr) || Arch::isStore(vinstr))
+      if (AnalysisHelper::isLoad(vi[i]) || AnalysisHelper::isStore(vi[i]))
 	{
 	  assert(c->HasAttribute(ContextListAttributeName));
 	  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -312,7 +233,7 @@ static bool initL1AccessAttributeForData(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      vi[i]->SetAttribute(AnalysisHelper::mkContextAttrName(CACattName, currentContext), A);
 	    }
@@ -373,7 +294,7 @@ bool static ComputeBlockCountAttribute(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      set < t_address > accessedBlocks = ca->getDataAddress(vi[i], (*context));
 	      assert(accessedBlocks.size() > 0);
@@ -404,7 +325,7 @@ bool static StubFunction(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (! Arch::isLoad(vi[i]->GetCode()))
+	  if (! AnalysisHelper::isLoad(vi[i]))
 	    {
 	      vi[i]->SetAttribute(CHMCAttName, AUnref);
 	    }
@@ -414,255 +335,53 @@ bool static StubFunction(Cfg * c, Node * n, void *param)
 }
 
 
-template < typename T > void DCacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName) 
-{
-  if (Arch::isLoad(vinstr->GetCode()))
-    {
-      assert(vinstr->HasAttribute(idAccessName));
-      string accessValue = ((SerialisableStringAttribute &) (vinstr->GetAttribute(idAccessName))).GetValue();
-      if (accessValue != "N")
-	{
-	  set < t_address > add = getDataAddress(vinstr, current.context);
-	  ACS_out.Update(add, accessValue);
-	}
-    }
-}
-
-/*
-   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis provided by inAnalysisName for the context.
-   (inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName )
-*/
-template < typename T > AbstractCache < T > DCacheAnalysis::compute_ACS_out(ContextualNode & current, string & inAnalysisName)
+/* Abstract execution of the loads of a ContextualNode (current) on ACS */
+template < typename T > void DCacheAnalysis::update_ACS(ContextualNode & current, AbstractCache < T > &ACS)
 {
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-  string idCurrentContext = current.context->getStringId();
-  string idAccessName;
-
-  AbstractCacheStateAttribute < T > &ca_attr_in = getACSContextualNode(T, current, inAnalysisName + idCurrentContext);
-  AbstractCache < T > ACS_out = ca_attr_in.cache;
-
-  idAccessName = AnalysisHelper::mkContextAttrName(attributeAccessName, idCurrentContext);
+  string idAccessName = AnalysisHelper::mkContextAttrName(CACAttributeNameData(levelAnalysis), current.context->getStringId());
   vector < Instruction * >vi = current.node->GetAsm();
   for (size_t i = 0; i < vi.size(); i++)
     {
-      compute_ACS_out<T> (current, vi[i], ACS_out, idAccessName); 
-    }
-  return ACS_out;
-}
-
-
-
-/*************************************************************************************************************************
- MUST ANALYSIS
-**************************************************************************************************************************/
-
-//-------------------------------------------------------
-// Initialization of abstract cache for MUST analysis
-//-------------------------------------------------------
-static bool initACSMUST(Cfg * c, Node * n, void *param)
-{
-  DCacheAnalysis *ca = (DCacheAnalysis *) param;
-  AbstractCache < MUST > ACS_empty = ca->CacheFactoryMUST();
-  AbstractCacheStateAttribute < MUST > att(ACS_empty);
-
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-
-  assert(c->HasAttribute(ContextListAttributeName));
-  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
-  for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
-    {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
-    }
-
-  return true;
-}
-
-/* FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > DCacheAnalysis::FixPointMust1stStep_ACS_out(set < ContextualNode > &work, set < Edge * >&backedges)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode(MUST, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
+      if (AnalysisHelper::isLoad(vi[i]))
 	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessorsExcludingBackEdges(current, work_in, backedges);
-	}
-    }
-  return work_in;
-}
-
-/* FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > DCacheAnalysis::FixPointMust1stStep_ACS_in(set < ContextualNode > &work_in, set < Edge * >&backedges)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-  string idAttr;
-  bool b;
-  ContextualNode pred;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  pred = predecessors[i];
-	  b = AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
-	  if (b)
+	  assert(vi[i]->HasAttribute(idAccessName));
+	  string accessValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(idAccessName))).GetValue();
+	  if (accessValue != "N")
 	    {
-	      idAttr = out + pred.context->getStringId();
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in = getACSContextualNode(MUST, pred, idAttr).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join( getACSContextualNode(MUST, pred, idAttr).cache);
-		}
+	      set < t_address > add = getDataAddress(vi[i], current.context);
+	      ACS.Update(add, accessValue);
 	    }
 	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work_out.insert(current);
-	}
     }
-  return work_out;
 }
 
 
-/* First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges.
-   Remarks: Introduced for a precise classification of access performed inside loops.
-   This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis.
-*/
-bool DCacheAnalysis::FixPointMust1stStep()
-{
-  set < ContextualNode > work_in, work;
-
-  AnalysisHelper::applyToAllNodesRecursive(p, initACSMUST, (void *)this);
-  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = FixPointMust1stStep_ACS_out(work, backedges);
-      work.clear();
-      work = FixPointMust1stStep_ACS_in(work_in, backedges);
-      work_in.clear();
-    }
-
-  return true;
-}
-
-/* MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > DCacheAnalysis::MustAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  bool b;
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode( MUST, current, out + current.context->getStringId());
-      b = !ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-      
-      //To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-    }
-  return work_in;
-}
-
-/* MustAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::MustAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  bool b;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in = getACSContextualNode( MUST, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(getACSContextualNode (MUST, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-      b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work_out.insert(current);
-    }
-  return work_out;
-}
-
 
+/*************************************************************************************************************************
+ MUST ANALYSIS
+**************************************************************************************************************************/
 
 /* MUST ANALYSIS.
    Fixed point computation of MUST Abstract Cache States (ACS).
+   The first step does not consider the backedges, for a precise classification of the accesses
+   performed inside loops. This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis.
    All nodes have to be visited at least once. */
 bool DCacheAnalysis::MustAnalysis()
 {
-  set < ContextualNode > work, visited, work_in;
-
-  FixPointMust1stStep();
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      // AnalysisHelper::printSet(work, "DCacheAnalysis"); // debug
-      work_in = MustAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = MustAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
+  must_states = new ACSStore < MUST > ([this] (ContextualNode & cn, AbstractCache < MUST > &acs) { update_ACS < MUST > (cn, acs); },
+				       CacheFactoryMUST(), backedges);
 
+  set < ContextualNode > start = AnalysisHelper::initWork();
+  must_states->fixpoint(start, true);
+  must_states->fixpoint(start, false);
   return true;
 }
 
 //-------------------------------------------------------
 // MUST CHMC classification
 //  Determines if an access can be classified as AH
-//  Removes the MUST analysis attributes
+//  Releases the MUST abstract cache states
 //-------------------------------------------------------
 bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 {
@@ -670,8 +389,7 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  ACSStore < MUST > *states = ca->getMustStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -680,13 +398,13 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName(CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MUST > ca_must = getACSNode(MUST, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      AbstractCache < MUST > ca_must = states->getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      assert(vi[i]->HasAttribute(CACattName));
 	      string accessValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(CACattName))).GetValue();
@@ -708,9 +426,8 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 	    }
 	}
 
-      // Remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
+      // the ACS of the node is no longer needed
+      states->release(cn);
     }
   return true;
 }
@@ -719,94 +436,6 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
  MAY ANALYSIS
 **************************************************************************************************************************/
 
-//-------------------------------------------------------
-// Initialization of abstract cache for MAY analysis
-//-------------------------------------------------------
-bool static initACSMAY(Cfg * c, Node * n, void *param)
-{
-  DCacheAnalysis *ca = (DCacheAnalysis *) param;
-  AbstractCache < MAY > ACS_empty = ca->CacheFactoryMAY();
-  AbstractCacheStateAttribute < MAY > att(ACS_empty);
-
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-
-  assert(c->HasAttribute(ContextListAttributeName));
-  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
-  for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
-    {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
-    }
-
-  return true;
-}
-
-/* MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > DCacheAnalysis::MayAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-
-  set < ContextualNode > work_in;
-
-  //compute ACS_out
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      AbstractCache < MAY > ACS_out = compute_ACS_out < MAY > (current, in);
-      AbstractCacheStateAttribute < MAY > &ca_attr_out =getACSContextualNode(MAY, current, out + current.context->getStringId());
-      bool b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      //To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-
-    }
-  return work_in;
-}
-
-/* MayAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::MayAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  set < ContextualNode > work;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MAY > new_ACS_in =getACSContextualNode (MAY, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(getACSContextualNode(MAY, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MAY > &ca_attr_in =getACSContextualNode ( MAY, current, in + current.context->getStringId());
-      bool b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) { ca_attr_in.cache = new_ACS_in; }
-
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work.insert(current);
-    }
-  return work;
-}
-
 /*
   MAY ANALYSIS.
   Fixed point computation of MAY Abstract Cache States (ACS).
@@ -814,24 +443,18 @@ set < ContextualNode > DCacheAnalysis::MayAnalysis_ACS_in(set < ContextualNode >
 */
 bool DCacheAnalysis::MayAnalysis()
 {
-  set < ContextualNode > visited, work_in, work;
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+  may_states = new ACSStore < MAY > ([this] (ContextualNode & cn, AbstractCache < MAY > &acs) { update_ACS < MAY > (cn, acs); },
+				     CacheFactoryMAY(), backedges);
 
-  AnalysisHelper::applyToAllNodesRecursive(p, initACSMAY, (void *)this);
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = MayAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = MayAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
+  may_states->fixpoint(AnalysisHelper::initWork(), false);
   return true;
 }
 
 //-------------------------------------------------------
 // MAY CHMC classification
 //  Determines if an access can be classified as AM
-//  Removes the MAY analysis attributes
+//  Releases the MAY abstract cache states
 //-------------------------------------------------------
 bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 {
@@ -839,8 +462,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  ACSStore < MAY > *states = ca->getMayStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -849,13 +471,13 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MAY > ca_may = getACSNode(MAY, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      AbstractCache < MAY > ca_may = states->getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      string id = AnalysisHelper::mkContextAttrName( CHMCAttName, currentContext);
 	      if (!vi[i]->HasAttribute(id))	//if the chmc attribute was not set by the MUST or the PS analysis
@@ -881,9 +503,8 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 	    }
 	}
 
-      // Remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
+      // the ACS of the node is no longer needed
+      states->release(cn);
     }
   return true;
 }
@@ -899,7 +520,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 //  set<ContextualNode>: all outer loop's head of the program
 //
 // Remark:
-//  the ACS is attach only in loop or when the
+//  the ACS is computed only in loop or when the
 //  caller point (or transitive) is in a loop
 //-------------------------------------------------------
 
@@ -907,13 +528,9 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 
 set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 {
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  ACSStore < PS > *states = a->getPSStates();
   set < ContextualNode > result;
 
-  AbstractCache < PS > abstractCache = a->CacheFactoryPS();
-  AbstractCacheStateAttribute < PS > ca(abstractCache);
-
   vector < Cfg * >cfgs = p->GetAllCfgs();
 
   for (size_t i = 0; i < cfgs.size(); i++)
@@ -926,16 +543,14 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 	  for (ContextList::const_iterator context_it = contexts.begin(); context_it != contexts.end(); context_it++)
 	    {
 	      Context *context = *context_it;
-	      string context_id = context->getStringId();
 
 	      if (AnalysisHelper::CallerInLoop(context))	//if the current context is called in a loop
 		{
 		  vector < Node * >nodes = cfgs[i]->GetAllNodes();
 		  for (size_t j = 0; j < nodes.size(); j++)
 		    {
-		      // Attach the attribute to all nodes in the cfg.
-		      nodes[j]->SetAttribute(in + context_id, ca);
-		      nodes[j]->SetAttribute(out + context_id, ca);
+		      // All the nodes of the cfg are analysed.
+		      states->addToRegion(ContextualNode(context, nodes[j]));
 		    }
 		}
 	      else
@@ -969,9 +584,8 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 		      vector < Node * >nodes = loopsOuter[j]->GetAllNodes();
 		      for (size_t k = 0; k < nodes.size(); ++k)
 			{
-			  // Attach the attribute to all nodes in the loop.
-			  nodes[k]->SetAttribute(in + context_id, ca);
-			  nodes[k]->SetAttribute(out + context_id, ca);
+			  // All the nodes of the loop are analysed.
+			  states->addToRegion(ContextualNode(context, nodes[k]));
 			}
 		    }
 		}
@@ -981,116 +595,24 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
   return result;
 }
 
-/* PSAnalysis: Compute the ACS_out of a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::PSAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_in;
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < PS > ACS_out = compute_ACS_out < PS > (current, in);
-
-      AbstractCacheStateAttribute < PS > &ca_attr_out = getACSContextualNode(PS, current, out + current.context->getStringId());
-      bool b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      // To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  b = true;
-	  visited.insert(current);
-	}
-
-      if (b)
-	{
-	  vector < ContextualNode > succ = GetContextualSuccessors(current);
-	  for (size_t i = 0; i < succ.size(); i++)
-	    {
-	      // A successor is added only if it is present in the loop
-	      if (succ[i].node->HasAttribute(in + succ[i].context->getStringId())) 
-		{
-		  work_in.insert(succ[i]);
-		}
-	    }
-	}
-    }
-  return work_in;
-}
-
-/* PSAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::PSAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < PS > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  if (predecessors[i].node->HasAttribute(out + predecessors[i].context->getStringId()))
-	    {
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in =getACSContextualNode(PS, predecessors[i], out + predecessors[i].context->getStringId()).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join(getACSContextualNode( PS, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-		}
-	    }
-	}
-
-      AbstractCacheStateAttribute < PS > &ca_attr_in =getACSContextualNode(PS, current, in + current.context->getStringId());
-      bool b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work.insert(current);
-
-    }
-  return work;
-}
-
 /* PS ANALYSIS.
     Fixed point computation of PS Abstract Cache States (ACS).
     All the nodes have to be visited at least once.
 */
 bool DCacheAnalysis::PSAnalysis()
 {
-  set < ContextualNode > work, work_in, visited;
-
-  work = initACSPS(p, this);
-  while (!work.empty())
-    {
-      work_in = PSAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = PSAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+  ps_states = new ACSStore < PS > ([this] (ContextualNode & cn, AbstractCache < PS > &acs) { update_ACS < PS > (cn, acs); },
+				   CacheFactoryPS(), backedges, true);
 
+  ps_states->fixpoint(initACSPS(p, this), false);
   return true;
 }
 
 //-------------------------------------------------------
 // PS CHMC classification
 //  Determines if an access can be classified as FM
-//  Removes the PS analysis attributes
+//  Releases the PS abstract cache states
 //-------------------------------------------------------
 
 //possible improvement:
@@ -1102,8 +624,7 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  ACSStore < PS > *states = ca->getPSStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -1112,14 +633,15 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      if (n->HasAttribute(in + currentContext))
+      ContextualNode cn(*context, n);
+      if (states->inRegion(cn))
 	{
-	  AbstractCache < PS > ca_ps = getACSNode(PS, n, in + currentContext).cache;
+	  AbstractCache < PS > ca_ps = states->getIn(cn);
 
 	  vector < Instruction * >vi = n->GetAsm();
 	  for (size_t i = 0; i < vi.size(); i++)
 	    {
-	      if (Arch::isLoad(vi[i]->GetCode()))
+	      if (AnalysisHelper::isLoad(vi[i]))
 		{
 		  string id=AnalysisHelper::mkContextAttrName( CHMCAttName, currentContext);
 		  if (!vi[i]->HasAttribute(id))	//if the chmc attribute was not set by the MUST analysis
@@ -1145,9 +667,8 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 		}
 	    }
 
-	  //remove the ACS_in and ACS_out attributes
-	  n->RemoveAttribute(in + currentContext);
-	  n->RemoveAttribute(out + currentContext);
+	  // the ACS of the node is no longer needed
+	  states->release(cn);
 	}
     }
   return true;
@@ -1170,7 +691,7 @@ void static ClassifCHMC(Cfg * c, Node * n, string vclassif, string CHMCAttName )
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      if (!vi[i]->HasAttribute(curAttr))	// if not set by the MUST, PS or MAY analysis
 		{
@@ -1224,7 +745,7 @@ bool static ClassifCACNext(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::isLoad(vi[i]))
 	    {
 	      assert(vi[i]->HasAttribute(cur_CHMCAttName));
 	      string chmcValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(cur_CHMCAttName))).GetValue();
@@ -1263,10 +784,14 @@ bool DCacheAnalysis::PerformAnalysis()
       Timer timer_must;
       timer_must.initTimer();
       MustAnalysis();
+      size_t nbstates = must_states->size();
+      must_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+      delete must_states;
+      must_states = NULL;
       timer_must.addTimer(time);
       stringstream infostr;
-      infostr << "DcacheAnalysis: MUST done: " << time;
+      infostr << "DcacheAnalysis: MUST done: " << time << " (" << nbstates << " ACS kept)";
       Logger::addInfo(infostr.str());
     }
   //------------------------
@@ -1278,7 +803,10 @@ bool DCacheAnalysis::PerformAnalysis()
       Timer timer_ps;
       timer_ps.initTimer();
       PSAnalysis();
+      ps_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+      delete ps_states;
+      ps_states = NULL;
       timer_ps.addTimer(time);
       stringstream infostr;
       infostr << "DcacheAnalysis: PS done: " << time;
@@ -1293,12 +821,17 @@ bool DCacheAnalysis::PerformAnalysis()
       Timer timer_may;
       timer_may.initTimer();
       MayAnalysis();
+      may_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+      delete may_states;
+      may_states = NULL;
       timer_may.addTimer(time);
       stringstream infostr;
       infostr << "DcacheAnalysis: MAY done: " << time;
       Logger::addInfo(infostr.str());
     }
+  // No abstract cache is left: the canonical cache sets of this thread are no longer needed
+  ClearCacheSetTables();
 
   if (perfectDcache)
     AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCAH, (void *)this); // AH classification
@@ -1365,6 +898,9 @@ bool DCacheAnalysis::CheckInputAttributes()
   cacheline_size = cachelinesize;
   replacement_policy = r;
   levelAnalysis = levelCache;
+  must_states = NULL;
+  may_states = NULL;
+  ps_states = NULL;
 
   if (perfectDcache)
     {
@@ -1434,4 +970,23 @@ void DCacheAnalysis::RemovePrivateAttributes()
   AnalysisHelper::applyToAllNodesRecursive(p, CleanupNodeInternalAttributes, NULL);
 }
 
+//------------------------------------------------
+// Attributes read and written: the data addresses, the CAC of the level (L1: computed here),
+// the CHMC and block counts of the level, the CAC of the next level
+//------------------------------------------------
+void DCacheAnalysis::GetAttributeDependencies(set < string > &reads, set < string > &writes)
+{
+  reads.insert(ContextListAttributeName);
+  reads.insert(ContextTreeAttributeName);
+  reads.insert(CodeAddressSlot);
+  reads.insert(DataAddressSlot);
+  if (levelAnalysis == 1)
+    writes.insert(CACAttributeNameData(1) + "*");
+  else
+    reads.insert(CACAttributeNameData(levelAnalysis) + "*");
+  writes.insert(CHMCAttributeNameData(levelAnalysis) + "*");
+  writes.insert(CACAttributeNameData(levelAnalysis + 1) + "*");
+  writes.insert(BlockCountAttributeName(levelAnalysis) + "*");
+}
+
 
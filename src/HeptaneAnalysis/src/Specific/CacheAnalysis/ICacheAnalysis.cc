@@ -26,11 +26,6 @@ See CREDITS.txt for credits of authorship
 #include "Generic/Timer.h"
 
 
-// inlines...
-#define getACSNode(T, NODE, IDATTR) ((AbstractCacheStateAttribute < T > &)NODE->GetAttribute(IDATTR))
-#define getACSContextualNode(T, ELEM, IDATTR) getACSNode(T, ELEM.node,IDATTR)
-
-
 /*************************************************************************************************************************
  CacheFactory functions
 **************************************************************************************************************************/
@@ -38,99 +33,21 @@ See CREDITS.txt for credits of authorship
 /**   Returns an empty Must cache */
 AbstractCache < MUST > ICacheAnalysis::CacheFactoryMUST() const
 {
-  // default initialization (LRU)
-  unsigned int nb_ways_analysis = nb_ways;
-  unsigned int nb_ways_removed = 0;
-
-  // Compute length of ACS for Must analysis depending on the replacement policy
-  switch (replacement_policy)
-    {
-    case LRU:
-      nb_ways_analysis = nb_ways;
-      nb_ways_removed = 0;
-      break;
-    case PLRU:
-      if (nb_ways == 1)
-	{
-	  nb_ways_analysis = 1;
-	}
-      else
-	{
-	  double n = log((double)nb_ways) / log(2.0) + 1;
-	  nb_ways_analysis = static_cast < unsigned int >(n);
-	}
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case MRU:
-      nb_ways_analysis = (nb_ways == 1) ? 1 : 2;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case FIFO:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case RANDOM:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    default:
-      stringstream errorstr;
-      errorstr << "ICacheAnalysis: invalid replacement policy";
-      Logger::addFatal(errorstr.str());
-    }
-
-  return AbstractCache < MUST > (nb_sets, nb_ways_analysis, nb_ways_removed, cacheline_size);
+  // The abstract cache sets derive the guaranteed number of ways from the replacement policy
+  return AbstractCache < MUST > (nb_sets, nb_ways, replacement_policy, cacheline_size);
 }
 
 /* Returns an empty PS cache */
 AbstractCache < PS > ICacheAnalysis::CacheFactoryPS() const
 {
-  // default initialization (LRU)
-  unsigned int nb_ways_analysis = nb_ways;
-  unsigned int nb_ways_removed = 0;
-
-  // Compute length of ACS for PS analysis depending on the replacement policy
-  switch (replacement_policy)
-    {
-    case LRU:
-      nb_ways_analysis = nb_ways;
-      nb_ways_removed = 0;
-      break;
-    case PLRU:
-      if (nb_ways == 1)
-	{
-	  nb_ways_analysis = 1;
-	}
-      else
-	{
-	  double n = log((double)nb_ways) / log((double)2) + 1;
-	  nb_ways_analysis = static_cast < unsigned int >(n);
-	}
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case MRU:
-      nb_ways_analysis = (nb_ways == 1) ? 1 : 2;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case FIFO:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    case RANDOM:
-      nb_ways_analysis = 1;
-      nb_ways_removed = nb_ways - nb_ways_analysis;
-      break;
-    default:
-      stringstream errorstr;
-      errorstr << "ICacheAnalysis: invalid replacement policy";
-      Logger::addFatal(errorstr.str());
-    }
-
-  return AbstractCache < PS > (nb_sets, nb_ways_analysis, nb_ways_removed, cacheline_size);
+  // The abstract cache sets derive the guaranteed number of ways from the replacement policy
+  return AbstractCache < PS > (nb_sets, nb_ways, replacement_policy, cacheline_size);
 }
 
 /* Build an empty May cache */
-/* TODO: implementation of an infinite ACS for the PLRU and RANDOM May analysis (check MLS/Evict bound)*/
+/* No MAY analysis for PLRU with more than 2 ways: interleaving hits on lines
+   accessed after x, x may survive any number of distinct accesses (no evict
+   bound). No MAY analysis for RANDOM either. */
 AbstractCache < MAY > ICacheAnalysis::CacheFactoryMAY() const
 {
   // default initialization (LRU)
@@ -231,37 +148,21 @@ static bool initL1AccessAttributeForInstruction(Cfg * c, Node * n, void *param)
 }
 
 
-template < typename T > void ICacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName)
-{
-  assert(vinstr->HasAttribute(idAccessName));
-  string accessValue = ((SerialisableStringAttribute &) (vinstr->GetAttribute(idAccessName))).GetValue();
-  if (accessValue != "N")
-    {
-      t_address add = getInstrAddress(vinstr);
-      ACS_out.Update(add, accessValue);
-    }
-}
-
-/*
-   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis provided by inAnalysisName for the context.
-   (inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName )
-*/
-template<typename T> AbstractCache < T > ICacheAnalysis::compute_ACS_out(ContextualNode &current, string &inAnalysisName)
+/* Abstract execution of the accesses of the instructions of a ContextualNode (current) on ACS */
+template < typename T > void ICacheAnalysis::update_ACS(ContextualNode & current, AbstractCache < T > &ACS)
 {
-  string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string idCurrentContext = current.context->getStringId ();
-  string idAccessName;
-
-  AbstractCacheStateAttribute < T > &ca_attr_in = getACSContextualNode( T, current, inAnalysisName + idCurrentContext);
-  AbstractCache < T > ACS_out = ca_attr_in.cache;
-
-  idAccessName = AnalysisHelper::mkContextAttrName( attributeAccessName, idCurrentContext);
+  string idAccessName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(levelAnalysis), current.context->getStringId ());
   vector < Instruction * >vi = current.node->GetAsm();
   for (size_t i = 0; i < vi.size(); i++)
     {
-      compute_ACS_out<T> (current, vi[i], ACS_out, idAccessName); 
+      assert(vi[i]->HasAttribute(idAccessName));
+      string accessValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(idAccessName))).GetValue();
+      if (accessValue != "N")
+	{
+	  t_address add = getInstrAddress(vi[i]);
+	  ACS.Update(add, accessValue);
+	}
     }
-  return ACS_out;
 }
 
 
@@ -269,214 +170,28 @@ template<typename T> AbstractCache < T > ICacheAnalysis::compute_ACS_out(Context
                 MUST ANALYSIS
  **************************************************************************************************************************/
 
-//-------------------------------------------------------
-// Initialization of abstract cache for MUST analysis
-//-------------------------------------------------------
-static bool initACSMUST(Cfg * c, Node * n, void *param)
-{
-  ICacheAnalysis *ca = (ICacheAnalysis *) param;
-  AbstractCache < MUST > ACS_empty = ca->CacheFactoryMUST();
-  AbstractCacheStateAttribute < MUST > att(ACS_empty);
-
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-
-  assert(c->HasAttribute(ContextListAttributeName));
-  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
-  for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
-    {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
-    }
-
-  return true;
-}
-
-/* FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > ICacheAnalysis::FixPointMust1stStep_ACS_out(set < ContextualNode >&work, set < Edge * >& backedges )
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MUST > ACS_out= compute_ACS_out<MUST>( current, in);
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode( MUST, current, out + current.context->getStringId());
-      if (! ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessorsExcludingBackEdges(current, work_in, backedges);
-	}
-    }
-  return work_in;
-}
-
-/* FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > ICacheAnalysis::FixPointMust1stStep_ACS_in(set < ContextualNode >&work_in, set < Edge * >& backedges )
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work;
-  string idAttr;
-  bool b;
-  ContextualNode pred;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  pred = predecessors[i];
-	  b = AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
-	  if (b)
-	    {
-	      idAttr = out + pred.context->getStringId();
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in = getACSContextualNode(MUST, pred, idAttr).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join(getACSContextualNode(MUST, pred, idAttr).cache); 
-		}
-	    }
-	}
-      idAttr = in + current.context->getStringId();
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, idAttr);
-
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work.insert(current);
-	}
-    }
-  return work;
-}
-
-
-/* 
-   MUST ANALYSIS
-   First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges.
-   
-   Remarks: Introduces for a precise classification of access performed inside loops.
-   This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis
-*/
-bool ICacheAnalysis::FixPointMust1stStep()
-{
-  set < ContextualNode > work, work_in;
-
-  AnalysisHelper::applyToAllNodesRecursive(p, initACSMUST, (void *)this);
-  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
-
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = FixPointMust1stStep_ACS_out(work, backedges);
-      work.clear();
-      work = FixPointMust1stStep_ACS_in(work_in, backedges);
-      work_in.clear();
-    }
-  return true;
-}
-
-/* MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > ICacheAnalysis::MustAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  bool b;
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      // cout << " ICacheAnalysis::MustAnalysis_ACS_out, Current context = " << getStringContextRepresentation(current.getContext()) << endl;
-
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode(MUST, current, out + current.context->getStringId());
-      b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-    }
-  return work_in;
-}
-
-/* MustAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > ICacheAnalysis::MustAnalysis_ACS_in(set < ContextualNode > & work_in, set < ContextualNode > &visited)
-{
-  bool b;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in = getACSContextualNode(MUST, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(  getACSContextualNode(MUST, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-      b = !ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-      b = ( b || (visited.find(current) == visited.end()));
-      if (b) work_out.insert(current);
-    }
-  return work_out;
-}
-
-
 /* MUST ANALYSIS.
    Fixed point computation of MUST Abstract Cache States (ACS).
+   The first step does not consider the backedges, for a precise classification of the accesses
+   performed inside loops. This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis.
    Remarks:All nodes have to be visited at least once.
 */
 bool ICacheAnalysis::MustAnalysis()
 {
-  set < ContextualNode > visited, work, work_in;
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
+  must_states = new ACSStore < MUST > ([this] (ContextualNode & cn, AbstractCache < MUST > &acs) { update_ACS < MUST > (cn, acs); },
+				       CacheFactoryMUST(), backedges);
 
-  FixPointMust1stStep();
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = MustAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = MustAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
+  set < ContextualNode > start = AnalysisHelper::initWork();
+  must_states->fixpoint(start, true);
+  must_states->fixpoint(start, false);
   return true;
 }
 
 //-------------------------------------------------------
 // MUST CHMC classification
 //  Determines if an access can be classified as AH
-//  Removes the MUST analysis attributes
+//  Releases the MUST abstract cache states
 //-------------------------------------------------------
 bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 {
@@ -484,8 +199,7 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  ACSStore < MUST > *states = ca->getMustStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -494,8 +208,8 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MUST > ca_must = getACSNode(MUST, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      AbstractCache < MUST > ca_must = states->getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
@@ -527,9 +241,8 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 	    }
 	}
 
-      //remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
+      // the ACS of the node is no longer needed
+      states->release(cn);
     }
   return true;
 }
@@ -537,110 +250,23 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 /*************************************************************************************************************************
                 MAY ANALYSIS
 **************************************************************************************************************************/
-//-------------------------------------------------------
-// Initialization of abstract cache for MAY analysis
-//-------------------------------------------------------
-bool static initACSMAY(Cfg * c, Node * n, void *param)
-{
-  ICacheAnalysis *ca = (ICacheAnalysis *) param;
-  AbstractCache < MAY > ACS_empty = ca->CacheFactoryMAY();
-  AbstractCacheStateAttribute < MAY > att(ACS_empty);
-
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-
-  assert(c->HasAttribute(ContextListAttributeName));
-  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
-  for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
-    {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
-    }
-
-  return true;
-}
-
-/* MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed.*/
-set < ContextualNode >ICacheAnalysis::MayAnalysis_ACS_out(set < ContextualNode > &work)
-{
-  // string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  set < ContextualNode > work_in;
-  
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MAY > ACS_out = compute_ACS_out<MAY>(current, in);
-      AbstractCacheStateAttribute < MAY > &ca_attr_out = getACSContextualNode(MAY, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessors(current, work_in);
-	}
-    } 
-  return work_in;
-}
-
-/* MayAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed.*/
-set < ContextualNode > ICacheAnalysis::MayAnalysis_ACS_in(set < ContextualNode > &work_in)
-{
-  //-- string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-
- set < ContextualNode > work;
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-      
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-      
-      AbstractCache < MAY > new_ACS_in = getACSContextualNode( MAY, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join( getACSContextualNode(MAY, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-      
-      AbstractCacheStateAttribute < MAY > &ca_attr_in = getACSContextualNode(MAY, current, in + current.context->getStringId());
-      
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work.insert(current);
-	}
-    }
-  return work;
-}
-
 /* MAY ANALYSIS.
    Fixed point computation of MAY Abstract Cache States (ACS).
  */
 bool ICacheAnalysis::MayAnalysis()
 {
-  set < ContextualNode > work, work_in;
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+  may_states = new ACSStore < MAY > ([this] (ContextualNode & cn, AbstractCache < MAY > &acs) { update_ACS < MAY > (cn, acs); },
+				     CacheFactoryMAY(), backedges);
 
-  AnalysisHelper::applyToAllNodesRecursive(p, initACSMAY, (void *)this);
-
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = MayAnalysis_ACS_out(work);
-      work.clear();
-      work = MayAnalysis_ACS_in(work_in);
-      work_in.clear();
-    }
+  may_states->fixpoint(AnalysisHelper::initWork(), false);
   return true;
 }
 
 //-------------------------------------------------------
 // MAY CHMC classification
 //  Determines if an access can be classified as AM
-//  Removes the MAY analysis attributes
+//  Releases the MAY abstract cache states
 //-------------------------------------------------------
 bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 {
@@ -648,8 +274,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  ACSStore < MAY > *states = ca->getMayStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -658,8 +283,8 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MAY > ca_may = getACSNode(MAY, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      AbstractCache < MAY > ca_may = states->getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
@@ -687,9 +312,8 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 	    }
 	}
 
-      //remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
+      // the ACS of the node is no longer needed
+      states->release(cn);
     }
   return true;
 }
@@ -705,7 +329,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 //  set<ContextualNode>: all outer loop's head of the program
 //
 // Remark:
-//  the ACS is attach only in loop or when the
+//  the ACS is computed only in loop or when the
 //  caller point (or transitive) is in a loop
 //-------------------------------------------------------
 
@@ -713,14 +337,9 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 
 set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 {
-  string in = ACSPSInName;
-  string out = ACSPSOutName;  
-
+  ACSStore < PS > *states = a->getPSStates();
   set < ContextualNode > result;
 
-  AbstractCache < PS > abstractCache = a->CacheFactoryPS();
-  AbstractCacheStateAttribute < PS > ca(abstractCache);
-
   vector < Cfg * >cfgs = p->GetAllCfgs();
 
   for (size_t i = 0; i < cfgs.size(); i++)
@@ -733,16 +352,14 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 	  for (ContextList::const_iterator context_it = contexts.begin(); context_it != contexts.end(); context_it++)
 	    {
 	      Context *context = *context_it;
-	      string context_id = context->getStringId();
 
 	      if (AnalysisHelper::CallerInLoop(context)) // if the current context is called in a loop
 		{
 		  vector < Node * >nodes = cfgs[i]->GetAllNodes();
 		  for (size_t j = 0; j < nodes.size(); j++)
 		    {
-		      // Attach the attribute to all nodes in the cfg.
-		      nodes[j]->SetAttribute(in + context_id, ca);
-		      nodes[j]->SetAttribute(out + context_id, ca);
+		      // All the nodes of the cfg are analysed.
+		      states->addToRegion(ContextualNode(context, nodes[j]));
 		    }
 		}
 	      else
@@ -776,9 +393,8 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 		      vector < Node * >nodes = loopsOuter[j]->GetAllNodes();
 		      for (size_t k = 0; k < nodes.size(); ++k)
 			{
-			  // Attach the attribute to all nodes in the loop.
-			  nodes[k]->SetAttribute(in + context_id, ca);
-			  nodes[k]->SetAttribute(out + context_id, ca);
+			  // All the nodes of the loop are analysed.
+			  states->addToRegion(ContextualNode(context, nodes[k]));
 			}
 		    }
 		}
@@ -788,107 +404,23 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
   return result;
 }
 
-/* PSAnalysis: Compute the ACS_out of a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > ICacheAnalysis::PSAnalysis_ACS_out(set < ContextualNode >&work)
-{
-  string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_in;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < PS > ACS_out = compute_ACS_out<PS>(current, in);
-
-      AbstractCacheStateAttribute < PS > &ca_attr_out = getACSContextualNode(PS, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-
-	  vector < ContextualNode > succ = GetContextualSuccessors(current);
-	  for (size_t i = 0; i < succ.size(); i++)
-	    {
-	      // A successor is added only if it is present in the loop
-	      if (succ[i].node->HasAttribute(in + succ[i].context->getStringId()))
-		{
-		  work_in.insert(succ[i]);
-		}
-	    }
-	}
-    }
-  return work_in;
-}
-
-/* PSAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > ICacheAnalysis::PSAnalysis_ACS_in(set < ContextualNode >&work_in)
-{
-  //-- string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_out;
-  string id;
-
-   for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-	{
-	  ContextualNode current = *it;
-
-	  const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-	  assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-	  AbstractCache < PS > new_ACS_in;
-	  bool first = true;
-	  for (size_t i = 0; i < predecessors.size(); i++)
-	    {
-	      id = out + predecessors[i].context->getStringId();
-	      if (predecessors[i].node->HasAttribute(id))
-		{
-		  if (first)
-		    {
-		      first = false;
-		      new_ACS_in = getACSContextualNode(PS, predecessors[i], id).cache;
-		    }
-		  else
-		    {
-		      new_ACS_in.Join( getACSContextualNode( PS, predecessors[i], id).cache);
-		    }
-		}
-	    }
-
-	  AbstractCacheStateAttribute < PS > &ca_attr_in = getACSContextualNode(PS, current, in + current.context->getStringId());
-	  if (!ca_attr_in.cache.Equals(new_ACS_in))
-	    {
-	      ca_attr_in.cache = new_ACS_in;
-	      work_out.insert(current);
-	    }
-	} 
-   return work_out;
-}
-
 /*  PS ANALYSIS.
     Fixed point computation of PS Abstract Cache States (ACS).
 */
 bool ICacheAnalysis::PSAnalysis()
 {
-  set < ContextualNode > work, work_in;
-
-  work = initACSPS(p, this);
-  while (!work.empty())
-    {
-      work_in = PSAnalysis_ACS_out(work);
-      work.clear();
-      work = PSAnalysis_ACS_in(work_in);
-      work_in.clear();
-    }
+  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+  ps_states = new ACSStore < PS > ([this] (ContextualNode & cn, AbstractCache < PS > &acs) { update_ACS < PS > (cn, acs); },
+				   CacheFactoryPS(), backedges, true);
 
+  ps_states->fixpoint(initACSPS(p, this), false);
   return true;
 }
 
 //-------------------------------------------------------
 // PS CHMC classification
 //  Determines if an access can be classified as FM
-//  Removes the PS analysis attributes
+//  Releases the PS abstract cache states
 //-------------------------------------------------------
 bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 {
@@ -896,8 +428,7 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  ACSStore < PS > *states = ca->getPSStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -906,9 +437,10 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
       
-      if (n->HasAttribute(in + currentContext))
+      ContextualNode cn(*context, n);
+      if (states->inRegion(cn))
 	{
-	  AbstractCache < PS > ca_ps = getACSNode(PS, n, in + currentContext).cache;
+	  AbstractCache < PS > ca_ps = states->getIn(cn);
 
 	  vector < Instruction * >vi = n->GetAsm();
 	  for (size_t i = 0; i < vi.size(); i++)
@@ -944,9 +476,8 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 		}
 	    }
 
-	  //remove the ACS_in and ACS_out attributes
-	  n->RemoveAttribute(in + currentContext);
-	  n->RemoveAttribute(out + currentContext);
+	  // the ACS of the node is no longer needed
+	  states->release(cn);
 	}
     }
   return true;
@@ -1058,10 +589,14 @@ bool ICacheAnalysis::PerformAnalysis()
       Timer timer_must;
       timer_must.initTimer();
       MustAnalysis();
+      size_t nbstates = must_states->size();
+      must_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+      delete must_states;
+      must_states = NULL;
       timer_must.addTimer(time);
       stringstream infostr;
-      infostr << "ICacheAnalysis: MUST done: " << time;
+      infostr << "ICacheAnalysis: MUST done: " << time << " (" << nbstates << " ACS kept)";
       Logger::addInfo(infostr.str());
     }
   //------------------------
@@ -1073,7 +608,10 @@ bool ICacheAnalysis::PerformAnalysis()
       Timer timer_ps;
       timer_ps.initTimer();
       PSAnalysis();
+      ps_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+      delete ps_states;
+      ps_states = NULL;
       timer_ps.addTimer(time);
       stringstream infostr;
       infostr << "ICacheAnalysis: PS done: " << time;
@@ -1088,12 +626,17 @@ bool ICacheAnalysis::PerformAnalysis()
       Timer timer_may;
       timer_may.initTimer();
       MayAnalysis();
+      may_states->prepareClassification(p);
       AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+      delete may_states;
+      may_states = NULL;
       timer_may.addTimer(time);
       stringstream infostr;
       infostr << "ICacheAnalysis: MAY done: " << time;
       Logger::addInfo(infostr.str());
     }
+  // No abstract cache is left: the canonical cache sets of this thread are no longer needed
+  ClearCacheSetTables();
   
   if (perfectIcache) 
     AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCAH, (void *)this); // AH classification
@@ -1140,6 +683,9 @@ ICacheAnalysis::ICacheAnalysis(Program * p, int nbsets, int nbways, int cachelin
   cacheline_size = cachelinesize;
   replacement_policy = r;
   levelAnalysis = levelCache;
+  must_states = NULL;
+  may_states = NULL;
+  ps_states = NULL;
 
   if (perfectIcache)
     {
@@ -1215,6 +761,24 @@ void ICacheAnalysis::RemovePrivateAttributes()
   AnalysisHelper::applyToAllNodesRecursive(p, CleanupNodeInternalAttributes, NULL);
 }
 
+//------------------------------------------------
+// Attributes read and written: the CAC of the level (L1: computed here),
+// the CHMC and AGE of the level, the CAC of the next level
+//------------------------------------------------
+void ICacheAnalysis::GetAttributeDependencies(set < string > &reads, set < string > &writes)
+{
+  reads.insert(ContextListAttributeName);
+  reads.insert(ContextTreeAttributeName);
+  reads.insert(CodeAddressSlot);
+  if (levelAnalysis == 1)
+    writes.insert(CACAttributeNameCode(1) + "*");
+  else
+    reads.insert(CACAttributeNameCode(levelAnalysis) + "*");
+  writes.insert(CHMCAttributeNameCode(levelAnalysis) + "*");
+  writes.insert(CACAttributeNameCode(levelAnalysis + 1) + "*");
+  writes.insert(string(AGEAttributeName) + "L" + to_string(levelAnalysis) + "Code*");
+}
+
 
 
 
@@ -88,8 +88,10 @@ private:
   /** Program call graph (used for detection of dead code to speed up the analysis). */
   CallGraph *call_graph;
 
-  /** First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges. */
-  bool FixPointMust1stStep ();
+  /** Abstract cache states of the fixed points, kept until the classification */
+  ACSStore < MUST > *must_states;
+  ACSStore < MAY > *may_states;
+  ACSStore < PS > *ps_states;
 
   /** Fixed point computation of MUST Abstract Cache States (ACS). */
   bool MustAnalysis ();
@@ -100,46 +102,8 @@ private:
   /** Fixed point computation of PS Abstract Cache States (ACS). */
   bool PSAnalysis ();
 
-
-  template < typename T > void compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName);
-
-  /** @return the ACS_out, for an analysis T, of a ContextualNode (current). 
-      The initial ACS_out is the ACS_in of the current analysis (given by the attribute inAnalysisName in the context of current).
-      Then the ACS_out is updated for each Load instructions of the node.
-      Remark: inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName. */
-  template<typename T> AbstractCache < T > compute_ACS_out(ContextualNode &current, string &inAnalysisName);
-
-  /** FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-      @return a set of nodes for which the ACS_in must be computed. */
-  set < ContextualNode > FixPointMust1stStep_ACS_out(set < ContextualNode >&work_in, set < Edge * >& backedges );
-
-  /** FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-      @return a set of nodes for which the ACS_out must be computed. */
-  set < ContextualNode > FixPointMust1stStep_ACS_in(set < ContextualNode >&work, set < Edge * >& backedges );
-
-  /** MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MustAnalysis_ACS_out(set < ContextualNode >&work, set < ContextualNode > &visited);
-
-  /** MustAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MustAnalysis_ACS_in(set < ContextualNode >&work_in, set < ContextualNode > &visited);
-
-  /** MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MayAnalysis_ACS_out(set < ContextualNode > &work);
-
-  /** MayAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MayAnalysis_ACS_in(set < ContextualNode > &work_in);
-
-  /** PSAnalysis: Compute the ACS_out of a set of nodes (work).
-       @return a set of nodes for which the ACS_in must be computed. */
-  set < ContextualNode > PSAnalysis_ACS_out(set < ContextualNode >&work);
-
-  /** PSAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed. */
-  set < ContextualNode > PSAnalysis_ACS_in(set < ContextualNode >&work_in);
+  /** Updates ACS, for an analysis T, with the accesses of the instructions of a ContextualNode (current). */
+  template < typename T > void update_ACS(ContextualNode & current, AbstractCache < T > &ACS);
 
 public:
 
@@ -172,6 +136,9 @@ public:
    /** Remove all private attributes*/
    void RemovePrivateAttributes ();   
 
+   /** Attribute slots read and written by the analysis (see Analysis::GetAttributeDependencies) */
+   void GetAttributeDependencies (set < string > &reads, set < string > &writes);
+
   /** Accessors */
   int getNbSets () const
   {
@@ -193,6 +160,21 @@ public:
     return levelAnalysis;
   };
 
+  ACSStore < MUST > *getMustStates () const
+  {
+    return must_states;
+  };
+
+  ACSStore < MAY > *getMayStates () const
+  {
+    return may_states;
+  };
+
+  ACSStore < PS > *getPSStates () const
+  {
+    return ps_states;
+  };
+
   t_replacement_policy getReplacementPolicy () const
   {
     return replacement_policy;
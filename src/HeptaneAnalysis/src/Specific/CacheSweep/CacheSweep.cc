@@ -0,0 +1,259 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "Specific/CacheSweep/CacheSweep.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "Generic/Timer.h"
+
+// ----------------------
+// CacheSweep class
+// ----------------------
+
+CacheSweep::CacheSweep(Program * p, const vector < vector < CacheParam * > > &vpoints, const ListXmlTag & analyses, int vnbthreads, string vtable_file):Analysis(p)
+{
+  points = vpoints;
+  nbthreads = vnbthreads;
+  table_file = vtable_file;
+  next_point = 0;
+  clone_time = analysis_time = 0;
+  base_config = config;
+
+  // Parameters of the swept analyses, read once for all the design points
+  for (unsigned int i = 0; i < analyses.size(); i++)
+    {
+      string name = analyses[i].getName();
+      analysis_names.push_back(name);
+      analysis_params.push_back(config->getParameters(name, config->input_output_dir, analyses[i]));
+    }
+}
+
+CacheSweep::~CacheSweep()
+{
+  for (unsigned int i = 0; i < analysis_params.size(); i++)
+    delete analysis_params[i];
+  for (unsigned int i = 0; i < point_configs.size(); i++)
+    delete point_configs[i];
+}
+
+// ----------------------------------------------------------------
+// Checks if all required attributes are in the CFG
+// Returns true if successful, false otherwise
+// Here, the contexts shared by all the design points
+// ----------------------------------------------------------------
+bool CacheSweep::CheckInputAttributes()
+{
+  Cfg *c = p->GetEntryPoint();
+  if (c == NULL || !c->HasAttribute(ContextListAttributeName))
+    {
+      Logger::addError("CacheSweep: the contexts of the program entry point should be computed");
+      return false;
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Analysis of the design point of index i.
+// The analyses are applied to a clone of the program, the
+// configuration of the design point being the one of the
+// current thread during the analyses.
+// Returns the WCET of the design point.
+// ----------------------------------------------------------------
+string CacheSweep::analysePoint(unsigned int i)
+{
+  Config *pc = point_configs[i];
+  Timer timer;
+  float time = 0;
+  {
+    lock_guard < mutex > lock(sweep_mutex);
+    timer.initTimer();
+    pc->p = p->Clone();
+    timer.addTimer(clone_time);
+  }
+  config = pc;
+
+  timer.initTimer();
+  for (unsigned int a = 0; a < analysis_names.size(); a++)
+    {
+      Analysis *an = pc->mkAnalyzerObject(analysis_names[a], pc->p, analysis_params[a]);
+      assert(an != NULL);
+      an->setName(analysis_names[a]);
+      if (!an->CheckPerformCleanup(false))
+	Logger::addFatal("CacheSweep: call to analysis " + analysis_names[a] + " failed");
+      delete an;
+    }
+
+  // Retrieve the WCET, attached to the program entry point
+  string wcet = "-1";
+  Cfg *c = pc->p->GetEntryPoint();
+  if (c->HasAttribute(WCETAttributeName))
+    {
+      Attribute & attr = c->GetAttribute(WCETAttributeName);
+      SerialisableStringAttribute *sa = dynamic_cast < SerialisableStringAttribute * >(&attr);
+      if (sa != NULL)
+	wcet = sa->GetValue();
+      else
+	wcet = to_string(((ExternalWCETAttributeNameType &) attr).GetValue());
+    }
+
+  timer.addTimer(time);
+
+  config = base_config;
+  {
+    lock_guard < mutex > lock(sweep_mutex);
+    analysis_time += time;
+    timer.initTimer();
+    delete pc->p;
+    pc->p = NULL;
+    timer.addTimer(clone_time);
+  }
+  return wcet;
+}
+
+void CacheSweep::worker()
+{
+  while (true)
+    {
+      unsigned int i;
+      {
+	lock_guard < mutex > lock(sweep_mutex);
+	if (next_point >= points.size())
+	  return;
+	i = next_point++;
+      }
+      wcets[i] = analysePoint(i);
+    }
+}
+
+// ----------------------------------------------
+// Performs the analysis
+// Returns true if successful, false otherwise
+// ----------------------------------------------
+bool CacheSweep::PerformAnalysis()
+{
+  // One configuration per design point, built (and checked) before starting the workers.
+  // The memory latencies and target are the ones of the ARCHITECTURE section.
+  for (unsigned int i = 0; i < points.size(); i++)
+    {
+      Config *pc = new Config(*base_config);
+      pc->cache_params.clear();
+      pc->nb_icache_levels = pc->nb_dcache_levels = 0;
+      pc->perfectIcache = pc->perfectDcache = false;
+      for (unsigned int c = 0; c < points[i].size(); c++)
+	pc->addCache(points[i][c]);
+      pc->checkCacheHierarchy();
+      pc->initParameters();
+      point_configs.push_back(pc);
+    }
+
+  wcets.assign(points.size(), "-1");
+  next_point = 0;
+  unsigned int n = nbthreads;
+  if (n > points.size())
+    n = points.size();
+
+  if (n <= 1)
+    worker();
+  else
+    {
+      vector < thread > workers;
+      for (unsigned int t = 0; t < n; t++)
+	workers.push_back(thread(&CacheSweep::worker, this));
+      for (unsigned int t = 0; t < n; t++)
+	workers[t].join();
+    }
+
+  stringstream infostr;
+  infostr << "CacheSweep: " << points.size() << " design points analysed (" << n << " threads), table in " << table_file
+	  << ", clones: " << clone_time << " s, analyses: " << analysis_time << " s (summed over the threads)";
+  Logger::addInfo(infostr.str());
+  return writeTable();
+}
+
+static string policyName(t_replacement_policy rp)
+{
+  switch (rp)
+    {
+    case LRU: return "LRU";
+    case PLRU: return "PLRU";
+    case RANDOM: return "RANDOM";
+    case FIFO: return "FIFO";
+    case MRU: return "MRU";
+    case RR: return "RR";
+    case PSEUDO_RR: return "PSEUDO_RR";
+    default: return "UNKNOWN";
+    }
+}
+
+// ----------------------------------------------------------------
+// WCET-vs-configuration table: one line per design point,
+// tab separated, with the parameters of every cache followed
+// by the WCET. Caches are named after their type and level
+// (e.g. icache1).
+// ----------------------------------------------------------------
+bool CacheSweep::writeTable()
+{
+  ofstream os(table_file.c_str());
+  if (!os.is_open())
+    {
+      Logger::addError("CacheSweep: cannot open " + table_file);
+      return false;
+    }
+
+  // Header, from the first point (all the points have the same caches)
+  os << "#point";
+  for (unsigned int c = 0; c < points[0].size(); c++)
+    {
+      CacheParam *cp = points[0][c];
+      string type = (cp->type == ICACHE) ? "icache" : (cp->type == DCACHE) ? "dcache" : (cp->type == PERFECTICACHE) ? "picache" : "pdcache";
+      string name = type + to_string(cp->level);
+      if (cp->type == ICACHE || cp->type == DCACHE)
+	os << "\t" << name << ".nbsets\t" << name << ".nbways\t" << name << ".cachelinesize\t" << name << ".replacement_policy";
+      os << "\t" << name << ".latency";
+    }
+  os << "\tWCET" << endl;
+
+  for (unsigned int i = 0; i < points.size(); i++)
+    {
+      os << i;
+      for (unsigned int c = 0; c < points[i].size(); c++)
+	{
+	  CacheParam *cp = points[i][c];
+	  if (cp->type == ICACHE || cp->type == DCACHE)
+	    os << "\t" << cp->nbsets << "\t" << cp->nbways << "\t" << cp->cachelinesize << "\t" << policyName(cp->replacement_policy);
+	  os << "\t" << cp->latency;
+	}
+      os << "\t" << wcets[i] << endl;
+    }
+  os.close();
+  return true;
+}
+
+/* Remove all private attributes */
+void CacheSweep::RemovePrivateAttributes()
+{
+}
@@ -0,0 +1,112 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef CACHE_SWEEP_H
+#define CACHE_SWEEP_H
+
+#include <mutex>
+#include "Analysis.h"
+#include "Generic/Config.h"
+
+/**
+ * Cache design-space sweep (SWEEP directive).
+ *
+ * Applies the same sequence of analyses (ICACHE, DCACHE, PIPELINE,
+ * IPET) to a set of cache hierarchies (design points), and produces
+ * a table giving the WCET of every design point.
+ *
+ * The analysed program is loaded once, and its contexts and data
+ * addresses (DATAADDRESS) are computed once before the sweep. Every
+ * design point is analysed on a clone of that program, with its own
+ * configuration (see the per thread config pointer in Config.h), so
+ * that the design points can be analysed on several worker threads.
+ * The analyses keep their results in the attributes of the program,
+ * hence the clones; the time spent cloning and deleting them is
+ * reported with the time of the analyses (info).
+ *
+ * Used in:
+ *  - GNUmakefile
+ *  - Generic/Config.h
+ *  - Generic/Config.cc
+ */
+class CacheSweep:public Analysis
+{
+ private:
+  /** Cache hierarchy of every design point */
+  vector < vector < CacheParam * > > points;
+
+  /** Swept analyses (names and parameters), applied in this order */
+  vector < string > analysis_names;
+  vector < ParamAnalysis * > analysis_params;
+
+  int nbthreads;
+  string table_file;
+
+  /** Configuration of every design point, and the configuration the sweep was created from */
+  vector < Config * > point_configs;
+  Config *base_config;
+
+  /** WCET of every design point */
+  vector < string > wcets;
+
+  /** Index of the next design point to be analysed by a worker */
+  unsigned int next_point;
+
+  /** Protects next_point, the times and the cloning/deletion of programs (shared reference counts) */
+  mutex sweep_mutex;
+
+  /** Time spent cloning/deleting the programs and analysing the design points, summed over the workers */
+  float clone_time, analysis_time;
+
+  /** Worker thread: analyses design points until there is none left */
+  void worker ();
+
+  /** Analyses the design point of index i, @return its WCET */
+  string analysePoint (unsigned int i);
+
+  /** Writes the WCET-vs-configuration table in table_file */
+  bool writeTable ();
+
+ public:
+
+  /** Constructor */
+  CacheSweep (Program * p, const vector < vector < CacheParam * > > &points, const ListXmlTag & analyses, int nbthreads, string table_file);
+
+  /** Destructor */
+  ~CacheSweep ();
+
+  /** Checks the program has contexts (computed once for all the design points)
+      @return true if successful, false otherwise.
+  */
+  bool CheckInputAttributes ();
+
+  /** Performs the sweep
+      @return true if successful, false otherwise.
+  */
+  bool PerformAnalysis ();
+
+  /** Remove all private attributes */
+  void RemovePrivateAttributes ();
+
+};
+
+#endif
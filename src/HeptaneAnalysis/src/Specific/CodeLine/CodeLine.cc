@@ -170,3 +170,11 @@ CodeLine::RemovePrivateAttributes ()
 {
 
 }
+
+// Only reads the code addresses
+void
+CodeLine::GetAttributeDependencies (set < string > &reads, set < string > &writes)
+{
+  reads.insert (CodeAddressSlot);
+  writes.insert (CodeLineAttributeName);
+}
@@ -51,6 +51,9 @@ public:
 
   /** Remove all private attributes */
   void RemovePrivateAttributes ();
+
+  /** Attribute slots read and written by the analysis (see Analysis::GetAttributeDependencies) */
+  void GetAttributeDependencies (set < string > &reads, set < string > &writes);
   
 };
 
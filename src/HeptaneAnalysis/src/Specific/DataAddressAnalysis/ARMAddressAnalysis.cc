@@ -137,8 +137,9 @@ long ARMAddressAnalysis::GetOffsetValue(string asm_code)
   return Utl::string2long(val);
 }
 
-int ARMAddressAnalysis::getStackMaxOffset(string s_instr, int StackMaxOffset)
+int ARMAddressAnalysis::getStackMaxOffset(Instruction *instr, int StackMaxOffset)
 {
+  string s_instr = instr->GetCode();
   // ldr/str [sp, val]
   size_t ideb = s_instr.find("[sp,");
   if (ideb == EOS) return StackMaxOffset;
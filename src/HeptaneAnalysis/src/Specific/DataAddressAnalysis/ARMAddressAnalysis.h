@@ -64,7 +64,7 @@ class ARMAddressAnalysis:public AddressAnalysis
  protected:
   int getStackSize (Cfg * cfg);
   int getStackSize(const vector < Instruction * >&listInstr, int *ifrom);
-  int getStackMaxOffset(string s_instr, int StackMaxOffset);
+  int getStackMaxOffset(Instruction *instr, int StackMaxOffset);
   RegState* NewRegState(int stackSize);
   bool importCallerArguments(AbstractRegMem &vAbstractRegMemCaller, AbstractRegMem &vAbstractRegMemCalled);
   void printPointerAccessInfos(Instruction* vinstr);
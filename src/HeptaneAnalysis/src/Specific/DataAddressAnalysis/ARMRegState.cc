@@ -131,7 +131,7 @@ void ARMRegState::simulate(Instruction * vinstr)
 
       // assumed : instr is NOT RESTRICTED to a load/write instruction.
       DAAInstruction *instruct = Arch::getDAAInstruction(instr);
-      instruct->simulate(state, precision, vStack, vStackPrecision, instr);
+      instruct->simulate(state, precision, vStack, vStackPrecision, instr, NULL);
 
       TRACE_simulate( cout << " +++ AFTER simulate of " << instr << endl; printStates(); printStack());
 
@@ -76,6 +76,12 @@ bool static initAddressAnalysis(Cfg * c, Node * n, void *param)
 
       string currentContext = (*context)->getStringId();
       AbstractRegMem regMem_empty1 = AbstractRegMem(ca->NewRegState(InternalSizeStack));
+      if (ca->hasInterproceduralBases() && n == c->GetStartNode())
+	{
+	  // Before the prologue, sp is above the frame of the function.
+	  StackInfoAttribute &stack_info = (StackInfoAttribute &) c->GetAttribute(StackInfoAttributeName);
+	  regMem_empty1.getRegState()->rebaseFrame(stack_info.getFrameSizeWithoutCaller());
+	}
       AbstractRegMemAttribute att1(regMem_empty1);
       n->SetAttribute(in + currentContext, att1);
 
@@ -239,6 +245,9 @@ AddressAnalysis::AddressAnalysis (Program * prog, int sp):StackAnalysis (prog, s
 {
   p = prog;
   spinit = sp;
+  outState = joinState = predState = NULL;
+  widening_delay = -1;
+  narrowing = false;
   //initialization of sp value with 7FFF FFFF - virtual pages alignement
   //long spinit=2147483647 - ( 2147483647 % TAILLEPAGE);
 }
@@ -274,6 +283,20 @@ void
 AddressAnalysis::RemovePrivateAttributes ()
 {}
 
+// Reads the code addresses, writes the data addresses (address attributes of the load/store instructions)
+void
+AddressAnalysis::GetAttributeDependencies (set < string > &reads, set < string > &writes)
+{
+  reads.insert (ContextListAttributeName);
+  reads.insert (ContextTreeAttributeName);
+  reads.insert (SymbolTableAttributeName);
+  reads.insert (CodeAddressSlot);
+  writes.insert (DataAddressSlot);
+  writes.insert (StackInfoAttributeName);
+  writes.insert (string (AddressInName) + "*");
+  writes.insert (string (AddressOutName) + "*");
+}
+
 
 // -------------------------------
 
@@ -289,6 +312,12 @@ AbstractRegMem AddressAnalysis::compute_out(ContextualNode & current, string & i
 
   AbstractRegMemAttribute  &ca_attr_in = getRegMemContextualNode( current, inAnalysisName + idCurrentContext);
   AbstractRegMem v_out = ca_attr_in.getAbstractRegMem(); 
+  if (copiesStates())
+    {
+      // Simulating on a copy, the "Addr_in" value is kept.
+      outState->copy(v_out.getRegState());
+      v_out = AbstractRegMem(outState);
+    }
   RegState *state = v_out.getRegState();
 
   // string idAccessName = AnalysisHelper::mkContextAttrName(inAnalysisName, idCurrentContext);
@@ -428,7 +457,6 @@ bool AddressAnalysis::updateRegistersAndStack_in(ContextualNode &current, set <
   string out = AddressOutName;
   set < ContextualNode > work;
   ContextualNode pred;
-  string idAttr;
   bool b, b1, first;
   AbstractRegMem vout, new_in;
 
@@ -446,6 +474,18 @@ bool AddressAnalysis::updateRegistersAndStack_in(ContextualNode &current, set <
   TRACE( cout << endl << " ++++  intraBlockDataAnalysis_in START BLOCK " << nb /*NumBlock*/ << ", CA_ATTR_IN, context = " << currentContextIn << " address vAbstractRegMem_in = " << vAbstractRegMem_in.getRegState() << endl;
 	 vAbstractRegMem_in.print(); );
 
+  // At a loop head, the predecessors are combined keeping the bases of the values (widening);
+  // after widening_delay visits, the new value is also widened with the previous one.
+  bool widen = widening_delay >= 0 && loopHeads.find(current.node) != loopHeads.end();
+  bool extrapolate = false;
+  if (widen)
+    {
+      int visits = ++headVisits[current];
+      // Narrowing: a loop head is recomputed at most widening_delay + 1 times.
+      if (narrowing && visits > widening_delay + 1) return false;
+      extrapolate = !narrowing && visits > widening_delay;
+    }
+
   // Registers
   const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
   assert(predecessors.size() != 0);	// not the program's entry node
@@ -460,19 +500,25 @@ bool AddressAnalysis::updateRegistersAndStack_in(ContextualNode &current, set <
       b =  AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
       if (b)
 	{
-	  idAttr = out + pred.context->getStringId();
 	  if (first)
 	    {
-	      new_in = getRegMemContextualNode(pred, idAttr).getAbstractRegMem();
+	      new_in = getPredecessorOut(current, pred, joinState);
 	      first = false;  
 	    }
 	  else
 	    {
-	      vout =  getRegMemContextualNode(pred, idAttr).getAbstractRegMem();
-	      new_in.JoinRegisters(vout);
+	      vout = getPredecessorOut(current, pred, predState);
+	      if (widen) new_in.getRegState()->WidenRegisters(vout.getRegState());
+	      else new_in.JoinRegisters(vout);
 	    }
 	}
     }
+  if (extrapolate)
+    {
+      predState->copy(vAbstractRegMem_in.getRegState());
+      predState->WidenRegisters(new_in.getRegState());
+      new_in = AbstractRegMem(predState);
+    }
   b = ! vAbstractRegMem_in.EqualsRegisters(new_in);
   if (b) ca_attr_in.setAbstractRegMemRegisters(new_in);
   
@@ -486,20 +532,26 @@ bool AddressAnalysis::updateRegistersAndStack_in(ContextualNode &current, set <
       b =  AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
       if (b)
 	{ 
-	  idAttr = out + pred.context->getStringId();
 	  if (first) 
 	    {
-	      new_in = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
+	      new_in = getPredecessorOut(current, pred, joinState);
 	      first = false;
 	    }
 	  else
 	    {
-	      vout = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
-	      new_in.JoinStacks(vout);
+	      vout = getPredecessorOut(current, pred, predState);
+	      if (widen) new_in.getRegState()->WidenStacks(vout.getRegState());
+	      else new_in.JoinStacks(vout);
 	    }
 	}
     }
   vAbstractRegMem_in = ca_attr_in.getAbstractRegMem();
+  if (extrapolate)
+    {
+      predState->copy(vAbstractRegMem_in.getRegState());
+      predState->WidenStacks(new_in.getRegState());
+      new_in = AbstractRegMem(predState);
+    }
   b1 = ! vAbstractRegMem_in.EqualsStacks(new_in);
   if (b1) ca_attr_in.setAbstractRegMemStack(new_in);
   
@@ -511,6 +563,66 @@ bool AddressAnalysis::updateRegistersAndStack_in(ContextualNode &current, set <
   return  b1 || b;
 }
 
+/*
+  Without interprocedural bases, the value is shared with the attribute of pred (as the join is made in place, 
+  the first predecessor receives the joined value).
+*/
+AbstractRegMem AddressAnalysis::getPredecessorOut(ContextualNode &current, ContextualNode &pred, RegState *buffer)
+{
+  AbstractRegMem vout = getRegMemContextualNode(pred, AddressOutName + pred.context->getStringId()).getAbstractRegMem();
+  if (!copiesStates()) return vout;
+
+  buffer->copy(vout.getRegState());
+  if (hasInterproceduralBases() && pred.context != current.context)
+    {
+      // Call: pred is the call node in the caller, current the start node of the callee.
+      // Return: pred is an end node of the callee, current the successor of the call node.
+      buffer->rebaseFrame(getContextSP(pred.context) - getContextSP(current.context));
+      if (current.node != current.node->GetCfg()->GetStartNode())
+	buffer->reset_sp();
+    }
+  return AbstractRegMem(buffer);
+}
+
+long AddressAnalysis::getContextSP(Context *context)
+{
+  Cfg *cfg = context->getCurrentFunction();
+  assert(cfg->HasAttribute(StackInfoAttributeName));
+  StackInfoAttribute &attribute = (StackInfoAttribute &) cfg->GetAttribute(StackInfoAttributeName);
+  return attribute.getSP(context->getStringId());
+}
+
+bool AddressAnalysis::hasInterproceduralBases()
+{
+  return false;
+}
+
+void AddressAnalysis::setWideningDelay(int delay)
+{
+  widening_delay = delay;
+}
+
+bool AddressAnalysis::copiesStates()
+{
+  return hasInterproceduralBases() || widening_delay >= 0;
+}
+
+set < ContextualNode > AddressAnalysis::getContextualLoopHeads()
+{
+  set < ContextualNode > heads;
+  vector < Cfg * > cfgs = p->GetAllCfgs();
+  for (size_t i = 0; i < cfgs.size(); i++)
+    {
+      if (!cfgs[i]->HasAttribute(ContextListAttributeName)) continue;
+      const ContextList & contexts = (ContextList &) cfgs[i]->GetAttribute(ContextListAttributeName);
+      vector < Loop * > loops = cfgs[i]->GetAllLoops();
+      for (size_t l = 0; l < loops.size(); l++)
+	for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
+	  heads.insert(ContextualNode(*context, loops[l]->GetHead()));
+    }
+  return heads;
+}
+
 /* FixPointStepInit_in analysis: Compute the "Stack_in" a set of nodes (work), without considering backedges.
    @return a set of nodes for which the Stack_out must be computed. */
 set < ContextualNode > AddressAnalysis::FixPointStepInit_in(set < ContextualNode > &work_in, set < Edge * >&backedges, set < ContextualNode > &visited)
@@ -559,18 +671,67 @@ bool AddressAnalysis::intraBlockDataAnalysis()
   // Initialising.
   symbol_table = (SymbolTableAttribute &) p->GetAttribute (SymbolTableAttributeName);
   AnalysisHelper::applyToAllNodesRecursive(p, initAddressAnalysis, (void *)this);
+  if (copiesStates())
+    {
+      outState = NewRegState(GetRequiredStackSize());
+      joinState = NewRegState(GetRequiredStackSize());
+      predState = NewRegState(GetRequiredStackSize());
+    }
 
   FixPointInit();
 
-  // fix point
+  // Widening at the loop heads, once the states are initialised (FixPointInit ignores the backedges;
+  // the fixpoint below follows them).
+  if (widening_delay >= 0)
+    {
+      vector < Cfg * > cfgs = p->GetAllCfgs();
+      for (size_t i = 0; i < cfgs.size(); i++)
+	{
+	  vector < Loop * > loops = cfgs[i]->GetAllLoops();
+	  for (size_t l = 0; l < loops.size(); l++)
+	    loopHeads.insert(loops[l]->GetHead());
+	}
+    }
+
+  // fix point (iterations and contextual nodes recomputed are reported)
+  unsigned long nbiterations = 0, nbvisits = 0;
   work = AnalysisHelper::initWork();
   while (!work.empty())
     {
+      nbiterations++;
+      nbvisits += work.size();
       work_in = intraBlockDataAnalysis_out(work, visited);
       work.clear();
       work = intraBlockDataAnalysis_in(work_in, visited);
       work_in.clear();
     }
+  ostringstream report;
+  report << "AddressAnalysis: fixpoint in " << nbiterations << " iterations, " << nbvisits << " node visits";
+
+  if (widening_delay >= 0)
+    {
+      // Narrowing, from the loop heads.
+      nbiterations = nbvisits = 0;
+      narrowing = true;
+      headVisits.clear();
+      work_in = getContextualLoopHeads();
+      while (!work_in.empty())
+	{
+	  nbiterations++;
+	  nbvisits += work_in.size();
+	  work = intraBlockDataAnalysis_in(work_in, visited);
+	  work_in.clear();
+	  work_in = intraBlockDataAnalysis_out(work, visited);
+	  work.clear();
+	}
+      narrowing = false;
+      report << " (widening delay " << widening_delay << "), narrowing in " << nbiterations << " iterations, " << nbvisits << " node visits";
+    }
+  Logger::addInfo(report.str());
+  delete outState;
+  delete joinState;
+  delete predState;
+  outState = joinState = predState = NULL;
   return true;
 }
 
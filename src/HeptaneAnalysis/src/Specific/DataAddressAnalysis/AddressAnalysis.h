@@ -30,6 +30,20 @@ This analysis is very basic in the sense:
 - it does not consider pointers 
 - it is perfomed on an intra-basic block basis
 
+When the architecture has interprocedural bases (hasInterproceduralBases()),
+the states are propagated through the calls and returns of the context tree:
+the stack relative values ("sp + k") are rebased from the frame of the caller
+to the frame of the callee (and back), so that a pointer to a global or to a
+local of a caller passed as an argument keeps its base.
+
+With a widening delay (setWideningDelay()), the states at the loop heads are
+widened (RegState::WidenRegisters) after the given number of visits, then
+narrowed once the fixpoint is reached: a pointer incremented in a loop keeps
+its base ("sp", "gp" or a lui) instead of becoming "*". This is a precision
+improvement only: the join already sets a value to "*" on the first
+disagreement, so a loop head changes a bounded number of times anyway and the
+number of iterations of the fixpoint is the same.
+
 *****************************************************************/
 
 
@@ -71,6 +85,11 @@ class AddressAnalysis: public StackAnalysis
  private:
   Program *p;
   CallGraph *call_graph;
+  RegState *outState, *joinState, *predState; ///< Working states of the interprocedural analysis and of the widening.
+  int widening_delay; ///< Number of visits of a loop head before widening, -1 if there is no widening.
+  set < Node * > loopHeads;
+  map < ContextualNode, int > headVisits; ///< Number of visits of the loop heads (per context).
+  bool narrowing; ///< true during the narrowing iterations.
 
  private:
   bool CheckExternalCfg(Program *p); ///< return true if the program reference an external CFG, false otherwise.
@@ -107,6 +126,13 @@ class AddressAnalysis: public StackAnalysis
   
   set < ContextualNode > FixPointStepInit_out(set < ContextualNode > &work, set < Edge * >&backedges, set < ContextualNode > &visited);
   bool updateRegistersAndStack_in(ContextualNode &current, set < Edge * >&backedges);
+  /** @return the "Addr_out" value of a predecessor (pred) of a node (current). With interprocedural bases,
+      it is copied in (buffer) and rebased to the frame of current when the contexts differ. */
+  AbstractRegMem getPredecessorOut(ContextualNode &current, ContextualNode &pred, RegState *buffer);
+  long getContextSP(Context *context); ///< @return the stack pointer of a context (see StackInfoAttribute)
+  bool copiesStates(); ///< @return true if the join and the simulation work on copies of the states.
+  /** @return the contextual loop heads, for the narrowing iterations */
+  set < ContextualNode > getContextualLoopHeads();
   set < ContextualNode > FixPointStepInit_in(set < ContextualNode > &work_in, set < Edge * >&backedges, set < ContextualNode > &visited);
   bool FixPointInit();
   virtual bool importCallerArguments(AbstractRegMem &vAbstractRegMemCaller, AbstractRegMem &vAbstractRegMemCalled)=0;
@@ -118,9 +144,19 @@ class AddressAnalysis: public StackAnalysis
   bool PerformAnalysis ();
   bool CheckInputAttributes ();
   void RemovePrivateAttributes ();
+  /** Attribute slots read and written by the analysis (see Analysis::GetAttributeDependencies) */
+  void GetAttributeDependencies (set < string > &reads, set < string > &writes);
 
   virtual RegState* NewRegState(int stackSize)=0;  // Architecture dependent.
 
+  /** @return true if the states are propagated through calls with rebased stack values (see RegState::rebaseFrame),
+      false for the former intra-procedural behaviour. */
+  virtual bool hasInterproceduralBases();
+
+  /** Sets the number of visits of a loop head before its state is widened (DATAADDRESS widening_delay attribute).
+      A negative value disables the widening (the former behaviour). */
+  void setWideningDelay(int delay);
+
   // The folowings are architecture dependent.
   virtual bool setLoadStoreAddressAttribute(Cfg * vCfg, Instruction* vinstr, RegState *state, Context *context) = 0;
 
@@ -68,12 +68,18 @@ int MIPSAddressAnalysis::getStackSize (Cfg * cfg)
   return 0;
 }
 
-int MIPSAddressAnalysis::getStackMaxOffset(string s_instr, int StackMaxOffset)
+int MIPSAddressAnalysis::getStackMaxOffset(Instruction *instr, int StackMaxOffset)
 {
   string val, reg;
+  string s_instr = instr->GetCode();
 
   if (s_instr.find ("sp") != EOS)  // instruction references "sp"
     {
+      if (instr->HasOperands() && instr->GetOperands().size() == 2 && instr->GetOperands()[1].kind == cfglib::MemoryOperand)
+	{
+	  assert (instr->GetOperands()[1].reg == Arch::getRegisterNumber("sp"));
+	  return Utl::imax(abs((int) instr->GetOperands()[1].value), StackMaxOffset);
+	}
       vector < string > v_instr = Arch::splitInstruction (s_instr);
       assert (v_instr.size () == 3);	//mnemonic op1, val(reg) 
       Utl::extractRegVal( v_instr[2], reg, val);
@@ -111,8 +117,16 @@ bool MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
       //addiu $v0,$sp,8
       //lw $a1,7($v0)
       } */
-  if (stack_maxoffset < offset)
+  if (precision)
     {
+      // The offset is exact, even out of the frame (argument, or pointer to a local of a caller).
+      addr = attribute.getSP (context->getStringId ()) + offset;
+      size = sizeOfMemoryAccess;
+    }
+  else if (stack_maxoffset < offset)
+    {
+      // Frame of the caller that contains sp + offset.
+      long target = attribute.getSP (context->getStringId ()) + offset;
       Context *context_caller = context->getCallerContext ();
       assert (context_caller != NULL);
       Cfg *caller = context_caller->getCurrentFunction ();
@@ -120,6 +134,14 @@ bool MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
       StackInfoAttribute caller_attribute = (StackInfoAttribute &) caller->GetAttribute (StackInfoAttributeName);
       long sp_caller = caller_attribute.getSP (context_caller->getStringId ());
       stack_maxoffset_caller = caller_attribute.getFrameSizeWithCaller ();
+      while (target >= sp_caller + stack_maxoffset_caller && context_caller->getCallerContext () != NULL)
+	{
+	  context_caller = context_caller->getCallerContext ();
+	  caller = context_caller->getCurrentFunction ();
+	  caller_attribute = (StackInfoAttribute &) caller->GetAttribute (StackInfoAttributeName);
+	  sp_caller = caller_attribute.getSP (context_caller->getStringId ());
+	  stack_maxoffset_caller = caller_attribute.getFrameSizeWithCaller ();
+	}
       addr = sp_caller;
       // precision= false;
       size = stack_maxoffset_caller;
@@ -145,17 +167,9 @@ bool MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
 	}
       //--
       
-      if (precision)
-	{
-	  addr = sp + offset;
-	  size = sizeOfMemoryAccess;
-	}
-      else
-	{
-	  addr = sp;
-	  // TODO: check the MIPS ABI if the parameters of the caller can be accessed if not stack_size_caller can be used instead
-	  if (stack_size == 0) size = stack_maxoffset_caller; else size = stack_maxoffset;
-	}
+      addr = sp;
+      // TODO: check the MIPS ABI if the parameters of the caller can be accessed if not stack_size_caller can be used instead
+      if (stack_size == 0) size = stack_maxoffset_caller; else size = stack_maxoffset;
     }
   AddressInfo contextual_info = mkAddressInfo(Instr, access, precision, "stack","", addr, size);
   setContextualAddressAttribute(Instr, context, contextual_info);
@@ -190,10 +204,12 @@ void MIPSAddressAnalysis::analyzeReg (Instruction * Instr, long addr, string acc
 
 
 
-long  MIPSAddressAnalysis::GetOffsetValue(string asm_code)
+long  MIPSAddressAnalysis::GetOffsetValue(Instruction *vinstr)
 {
   //get the offset: offset(gp)
-  vector < string > v_instr = Arch::splitInstruction (asm_code);
+  if (vinstr->HasOperands() && vinstr->GetOperands().size() == 2 && vinstr->GetOperands()[1].kind == cfglib::MemoryOperand)
+    return vinstr->GetOperands()[1].value;
+  vector < string > v_instr = Arch::splitInstruction (vinstr->GetCode ());
   assert (v_instr.size () == 3); // mnemonic op1,offset(reg)
   string op2 = v_instr[2];
   string offset = op2.erase (op2.find ("("));
@@ -232,7 +248,7 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
   //access using gp register
   if (asm_code.find ("gp") != EOS)
     {
-      long loffset = GetOffsetValue(asm_code); //mnemonic op1,offset(gp)
+      long loffset = GetOffsetValue(vinstr); //mnemonic op1,offset(gp)
       long addr = symbol_table.getGP ();
       addr = addr + loffset;
       analyzeReg (vinstr, addr, access, sizeOfMemoryAccess, true);
@@ -241,7 +257,7 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
   //access using $sp register
   else if (asm_code.find ("sp") != EOS)
     {
-      long loffset = GetOffsetValue(asm_code); // mnemonic op1,offset(sp)
+      long loffset = GetOffsetValue(vinstr); // mnemonic op1,offset(sp)
       analyzeStack (vCfg, vinstr, loffset, access, sizeOfMemoryAccess, true, context);
     }
   else
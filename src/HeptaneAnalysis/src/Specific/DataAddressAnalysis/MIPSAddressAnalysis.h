@@ -59,7 +59,7 @@ class MIPSAddressAnalysis:public AddressAnalysis
 {
 
  private:
-  long GetOffsetValue(string asm_code);
+  long GetOffsetValue(Instruction *vinstr);
 
   bool analyzeStack (Cfg * cfg, Instruction * Instr, long offset, string access, int sizeOfMemoryAccess, bool precision, Context *context);
   void analyzeReg (Instruction * Instr, long addr, string access, int sizeOfMemoryAccess, bool precision);
@@ -67,7 +67,7 @@ class MIPSAddressAnalysis:public AddressAnalysis
 
  protected:
   int getStackSize (Cfg * cfg);
-  int getStackMaxOffset(string s_instr, int StackMaxOffset);
+  int getStackMaxOffset(Instruction *instr, int StackMaxOffset);
   void intraBlockDataAnalysis();
 
   bool importCallerArguments(AbstractRegMem &vAbstractRegMemCaller, AbstractRegMem &vAbstractRegMemCalled);
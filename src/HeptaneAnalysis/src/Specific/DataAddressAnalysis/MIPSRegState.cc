@@ -95,7 +95,7 @@ void MIPSRegState::simulate(Instruction * vinstr)
   TRACE_simulate (cout << " +++ BEFORE simulate of " << instr << " at " << std::hex << vaddress << " " << std::dec << endl;  printStates(); printStack());
 
   DAAInstruction *instruct = Arch::getDAAInstruction(instr);
-  instruct->simulate(state, precision, vStack, vStackPrecision, instr);
+  instruct->simulate(state, precision, vStack, vStackPrecision, instr, vinstr->HasOperands() ? &vinstr->GetOperands() : NULL);
 
   assert(precision[MIPS_ZERO_REGISTER]); 
   assert(precision[MIPS_GP_REGISTER]);
@@ -277,9 +277,9 @@ bool MIPSRegState::isAccessAnalysisSP(int register_number, string offset, vector
 	  //4006bc:   03a21021        addu    v0,sp,v0
 	  //4006c0:   8c420010        lw      v0,16(v0)
 	  
+	  //a precise "sp" is a copy of the stack pointer (mv s0,sp, or a pointer to a local of the caller)
 	  assert(oper.length() == 2);	//only sp
-	  assert(!precision[register_number]);	//not precise (array access)
-	  prec = "0";
+	  prec = (precision[register_number] ? "1" : "0");
 	}
     }
 
@@ -322,15 +322,24 @@ void MIPSRegState::accessAnalysis(Instruction * vinstr, vector < string > &resul
 
   instr = vinstr->GetCode();
   // Warning: the state of a register is modified by the state->simulate() method.
-  split_instruction = Arch::splitInstruction(instr);
-  assert(split_instruction.size() == 3);
+  if (vinstr->HasOperands() && vinstr->GetOperands().size() == 2 && vinstr->GetOperands()[1].kind == cfglib::MemoryOperand)
+    {
+      const cfglib::Operand & mem = vinstr->GetOperands()[1];
+      register_number = mem.reg;
+      offset = mem.text.substr(0, mem.text.find("("));
+    }
+  else
+    {
+      split_instruction = Arch::splitInstruction(instr);
+      assert(split_instruction.size() == 3);
 
-  op2 = split_instruction[2];
+      op2 = split_instruction[2];
 
-  reg = Arch::extractInputRegistersFromMem(op2)[0];
-  register_number = Arch::getRegisterNumber(reg);
+      reg = Arch::extractInputRegistersFromMem(op2)[0];
+      register_number = Arch::getRegisterNumber(reg);
 
-  offset = op2.erase(op2.find("("));
+      offset = op2.erase(op2.find("("));
+    }
   // Analyzing the expression associated with the target register of the instuction
   if (!isAccessAnalysisLui(register_number, offset, result))
     if (!isAccessAnalysisGP(register_number, offset, result))
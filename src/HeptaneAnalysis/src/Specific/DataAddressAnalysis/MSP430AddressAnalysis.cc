@@ -60,9 +60,10 @@ void MSP430AddressAnalysis::extractRegVal( string mem_pattern, string &reg, stri
   parse >> val >> reg;
   } */
 
-int MSP430AddressAnalysis::getStackMaxOffset(string s_instr, int StackMaxOffset)
+int MSP430AddressAnalysis::getStackMaxOffset(Instruction *instr, int StackMaxOffset)
 {
   string val, reg;
+  string s_instr = instr->GetCode();
 
   // LBesnard : on peut acceder à des paramètres empilés ? dépendant compilateur
   if (s_instr.find ("sp") != EOS)  // instruction references "sp"
@@ -67,7 +67,7 @@ class MSP430AddressAnalysis:public AddressAnalysis
 
  protected:
   int getStackSize (Cfg * cfg);
-  int getStackMaxOffset(string s_instr, int StackMaxOffset);
+  int getStackMaxOffset(Instruction *instr, int StackMaxOffset);
   void intraBlockDataAnalysis();
   RegState* NewRegState(int stackSize);
   int getNbWordsForStack(Cfg * c);
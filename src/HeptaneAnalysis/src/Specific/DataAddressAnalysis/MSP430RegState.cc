@@ -89,7 +89,7 @@ void MSP430RegState::simulate(Instruction * vinstr)
   // cout << " simulate = " << instr << endl << " the stack before = " << endl;  printStack();
 
   DAAInstruction *instruct = Arch::getDAAInstruction(instr);
-  instruct->simulate(state, precision, vStack, vStackPrecision, instr);
+  instruct->simulate(state, precision, vStack, vStackPrecision, instr, vinstr->HasOperands() ? &vinstr->GetOperands() : NULL);
 
   assert(precision[MSP430_ZERO_REGISTER]);		// zero
   assert(precision[ MSP430_GP_REGISTER]);	// gp
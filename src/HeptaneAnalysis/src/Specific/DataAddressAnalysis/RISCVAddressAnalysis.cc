@@ -31,6 +31,12 @@ RegState* RISCVAddressAnalysis::NewRegState(int stackSize)
   return new RISCVRegState( RISCV_NB_REGISTERS,stackSize);
 }
 
+// The stack slots are tracked through sp and the frame pointer (see RISCV_DLOAD, RISCV_DSTORE).
+bool RISCVAddressAnalysis::hasInterproceduralBases()
+{
+  return true;
+}
+
 bool RISCVAddressAnalysis::TryToComputeStackSize( const vector < Instruction * > &listInstr, int iFrom, int iTo, int *stackSize)
 {
   // take into account the case :
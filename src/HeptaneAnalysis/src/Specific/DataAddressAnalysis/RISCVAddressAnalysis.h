@@ -25,9 +25,9 @@
 This is the entry point of the dataflow analysis of 
 data and stack addresses for RISCV architecture.
 
-This analysis is very basic in the sense:
-- it does not consider pointers 
-- it is perfomed on an intra-basic block basis
+The states are propagated through the calls (interprocedural bases): a pointer
+argument relative to gp, to a lui or to the stack of a caller keeps its base,
+including when it is spilled to the frame (-O0 code accessing locals via s0).
 
 *****************************************************************/
 
@@ -58,6 +58,7 @@ class RISCVAddressAnalysis:public MIPSAddressAnalysis
 {
  private:
   virtual RegState* NewRegState(int stackSize);
+  virtual bool hasInterproceduralBases();
   virtual bool TryToComputeStackSize( const vector < Instruction * > &listInstr, int ifrom, int iTo, int *stackSize);
  public:
 
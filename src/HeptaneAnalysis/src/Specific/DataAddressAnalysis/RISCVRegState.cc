@@ -94,7 +94,7 @@ void RISCVRegState::simulate(Instruction * vinstr)
   TRACE_simulate (cout << " +++ BEFORE simulate of " << instr << " at " << std::hex << vaddress << " " << std::dec << endl;  printStates(); printStack(););
 
   DAAInstruction *instruct = Arch::getDAAInstruction(instr);
-  instruct->simulate(state, precision, vStack, vStackPrecision, instr);
+  instruct->simulate(state, precision, vStack, vStackPrecision, instr, vinstr->HasOperands() ? &vinstr->GetOperands() : NULL);
 
   assert(precision[RISCV_ZERO_REGISTER]);
   assert(precision[RISCV_GP_REGISTER]);
@@ -192,6 +192,56 @@ void RegState::JoinRegisters(RegState * r)
   LOCTRACE(cout << " Result ****" << endl; print(n));
 }
 
+/* @return the base of a value ("sp", "gp" or "0x11lui" for "0x11lui + 8"), "" if it has no base. */
+static string getValueBase(const string &v)
+{
+  string base = v.substr(0, v.find_first_of(" +-"));
+  if (base == "sp" || base == "gp") return base;
+  if (base.size() > 3 && base.compare(base.size() - 3, 3, "lui") == 0) return base;
+  return "";
+}
+
+/* Widening of a value (v1, prec1) with another one (v2, prec2), see WidenRegisters. */
+static void widenValue(string &v1, bool &prec1, const string &v2, bool prec2)
+{
+  if (v1 == v2)
+    {
+      prec1 = prec1 && prec2;
+      return;
+    }
+  string base = getValueBase(v1);
+  if (base == "" || base != getValueBase(v2))
+    v1 = "*";
+  prec1 = false;
+}
+
+void RegState::WidenRegisters(RegState * r)
+{
+  int spReg = getSPRegister();
+  for (size_t i = 0; i < state.size(); i++)
+    {
+      if ((int) i == spReg && state[i] != r->state[i])
+	{
+	  cout << " ERROR: SP becomes not precise !!! " << endl; 
+	  continue;
+	}
+      bool prec = precision[i];
+      widenValue(state[i], prec, r->state[i], r->precision[i]);
+      precision[i] = prec;
+    }
+}
+
+void RegState::WidenStacks(RegState * r)
+{
+  assert(vStack.size() == r->vStack.size());
+  for (size_t i = 0; i < vStack.size(); i++)
+    {
+      bool prec = vStackPrecision[i];
+      widenValue(vStack[i], prec, r->vStack[i], r->vStackPrecision[i]);
+      vStackPrecision[i] = prec;
+    }
+}
+
 string RegState::getRegisterValue(int register_number)
 {
   return state[register_number];
@@ -336,6 +386,67 @@ bool RegState::importRegister(RegState * other, int numreg)
   return true;
 }
 
+bool RegState::getStackOffset(const string &v, long *offset)
+{
+  int i;
+  if (v == "sp")
+    {
+      *offset = 0;
+      return true;
+    }
+  if (!Utl::parseRefStackPointer(v, &i)) return false;
+  *offset = i;
+  return true;
+}
+
+string RegState::mkStackValue(long offset)
+{
+  if (offset == 0) return "sp";
+  return "sp + " + Utl::int2cstring(offset);
+}
+
+/* The base of a stack relative value (v) is moved by delta, other values are unchanged.
+   A value that references sp but cannot be parsed is no longer meaningful and is set to "*". */
+static void rebaseValue(string &v, bool &prec, long delta)
+{
+  long k;
+  if (v.find("sp") == EOS) return;
+  if (RegState::getStackOffset(v, &k))
+    v = RegState::mkStackValue(k + delta);
+  else
+    {
+      v = "*";
+      prec = false;
+    }
+}
+
+void RegState::rebaseFrame(long delta)
+{
+  for (size_t i = 0; i < state.size(); i++)
+    {
+      bool prec = precision[i];
+      rebaseValue(state[i], prec, delta);
+      precision[i] = prec;
+    }
+
+  // Offset k + delta in the new frame is offset k in the old one: index i becomes i - delta.
+  int n = vStack.size();
+  stackType new_vStack(n, "*");
+  stackPrecType new_vStackPrecision(n, false);
+  for (int i = 0; i < n; i++)
+    {
+      long j = i - delta;
+      if (j >= 0 && j < n && vStack[i] != "*")
+	{
+	  bool prec = vStackPrecision[i];
+	  new_vStack[j] = vStack[i];
+	  rebaseValue(new_vStack[j], prec, delta);
+	  new_vStackPrecision[j] = prec;
+	}
+    }
+  vStack.swap(new_vStack);
+  vStackPrecision.swap(new_vStackPrecision);
+}
 
 string RegState::getAliasRegister(int ireg)
 {
@@ -55,6 +55,7 @@ class RegState {
 
   /** Default constructor.*/
   RegState(int nbRegisters, int stacksize);
+  virtual ~RegState() {}
 
   void reset();
   void copy(RegState * r);
@@ -89,6 +90,15 @@ class RegState {
    */
   void JoinRegisters(RegState * r);
 
+  /** Widening of two RegState objects, used at the loop heads (see AddressAnalysis::setWideningDelay):
+      - equal values are kept, their precision is false if one of the precisions is false,
+      - different values with the same base (sp, gp or a lui) keep the value of this object, not precise,
+      - otherwise the register is reset to undefined ("*").
+      A value can only change towards "*", which bounds the number of iterations of the fixpoint.
+   */
+  void WidenRegisters(RegState * r);
+  void WidenStacks(RegState * r);
+
   void setRegisters(RegState * other);
   void setStack(RegState * other);
 
@@ -105,6 +115,17 @@ class RegState {
   void setRegisterPrecision(int register_number, bool val);
 
   bool importRegister(RegState * other, int numreg);
+
+  /** Moves the registers and the stack from a frame whose stack pointer is delta bytes above the current one
+      (delta > 0 when entering a callee, delta < 0 when returning to the caller).
+      The stack relative values "sp + k" become "sp + (k + delta)" and the slot of offset k is moved to offset k + delta.
+      Slot i of the stack holds the byte at offset (vStackSize - 1 - i) from the stack pointer. */
+  void rebaseFrame(long delta);
+
+  /** @return true if a value (v) is relative to the stack pointer ("sp", "sp + k" or "sp - k"), its offset is set in (offset). */
+  static bool getStackOffset(const string &v, long *offset);
+  /** @return the value of the stack pointer plus an offset */
+  static string mkStackValue(long offset);
   bool getCodeAddress( Instruction * vinstr, long *add);
 
   // Added for stack management.
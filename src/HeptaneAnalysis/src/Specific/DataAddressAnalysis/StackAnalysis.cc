@@ -1,6 +1,7 @@
 #include "Logger.h"
 #include "StackAnalysis.h"
 #include "Generic/ContextHelper.h"
+#include "Generic/AnalysisHelper.h"
 #include "arch.h"
 
 
@@ -61,9 +62,8 @@ int StackAnalysis::getStackMaxOffset(Cfg * cfg, int stack_size)
       const vector < Instruction * >&instructions = nodes[n]->GetAsm();
       for (size_t i = 0; i < instructions.size(); i++)
 	{
-	  string s_instr = instructions[i]->GetCode();
-	  if (Arch::isLoad(s_instr) || Arch::isStore(s_instr))
-	    result = getStackMaxOffset(s_instr, result); // ARCH Dependent.
+	  if (AnalysisHelper::isLoad(instructions[i]) || AnalysisHelper::isStore(instructions[i]))
+	    result = getStackMaxOffset(instructions[i], result); // ARCH Dependent.
 	}
     }
   return result;
@@ -67,7 +67,7 @@ class StackAnalysis: public Analysis
       
 
 // The folowings are architecture dependent.
-  virtual int getStackMaxOffset(string s_instr, int StackMaxOffset)=0;
+  virtual int getStackMaxOffset(Instruction *instr, int StackMaxOffset)=0;
   virtual int getStackSize (Cfg * cfg)=0;///< return the size of the stack frame
  
 protected:
@@ -0,0 +1,310 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cassert>
+#include "Specific/IPETAnalysis/ILPModel.h"
+#include "Logger.h"
+
+ILPModel::ILPModel(string vpreferred_prefix)
+{
+  preferred_prefix = vpreferred_prefix;
+  nbvars_initial = 0;
+  nbconstraints_initial = 0;
+}
+
+void ILPModel::setObjective(const vector < string > &ids, const vector < long >&cst)
+{
+  assert(ids.size() == cst.size());
+  for (unsigned int i = 0; i < ids.size(); i++)
+    {
+      objective[ids[i]] += cst[i];
+      integers.insert(ids[i]);
+    }
+}
+
+// ------------------------------------------------------------------
+// Parses a constraint generated by LpsolveSolver:
+// "c1*v1 + c2*v2 ... <= N;", "v1 + v2 - v3 = 0;", "v1 = 1;"
+// ------------------------------------------------------------------
+bool ILPModel::parseConstraint(string line, t_ilp_constraint & c)
+{
+  size_t semicolon = line.find(';');
+  if (semicolon == string::npos)
+    return false;
+  istringstream tokens(line.substr(0, semicolon));
+  string token;
+  long sign = 1;
+  bool relation = false;
+
+  while (tokens >> token)
+    {
+      if (relation)
+	{
+	  c.rhs = stol(token);
+	  return true;
+	}
+      if (token == "+")
+	sign = 1;
+      else if (token == "-")
+	sign = -1;
+      else if (token == "<=" || token == "=")
+	{
+	  c.equality = (token == "=");
+	  relation = true;
+	}
+      else
+	{
+	  size_t star = token.find('*');
+	  if (star == string::npos)
+	    c.terms[token] += sign;
+	  else
+	    c.terms[token.substr(star + 1)] += sign * stol(token.substr(0, star));
+	  sign = 1;
+	}
+    }
+  return false;
+}
+
+bool ILPModel::addConstraints(const string & lp)
+{
+  istringstream lines(lp);
+  string line;
+  while (getline(lines, line))
+    {
+      if (line.find_first_not_of(" \t") == string::npos)
+	continue;
+      t_ilp_constraint c;
+      if (!parseConstraint(line, c))
+	{
+	  Logger::addError("ILPModel: cannot parse constraint " + line);
+	  return false;
+	}
+      constraints.push_back(c);
+    }
+  nbvars_initial = getVariables().size();
+  nbconstraints_initial = constraints.size();
+  return true;
+}
+
+set < string > ILPModel::getVariables()
+{
+  set < string > vars;
+  for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+    vars.insert(it->first);
+  for (unsigned int i = 0; i < constraints.size(); i++)
+    for (map < string, long >::iterator it = constraints[i].terms.begin(); it != constraints[i].terms.end(); it++)
+      vars.insert(it->first);
+  return vars;
+}
+
+// ------------------------------------------------------------------
+// Union-find on the variables equal to each other
+// ------------------------------------------------------------------
+string ILPModel::find(string var)
+{
+  map < string, string >::iterator it = parent.find(var);
+  if (it == parent.end())
+    return var;
+  string root = find(it->second);
+  it->second = root;
+  return root;
+}
+
+void ILPModel::merge(string var1, string var2)
+{
+  string r1 = find(var1), r2 = find(var2);
+  if (r1 == r2)
+    return;
+  bool p1 = (r1.compare(0, preferred_prefix.size(), preferred_prefix) == 0);
+  bool p2 = (r2.compare(0, preferred_prefix.size(), preferred_prefix) == 0);
+  if (p2 > p1 || (p1 == p2 && r2 < r1))
+    swap(r1, r2);
+  // r1 is the representative
+  parent[r2] = r1;
+  if (nulls.count(r2))
+    nulls.insert(r1);
+}
+
+string ILPModel::getRepresentative(string var)
+{
+  string rep = find(var);
+  return nulls.count(rep) ? "" : rep;
+}
+
+// ------------------------------------------------------------------
+// Rewrites the constraint with the representative variables, 
+// variables equal to 0 removed.
+// Returns false if the constraint is trivially satisfied (all the
+// variables are non negative).
+// ------------------------------------------------------------------
+bool ILPModel::normalise(t_ilp_constraint & c)
+{
+  map < string, long > terms;
+  for (map < string, long >::iterator it = c.terms.begin(); it != c.terms.end(); it++)
+    {
+      string rep = getRepresentative(it->first);
+      if (rep != "")
+	terms[rep] += it->second;
+    }
+  c.terms.clear();
+  bool positive = false;
+  for (map < string, long >::iterator it = terms.begin(); it != terms.end(); it++)
+    if (it->second != 0)
+      {
+	c.terms[it->first] = it->second;
+	positive = positive || it->second > 0;
+      }
+
+  if (c.terms.size() == 0 && ((c.equality && c.rhs != 0) || (!c.equality && c.rhs < 0)))
+    Logger::addError("ILPModel: infeasible constraint after reduction");
+  if (c.terms.size() == 0)
+    return false;
+  return c.equality || positive || c.rhs < 0;
+}
+
+void ILPModel::reduce()
+{
+  bool changed = true;
+  while (changed)
+    {
+      changed = false;
+      vector < t_ilp_constraint > kept;
+      for (unsigned int i = 0; i < constraints.size(); i++)
+	{
+	  t_ilp_constraint & c = constraints[i];
+	  if (!normalise(c))
+	    continue;
+	  if (c.rhs == 0)
+	    {
+	      // Sum of non negative variables (same sign coefficients) equal to 0,
+	      // or lower or equal to 0: all the variables are 0
+	      bool allpos = true, allneg = true;
+	      for (map < string, long >::iterator it = c.terms.begin(); it != c.terms.end(); it++)
+		{
+		  allpos = allpos && it->second > 0;
+		  allneg = allneg && it->second < 0;
+		}
+	      if (allpos || (c.equality && allneg))
+		{
+		  for (map < string, long >::iterator it = c.terms.begin(); it != c.terms.end(); it++)
+		    nulls.insert(it->first);
+		  changed = true;
+		  continue;
+		}
+	      // a*x - a*y = 0: x and y are substituted
+	      if (c.equality && c.terms.size() == 2 && c.terms.begin()->second == -c.terms.rbegin()->second)
+		{
+		  merge(c.terms.begin()->first, c.terms.rbegin()->first);
+		  changed = true;
+		  continue;
+		}
+	    }
+	  kept.push_back(c);
+	}
+      constraints = kept;
+    }
+
+  // Duplicated constraints (all normalised)
+  set < string > keys;
+  vector < t_ilp_constraint > kept;
+  for (unsigned int i = 0; i < constraints.size(); i++)
+    {
+      ostringstream key;
+      for (map < string, long >::iterator it = constraints[i].terms.begin(); it != constraints[i].terms.end(); it++)
+	key << it->second << "*" << it->first << " ";
+      key << (constraints[i].equality ? "= " : "<= ") << constraints[i].rhs;
+      if (keys.insert(key.str()).second)
+	kept.push_back(constraints[i]);
+    }
+  constraints = kept;
+
+  // Objective function and integer variables on the representatives
+  map < string, long > reduced_objective;
+  for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+    {
+      string rep = getRepresentative(it->first);
+      if (rep != "")
+	reduced_objective[rep] += it->second;
+    }
+  objective = reduced_objective;
+  set < string > reduced_integers;
+  for (set < string >::iterator it = integers.begin(); it != integers.end(); it++)
+    {
+      string rep = getRepresentative(*it);
+      if (rep != "")
+	reduced_integers.insert(rep);
+    }
+  integers = reduced_integers;
+}
+
+void ILPModel::generate(Solver * solver, ostringstream & os_objective, ostringstream & os_constraints, ostringstream & os_declarations)
+{
+  vector < string > ids;
+  vector < long >cst;
+  for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+    {
+      ids.push_back(it->first);
+      cst.push_back(it->second);
+    }
+  solver->generate_objective_function(os_objective, ids, cst);
+
+  for (unsigned int i = 0; i < constraints.size(); i++)
+    {
+      t_ilp_constraint & c = constraints[i];
+      bool unit = true;
+      ids.clear();
+      cst.clear();
+      for (map < string, long >::iterator it = c.terms.begin(); it != c.terms.end(); it++)
+	{
+	  ids.push_back(it->first);
+	  cst.push_back(it->second);
+	  unit = unit && it->second == 1;
+	}
+      if (c.equality)
+	{
+	  if (unit)
+	    solver->generate_equality(os_constraints, ids, c.rhs);
+	  else
+	    solver->generate_linear_equality(os_constraints, ids, cst, c.rhs);
+	}
+      else
+	{
+	  if (unit)
+	    solver->generate_inequality(os_constraints, ids, c.rhs);
+	  else
+	    solver->generate_linear_inequality(os_constraints, ids, cst, c.rhs);
+	}
+    }
+
+  solver->generate_declarations(os_declarations, vector < string > (integers.begin(), integers.end()));
+}
+
+string ILPModel::getStatistics()
+{
+  ostringstream os;
+  os << "ILP presolve: " << nbvars_initial << " variables, " << nbconstraints_initial << " constraints reduced to "
+     << getVariables().size() << " variables, " << constraints.size() << " constraints";
+  return os.str();
+}
@@ -0,0 +1,117 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef IPET_ILP_MODEL_H
+#define IPET_ILP_MODEL_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <sstream>
+#include "Specific/IPETAnalysis/Solver.h"
+
+using namespace std;
+
+/** Linear constraint: sum(terms) <= rhs, or sum(terms) = rhs if equality */
+typedef struct
+{
+  map < string, long > terms;
+  bool equality;
+  long rhs;
+} t_ilp_constraint;
+
+/**
+   In-memory ILP system of IPETAnalysis (presolve="on").
+
+   The constraints are read from the text generated by LpsolveSolver,
+   then reduced before being generated for the actual solver:
+   - equalities between two variables (flow constraints of single
+     entry/single exit chains, call constraints) are substituted,
+     keeping one representative variable;
+   - variables forced to 0 (unreachable contexts, and equalities to 0
+     of non negative variables) are removed;
+   - constraints that became trivial or duplicated are removed.
+
+   The value of every eliminated variable is the one of its
+   representative (or 0), see getRepresentative.
+*/
+class ILPModel
+{
+  /** Objective function (maximised) */
+  map < string, long > objective;
+
+  /** Variables of the objective function, declared as integers */
+  set < string > integers;
+
+  vector < t_ilp_constraint > constraints;
+
+  /** Variables equal to another one (union-find), and variables equal to 0 */
+  map < string, string > parent;
+  set < string > nulls;
+
+  /** Representative variables are preferably chosen among the ones with this prefix */
+  string preferred_prefix;
+
+  unsigned int nbvars_initial, nbconstraints_initial;
+
+  string find (string var);
+  void merge (string var1, string var2);
+  /** Applies the substitutions to the constraint c, @return false if c is trivially satisfied */
+  bool normalise (t_ilp_constraint & c);
+  /** Parses one constraint "sum(coef*var) (<=|=) N;" (lp_solve format) */
+  bool parseConstraint (string line, t_ilp_constraint & c);
+  set < string > getVariables ();
+
+ public:
+  ILPModel (string vpreferred_prefix);
+
+  /** Objective function sum(ids*cst), the variables are integers */
+  void setObjective (const vector < string > &ids, const vector < long >&cst);
+
+  /** Adds the constraints generated by LpsolveSolver in lp, @return false on a parse error */
+  bool addConstraints (const string & lp);
+
+  /** Reduces the system (substitutions until a fixpoint, then removal of duplicates) */
+  void reduce ();
+
+  /** Generates the reduced system with the given solver */
+  void generate (Solver * solver, ostringstream & os_objective, ostringstream & os_constraints, ostringstream & os_declarations);
+
+  /** Objective function and constraints of the (reduced) system */
+  const map < string, long > &getObjective ()
+  {
+    return objective;
+  }
+  const vector < t_ilp_constraint > &getConstraints ()
+  {
+    return constraints;
+  }
+
+  /** @return the variable var is equal to in the reduced system, "" if it is equal to 0 */
+  string getRepresentative (string var);
+
+  /** @return a short report (number of variables and constraints before/after reduction) */
+  string getStatistics ();
+};
+
+#endif
@@ -67,6 +67,10 @@
 
    - Loop maxiter
 
+   - Branch prediction bounds per loop entry (optional, see
+   BranchPredAnalysis), attached to loops for every call context:
+   wrong predictions and BTB misses of the loop control branches.
+
    - Cache classification. A cache classification should be attached to
    every instruction for every cache level (see SharedAttributes.h). 
    The attribute name is: BaseAttrName+"#"+contextName.
@@ -80,6 +84,8 @@
 #include <sstream>
 #include <stdexcept>
 #include <cassert>
+#include <thread>
+#include <atomic>
 
 #include "Analysis.h"
 #include "Generic/Config.h"
@@ -168,7 +174,7 @@ int IPETAnalysis::getIPETMethodToApply(bool pipeline, bool perfectIcache, bool p
 // - latencyPerfectDcache : useful only for PerfectDcache method
 // ---------------------------------------
 IPETAnalysis::IPETAnalysis(Program * p, int used_solver, bool pipeline, bool generate_wcet_info, bool generate_node_freq, int nb_icache_levels,
-			   int nb_dcache_levels, map < int, vector < CacheParam * > >&cache_params):Analysis
+			   int nb_dcache_levels, map < int, vector < CacheParam * > >&cache_params, int vnbthreads, bool vpresolve, bool vinprocess, bool vcompositional):Analysis
     (p)
 {
   bool perfectDcache = false;
@@ -184,6 +190,11 @@ IPETAnalysis::IPETAnalysis(Program * p, int used_solver, bool pipeline, bool gen
   // Fill-in member variables from parameters
   generate_wcet_information = generate_wcet_info;
   generate_node_frequencies = generate_node_freq;
+  nbthreads = vnbthreads;
+  presolve = vpresolve;
+  inprocess = vinprocess;
+  compositional = vcompositional;
+  model = NULL;
   NbICacheLevels = nb_icache_levels;
   NbDCacheLevels = nb_dcache_levels;
   MemoryStoreLatency = config->getMemoryStoreLatency();
@@ -771,7 +782,7 @@ bool IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(Instruction
 {
   // This is introduce to not count for instance the next of an always miss 
   // in the current cache level while in previous level it is a First miss
-  if (Arch::isStore(vinstr->GetCode()))
+  if (AnalysisHelper::isStore(vinstr))
     {
       *wcet_first = *wcet_first + MemoryStoreLatency;
       *wcet_next = *wcet_next + MemoryStoreLatency;
@@ -806,7 +817,7 @@ void IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_ICACHE_DCACHE(Instructio
   unsigned int occurrence_bound_data;
 
   ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(vinstr, wcet_first, wcet_next);
-  bisLoad = Arch::isLoad(vinstr->GetCode());
+  bisLoad = AnalysisHelper::isLoad(vinstr);
 
   countFirst = true;		// to know if we count the first access for the current cache level
   countNext = true;		// to know if we count the next access for the current cache level
@@ -836,7 +847,7 @@ void IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_PERFECTICACHE_DCACHE(Ins
   *wcet_next = *wcet_next + PerfectICacheLatency;
 
   ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(vinstr, wcet_first, wcet_next);
-  if (Arch::isLoad(vinstr->GetCode()))
+  if (AnalysisHelper::isLoad(vinstr))
     {
       always_accessed_data = true;
       never_accessed_data = false;
@@ -910,7 +921,8 @@ bool IPETAnalysis::generateNodeIds(ostringstream & os, Cfg * c)
 {
   // Used to generate BB numbers
   // NB: should be static, because BB numbers should be unique for all Cfgs
-  static int bb_id = 0;
+  //     (per thread, the workers of a cache sweep generate their ILP concurrently)
+  static thread_local int bb_id = 0;
 
   if (c->HasAttribute(ExternalWCETAttributeName))
     {
@@ -1332,6 +1344,68 @@ void IPETAnalysis::generateConstraints_back_edges_loops(Cfg * c, ostringstream &
     }
 }
 
+/*
+  Branch prediction costs of the loop control branches, when bounded by BranchPredAnalysis:
+  per loop entry, nbwrong * (wrong prediction cost + right prediction gain) + nbmissbtb * BTB miss cost,
+  and minus the right prediction gain on every execution of the branches (the right predictions are
+  at least the executions minus the wrong ones).
+  The costs of the architecture are the largest ones (smallest gain) among the loop control branches.
+ */
+void IPETAnalysis::generateConstraints_branch_prediction(Cfg * c, const ContextList & contexts, vector < string > &vid, VECTOR_WCET &vwcet)
+{
+  vector < Loop * >vl = c->GetAllLoops();
+  unsigned int nc = contexts.size();
+
+  for (unsigned int l = 0; l < vl.size(); l++)
+    {
+      Loop *CurrentLoop = vl[l];
+      vector < Node * >vb = AnalysisHelper::getLoopControlBranches(c, CurrentLoop);
+      if (vb.size() == 0)
+	continue;
+
+      long wrongCost = 0, missBTBCost = 0, gain = -1;
+      vector < long >vgain;
+      for (unsigned int b = 0; b < vb.size(); b++)
+	{
+	  string code = AnalysisHelper::getBranchInstruction(vb[b])->GetCode();
+	  wrongCost = max(wrongCost, (long) Arch::getBranchPredWrongPredCost(MemoryLoadLatency, code));
+	  missBTBCost = max(missBTBCost, (long) Arch::getBranchPredMissBTBCost(MemoryLoadLatency, code));
+	  vgain.push_back(Arch::getBranchPredCorrectPredGain(MemoryLoadLatency, code));
+	  gain = (gain == -1) ? vgain[b] : min(gain, vgain[b]);
+	}
+
+      Node *head = CurrentLoop->GetHead();
+      vector < Edge * >ie = c->GetIncomingEdges(head);
+      for (unsigned int ic = 0; ic < nc; ic++)
+	{
+	  string contextName = contexts[ic]->getStringId();
+	  string wrongName = AnalysisHelper::mkContextAttrName(BRPRED_LOOP_NBWRONGPRED, contextName);
+	  if (!CurrentLoop->HasAttribute(wrongName))
+	    continue;
+	  SerialisableIntegerAttribute & nbwrong = (SerialisableIntegerAttribute &) CurrentLoop->GetAttribute(wrongName);
+	  SerialisableIntegerAttribute & nbmissbtb =
+	    (SerialisableIntegerAttribute &) CurrentLoop->GetAttribute(AnalysisHelper::mkContextAttrName(BRPRED_LOOP_NBMISSBTB, contextName));
+	  long entryCost = nbwrong.GetValue() * (wrongCost + gain) + nbmissbtb.GetValue() * missBTBCost;
+	  if (entryCost != 0)
+	    for (unsigned int e = 0; e < ie.size(); e++)
+	      {
+		Node *origin = c->GetSourceNode(ie[e]);
+		if (!CurrentLoop->FindInLoop(origin))
+		  {
+		    vid.push_back(mkEdgeVariableNameSolver("e_", origin, head, contextName));
+		    vwcet.push_back(entryCost);
+		  }
+	      }
+	  for (unsigned int b = 0; b < vb.size(); b++)
+	    if (vgain[b] != 0)
+	      {
+		vid.push_back(mkVariableNameSolver("n_", vb[b], contextName));
+		vwcet.push_back(-vgain[b]);
+	      }
+	}
+    }
+}
+
 /**
    @return true if a Basic block must be contraint, false otherwise.
    For a basic block (node), element of a loop (loop) with head its entry node.
@@ -1553,6 +1627,7 @@ bool IPETAnalysis::generateConstraints(ostringstream & os, Cfg * c, vector < str
       // ---------------------------------------------------------------------
       generateConstraints_BB_edge_eachContext(c, os, vn, ve, contexts);
       generateConstraints_back_edges_loops(c, os, vn, contexts);
+      generateConstraints_branch_prediction(c, contexts, vid, vwcet);
     }
   return true;
 }
@@ -1570,6 +1645,307 @@ bool IPETAnalysis::isDeadCode(Cfg * cfg)
   return true;
 }
 
+// ------------------------------------------------
+//
+// Generate constraints for all CFGs
+// ---------------------------------
+//
+// The Cfgs are independent once the node ids are
+// generated: node execution times are attached to
+// the nodes of the Cfg being processed only, the
+// other attributes are read only.
+// Every Cfg is processed by one of the threads in
+// its own buffer; the buffers are merged in the
+// order of lcfg.
+//
+// ------------------------------------------------
+void IPETAnalysis::generateCfgConstraints(vector < Cfg * >&lcfg, vector < Cfg * >&live, vector < ostringstream > &vos, vector < vector < string > >&vvid,
+					  vector < VECTOR_WCET > &vvwcet)
+{
+  // Dead code is filtered first (walks through the callers)
+  live.clear();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    if (! isDeadCode(lcfg[c]))
+      live.push_back(lcfg[c]);
+
+  vos.resize(live.size());
+  vvid.resize(live.size());
+  vvwcet.resize(live.size());
+
+  atomic < unsigned int > next_cfg(0);
+  Config *vconfig = config;
+  auto worker = [&]()
+    {
+      config = vconfig;		// per thread pointer (see Config.h)
+      for (unsigned int c = next_cfg++; c < live.size(); c = next_cfg++)
+	generateConstraints(vos[c], live[c], vvid[c], vvwcet[c]);
+    };
+
+  unsigned int n = min((unsigned int) nbthreads, (unsigned int) live.size());
+  if (n <= 1)
+    worker();
+  else
+    {
+      vector < thread > threads;
+      for (unsigned int t = 0; t < n; t++)
+	threads.push_back(thread(worker));
+      for (unsigned int t = 0; t < n; t++)
+	threads[t].join();
+    }
+}
+
+void IPETAnalysis::generateAllConstraints(ostringstream & os, vector < Cfg * >&lcfg, vector < string > &vid, VECTOR_WCET &vwcet)
+{
+  vector < Cfg * >live;
+  vector < ostringstream > vos;
+  vector < vector < string > > vvid;
+  vector < VECTOR_WCET > vvwcet;
+  generateCfgConstraints(lcfg, live, vos, vvid, vvwcet);
+
+  for (unsigned int c = 0; c < live.size(); c++)
+    {
+      os << vos[c].str();
+      vid.insert(vid.end(), vvid[c].begin(), vvid[c].end());
+      vwcet.insert(vwcet.end(), vvwcet[c].begin(), vvwcet[c].end());
+    }
+}
+
+// ------------------------------------------------
+//
+// Compositional mode
+// ------------------
+//
+// The call constraints tie the frequency of the
+// first BB of a callee context to the one of its
+// call node only, so the ILP system can be split
+// per function and context. The functions are
+// summarised bottom-up in the call graph: the
+// summary of a callee context is a cost of its
+// call node in the ILP system of the caller.
+//
+// The only non homogeneous constraint of a
+// context is nf <= 1 (first execution of a BB).
+// A context called k times costs at most
+// k * wcet + once, where wcet is computed with
+// the first executions costed as next executions
+// and once is the sum of the first execution extra
+// costs (each paid once whatever k). The entry
+// point is called once, its first executions are
+// kept in its ILP system.
+//
+// The identical local systems (same function, costs
+// and callee summaries) are solved once.
+//
+// ------------------------------------------------
+
+/** @return text where the context suffix of the variables is removed */
+static string removeContextSuffix(const string & text, const string & suffix)
+{
+  string res;
+  size_t pos = 0, found;
+  while ((found = text.find(suffix, pos)) != string::npos)
+    {
+      size_t end = found + suffix.size();
+      res += text.substr(pos, found - pos);
+      if (end < text.size() && isalnum(text[end]))
+	res += suffix;
+      pos = end;
+    }
+  return res + text.substr(pos);
+}
+
+/** @return the context suffix (_cCNB) of the first variable of an lp_solve constraint */
+static string getContextSuffix(const string & line)
+{
+  istringstream tokens(line);
+  string token;
+  while (tokens >> token)
+    {
+      size_t star = token.find('*');
+      if (star != string::npos)
+	token = token.substr(star + 1);
+      size_t suffix = token.rfind("_c");
+      if (isalpha(token[0]) && suffix != string::npos)
+	return token.substr(suffix);
+    }
+  return "";
+}
+
+bool IPETAnalysis::summariseContext(Context * context, bool top)
+{
+  if (!top && context_summaries.count(context))
+    return true;
+
+  Cfg *c = context->getCurrentFunction();
+  string suffix = "_c" + context->getStringId();
+  if (c->HasAttribute(ExternalWCETAttributeName))
+    {
+      ExternalWCETAttributeNameType & ia = (ExternalWCETAttributeNameType &) c->GetAttribute(ExternalWCETAttributeName);
+      t_wcet_summary & summary = summaries["external " + c->getStringName()];
+      summary.wcet = ia.GetValue();
+      summary.once = 0;
+      context_summaries[context] = &summary;
+      return true;
+    }
+
+  // Local ILP system: constraints of the context, callee summaries as costs of the call nodes
+  map < string, long > objective = local_objective[c][suffix];
+  ostringstream lp, signature;
+  lp << local_constraints[c][suffix];
+  signature << (top ? "top " : "") << c->getStringName() << endl;
+  for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+    signature << it->second << "*" << it->first << endl;
+
+  long once = 0;
+  if (!top)
+    for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+      if (it->first.compare(0, 3, "nf_") == 0)
+	{
+	  string next = "nn_" + it->first.substr(3);
+	  long wcet_next = objective.count(next) ? objective[next] : 0;
+	  once += max(0L, it->second - wcet_next);
+	  it->second = wcet_next;
+	}
+
+  vector < Context * >&called = callees[context];
+  for (unsigned int i = 0; i < called.size(); i++)
+    {
+      if (!summariseContext(called[i], false))
+	return false;
+      t_wcet_summary *callee = context_summaries[called[i]];
+      string ncall = mkVariableNameSolver("n_", called[i]->getCallerNode(), context->getStringId());
+      objective[ncall] += callee->wcet;
+      if (callee->once != 0)
+	{
+	  if (top)
+	    {
+	      // Paid once if the call node is executed
+	      string first = "z" + ncall;
+	      objective[first] += callee->once;
+	      lp << first << " <= 1;" << endl << first << " - " << ncall << " <= 0;" << endl;
+	    }
+	  else
+	    once += callee->once;
+	}
+      signature << "call " << ncall << " " << callee->wcet << " " << callee->once << endl;
+    }
+  lp << mkVariableNameSolver("n_", c->GetStartNode(), context->getStringId()) << " = 1;" << endl;
+
+  string key = removeContextSuffix(signature.str() + lp.str(), suffix);
+  map < string, t_wcet_summary >::iterator found = summaries.find(key);
+  if (found != summaries.end())
+    {
+      context_summaries[context] = &(found->second);
+      return true;
+    }
+
+  ILPModel model("n_");
+  vector < string > ids;
+  VECTOR_WCET cst;
+  for (map < string, long >::iterator it = objective.begin(); it != objective.end(); it++)
+    {
+      ids.push_back(it->first);
+      cst.push_back(it->second);
+    }
+  model.setObjective(ids, cst);
+  if (!model.addConstraints(lp.str()))
+    return false;
+  model.reduce();
+
+  SimplexSolver simplex;
+  map < string, long > values;
+  long value;
+  if (!simplex.solve(model, values, value))
+    {
+      if (simplex.isTooBig())
+	Logger::addWarning("IPETAnalysis: ILP system too large to be solved in-process for " + c->getStringName() + " in context " + context->getStringId());
+      else
+	Logger::addInfo("IPETAnalysis: no integral optimum found in-process for " + c->getStringName() + " in context " + context->getStringId());
+      return false;
+    }
+
+  t_wcet_summary & summary = summaries[key];
+  summary.wcet = value;
+  summary.once = once;
+  vector < Node * >vn = c->GetAllNodes();
+  for (unsigned int i = 0; i < vn.size(); i++)
+    {
+      string var = mkVariableNameSolver("n_", vn[i], context->getStringId());
+      string rep = model.getRepresentative(var);
+      if (rep == "" || values.count(rep))
+	summary.frequencies[removeContextSuffix(var, suffix)] = (rep == "") ? 0 : values[rep];
+    }
+  context_summaries[context] = &summary;
+  return true;
+}
+
+bool IPETAnalysis::PerformCompositionalAnalysis(vector < Cfg * >&lcfg, string & wcet)
+{
+  vector < Cfg * >live;
+  vector < ostringstream > vos;
+  vector < vector < string > > vvid;
+  vector < VECTOR_WCET > vvwcet;
+  generateCfgConstraints(lcfg, live, vos, vvid, vvwcet);
+
+  callees.clear();
+  local_constraints.clear();
+  local_objective.clear();
+  summaries.clear();
+  context_summaries.clear();
+
+  // Constraints and objective function terms of every Cfg, split per context
+  for (unsigned int c = 0; c < live.size(); c++)
+    {
+      istringstream lines(vos[c].str());
+      string line;
+      while (getline(lines, line))
+	local_constraints[live[c]][getContextSuffix(line)] += line + "\n";
+      for (unsigned int i = 0; i < vvid[c].size(); i++)
+	local_objective[live[c]][getContextSuffix(vvid[c][i])][vvid[c][i]] += vvwcet[c][i];
+
+      const ContextList & contexts = (ContextList &) live[c]->GetAttribute(ContextListAttributeName);
+      for (unsigned int ic = 0; ic < contexts.size(); ic++)
+	if (! isNULLPointer(contexts[ic]->getCallerNode()) && isReachableState(contexts[ic]->getCallerContext()))
+	  callees[contexts[ic]->getCallerContext()].push_back(contexts[ic]);
+    }
+
+  Cfg *function = config->getEntryPoint();
+  const ContextList & contexts = (ContextList &) function->GetAttribute(ContextListAttributeName);
+  Context *entry = NULL;
+  for (unsigned int ic = 0; ic < contexts.size(); ic++)
+    if (isNULLPointer(contexts[ic]->getCallerNode()))
+      entry = contexts[ic];
+  assert(entry != NULL);
+  if (!summariseContext(entry, true))
+    return false;
+
+  ostringstream os;
+  os << "IPET compositional: " << context_summaries.size() << " contexts, " << summaries.size() << " ILP systems solved";
+  Logger::addInfo(os.str());
+  wcet = to_string(context_summaries[entry]->wcet);
+  if (generate_node_frequencies)
+    setCompositionalFrequencies(entry, 1);
+  return true;
+}
+
+void IPETAnalysis::setCompositionalFrequencies(Context * context, long nbcalls)
+{
+  Cfg *c = context->getCurrentFunction();
+  if (c->HasAttribute(ExternalWCETAttributeName))
+    return;
+  string suffix = "_c" + context->getStringId();
+  t_wcet_summary *summary = context_summaries[context];
+  for (map < string, long >::iterator it = summary->frequencies.begin(); it != summary->frequencies.end(); it++)
+    solver->setFrequencyAttribute(it->first + suffix, to_string(nbcalls * it->second));
+
+  vector < Context * >&called = callees[context];
+  for (unsigned int i = 0; i < called.size(); i++)
+    {
+      string ncall = removeContextSuffix(mkVariableNameSolver("n_", called[i]->getCallerNode(), context->getStringId()), suffix);
+      setCompositionalFrequencies(called[i], nbcalls * summary->frequencies[ncall]);
+    }
+}
+
 // -------------------------------------------
 // Core of the analysis
 // generate an ILP problem to compute
@@ -1603,11 +1979,6 @@ bool IPETAnalysis::PerformAnalysis()
       return true;
     }
 
-  char buffer[25] = "/tmp/IPETAnalysis_XXXXXX";
-  mkstemp(buffer);
-  ofstream os(buffer);
-  string fout = buffer;
-
   // Get the Cfg of the program entry point
   // --------------------------------------
   vector < string > vid;
@@ -1618,15 +1989,43 @@ bool IPETAnalysis::PerformAnalysis()
       generateNodeIds(strc, lcfg[c]);
     }
 
-  for (unsigned int c = 0; c < lcfg.size(); c++)
+  // Compositional mode (methods without pipeline), the constraints are generated in lp_solve format to be read back by the ILP models
+  if (compositional && method >= METHOD_NOPIPELINE_ICACHE_DCACHE)
     {
-      if (! isDeadCode(lcfg[c]))
-	generateConstraints(strc, lcfg[c], vid, vwcet);
+      Solver *output_solver = solver;
+      solver = new LpsolveSolver((IPETAnalysis *) this);
+      string wcet;
+      bool solved = PerformCompositionalAnalysis(lcfg, wcet);
+      delete solver;
+      solver = output_solver;
+      if (solved)
+	{
+	  if (this->generate_wcet_information)
+	    {
+	      SerialisableStringAttribute ba(wcet);
+	      function->SetAttribute(WCETAttributeName, ba);
+	    }
+	  return true;
+	}
+      Logger::addInfo("IPETAnalysis: compositional mode not applicable, the whole ILP system is solved");
     }
+  else if (compositional)
+    Logger::addWarning("IPETAnalysis: compositional mode not supported with the pipeline, the whole ILP system is solved");
+
+  // With presolve or the in-process resolution, the constraints are generated
+  // in lp_solve format to be read back by the ILP model. The in-process
+  // resolution is only tried for the methods without pipeline.
+  bool in_process = inprocess && method >= METHOD_NOPIPELINE_ICACHE_DCACHE;
+  if (inprocess && !in_process)
+    Logger::addInfo("IPETAnalysis: no in-process resolution with the pipeline, the external solver is used");
+  bool reduced = presolve || in_process;
+  Solver *output_solver = solver;
+  if (reduced)
+    solver = new LpsolveSolver((IPETAnalysis *) this);
+
+  generateAllConstraints(strc, lcfg, vid, vwcet);
 
   generateCallConstraints(strc, p);
-  solver->generate_objective_function(strf, vid, vwcet);
-  solver->generate_declarations(stde, AnalysisHelper::unicity(vid));
 
   // Constraint for entry point
   {
@@ -1639,24 +2038,95 @@ bool IPETAnalysis::PerformAnalysis()
     solver->generate_equality(strc, vs, 1);
   }
 
-  // Write everything (objective first, constraints, then declarations last) in the output file Objective function
-  os << strf.str();
-  // All the constraints (except statistics)
-  os << strc.str();
-  // Declarations
-  os << stde.str();
-  os.close();
-
-  // Launch the solver
-  string tmpFileName;
-  if (!Utl::mktmpfile("/tmp/solver_", tmpFileName))
-    return false;
-  if (!solver->solve(fout, tmpFileName))
-    return false;
-
-  // Parse the solver output
   string wcet;
-  solver->parse_output(tmpFileName, wcet);
+  bool solved = false;
+  if (reduced)
+    {
+      // Binary variables (int2bin) are out of the scope of the in-process resolution
+      if (in_process && !solver->binvars.empty())
+	{
+	  in_process = false;
+	  Logger::addInfo("IPETAnalysis: binary variables, the external solver is used");
+	}
+      delete solver;
+      solver = output_solver;
+
+      // Reduction of the ILP system, node frequency variables being kept as representatives
+      delete model;
+      model = new ILPModel("n_");
+      model->setObjective(vid, vwcet);
+      if (!model->addConstraints(strc.str()))
+	return false;
+      model->reduce();
+      Logger::addInfo(model->getStatistics());
+
+      if (in_process)
+	{
+	  SimplexSolver simplex;
+	  map < string, long > values;
+	  long value;
+	  solved = simplex.solve(*model, values, value);
+	  if (solved)
+	    {
+	      wcet = to_string(value);
+	      if (generate_node_frequencies)
+		for (map < string, long >::iterator it = values.begin(); it != values.end(); it++)
+		  solver->setFrequencyAttribute(it->first, to_string(it->second));
+	    }
+	  else if (simplex.isTooBig())
+	    Logger::addWarning("IPETAnalysis: ILP system too large to be solved in-process, the external solver is used");
+	  else
+	    Logger::addInfo("IPETAnalysis: no integral optimum found in-process, the external solver is used");
+	}
+      if (!solved)
+	{
+	  strc.str("");
+	  model->generate(solver, strf, strc, stde);
+	}
+    }
+  else
+    {
+      solver->generate_objective_function(strf, vid, vwcet);
+      solver->generate_declarations(stde, AnalysisHelper::unicity(vid));
+    }
+
+  if (!solved)
+    {
+      char buffer[25] = "/tmp/IPETAnalysis_XXXXXX";
+      mkstemp(buffer);
+      ofstream os(buffer);
+      string fout = buffer;
+
+      // Write everything (objective first, constraints, then declarations last) in the output file Objective function
+      os << strf.str();
+      // All the constraints (except statistics)
+      os << strc.str();
+      // Declarations
+      os << stde.str();
+      os.close();
+
+      // Launch the solver
+      string tmpFileName;
+      if (!Utl::mktmpfile("/tmp/solver_", tmpFileName))
+	return false;
+      if (!solver->solve(fout, tmpFileName))
+	return false;
+
+      // Parse the solver output
+      solver->parse_output(tmpFileName, wcet);
+    }
+
+  // Frequencies of the node variables eliminated by the presolve
+  if (reduced && generate_node_frequencies)
+    {
+      for (map < string, Node * >::iterator it = node_ids.begin(); it != node_ids.end(); it++)
+	{
+	  string rep = model->getRepresentative(it->first);
+	  if (rep == it->first)
+	    continue;
+	  solver->setFrequencyAttribute(it->first, (rep == "" || solver->solution.count(rep) == 0) ? "0" : solver->solution[rep]);
+	}
+    }
 
   // Attach result to entry point
   if (this->generate_wcet_information)
@@ -27,6 +27,8 @@
 #include "CallGraph.h"
 #include "Generic/Config.h"
 #include "Specific/IPETAnalysis/Solver.h"
+#include "Specific/IPETAnalysis/ILPModel.h"
+#include "Specific/IPETAnalysis/SimplexSolver.h"
 #include "SharedAttributes/SharedAttributes.h"
 
 typedef  vector< long >  VECTOR_WCET;
@@ -40,6 +42,18 @@ typedef  vector< long >  VECTOR_WCET;
 /** WCET for next iteration of BB (integer) attached to nodes */
 #define InternalAttributeWCETnext string("wcet_next")
 
+/** WCET summary of a function in a context (compositional mode):
+    - wcet: bound of every call, the blocks first executions being costed as next executions
+    - once: bound of the first execution extra costs (first misses) of all the calls
+    - frequencies: node frequencies of one call (variable names without the context suffix)
+*/
+typedef struct
+{
+  long wcet;
+  long once;
+  map < string, long > frequencies;
+} t_wcet_summary;
+
 /** WCET computation step using Integer Linear Programming (ILP)
 
     Different computations can be used to integrate the results of
@@ -88,6 +102,29 @@ class IPETAnalysis:public Analysis
   */
   bool generate_wcet_information;
   bool generate_node_frequencies;
+
+  /** Number of threads generating the constraints of the Cfgs (see generateAllConstraints) */
+  int nbthreads;
+
+  /** Reduction of the ILP system before it is solved (see ILPModel), and the reduced system */
+  bool presolve;
+  ILPModel *model;
+
+  /** In-process resolution of the ILP system (see SimplexSolver), the external solver being used when it fails */
+  bool inprocess;
+
+  /** Compositional mode: one ILP system per function and context, solved bottom-up in the call graph.
+      - callees: contexts called from every context
+      - local_constraints, local_objective: constraints and objective function terms of every Cfg, per context suffix
+      - summaries: summaries per signature of the local ILP system (shared by the identical contexts)
+      - context_summaries: summary of every context
+  */
+  bool compositional;
+  map < Context *, vector < Context * > > callees;
+  map < Cfg *, map < string, string > > local_constraints;
+  map < Cfg *, map < string, map < string, long > > > local_objective;
+  map < string, t_wcet_summary > summaries;
+  map < Context *, t_wcet_summary * > context_summaries;
   
   /** String name of the classification attributes for every data cache level. */
   map < int, string > DataCHMC;
@@ -185,6 +222,12 @@ class IPETAnalysis:public Analysis
   */
   void generateConstraints_back_edges_loops(Cfg * c, ostringstream & os, vector < Node * >vn, const ContextList &contexts );
 
+  /**
+    Objective function terms for the branch prediction costs of the loop control branches,
+    for the loops bounded by BranchPredAnalysis (attributes BRPRED_LOOP_*)
+  */
+  void generateConstraints_branch_prediction(Cfg * c, const ContextList &contexts, vector < string > &vid, VECTOR_WCET &vwcet);
+
   /** 
       Check all executed instructions have a cache classification 
   */
@@ -201,6 +244,25 @@ class IPETAnalysis:public Analysis
 
   bool isDeadCode(Cfg * cfg);
 
+  /** Generate the constraints of the Cfgs lcfg (dead code excluded) on nbthreads threads.
+      The constraints and objective function terms of every Cfg are generated in
+      their own buffers, then appended to os, vid and vwcet in the order of lcfg,
+      so that the ILP system does not depend on the number of threads. */
+  void generateAllConstraints(ostringstream & os, vector < Cfg * >&lcfg, vector < string > &vid, VECTOR_WCET &vwcet);
+
+  /** Generate the constraints of the Cfgs lcfg (dead code excluded, returned in live) on nbthreads threads, one buffer per Cfg */
+  void generateCfgConstraints(vector < Cfg * >&lcfg, vector < Cfg * >&live, vector < ostringstream > &vos, vector < vector < string > >&vvid, vector < VECTOR_WCET > &vvwcet);
+
+  /** Compositional mode: computes the WCET of the entry point from the summaries of the functions (and the node frequencies),
+      @return false if a local ILP system is not solved in-process */
+  bool PerformCompositionalAnalysis(vector < Cfg * >&lcfg, string & wcet);
+
+  /** Summary of the function in context (top: the entry point, called once, its first executions are costed as such) */
+  bool summariseContext(Context * context, bool top);
+
+  /** Attaches the node frequencies of context (called nbcalls times) and of its callees */
+  void setCompositionalFrequencies(Context * context, long nbcalls);
+
  public:
 
   /** Constructor
@@ -209,15 +271,20 @@ class IPETAnalysis:public Analysis
       - used_solver: used solver (LP_SOLVE or CPLEX)
       - generate_wcet_info: true if WCET information is attached to the CFG of entry
       - generate_node_freq: true if frequency information is attached to the nodes (one value per execution context) .
+      - nbthreads: number of threads generating the constraints of the Cfgs
+      - presolve: true if the ILP system is reduced before it is solved
+      - inprocess: true if the ILP system is first solved in-process
+      - compositional: true if the WCET is computed from per function and context summaries
   */
   IPETAnalysis(Program * p, int used_solver, bool pipeline, bool generate_wcet_info, bool generate_node_freq, int nb_icache_levels, int nb_dcache_levels, 
-	       map < int, vector < CacheParam * > >&cache_params);
+	       map < int, vector < CacheParam * > >&cache_params, int nbthreads, bool presolve, bool inprocess, bool compositional);
 
   /** Destructor, nothing very exciting in it. */
   ~IPETAnalysis ()
     {
       delete call_graph;
       delete solver;
+      delete model;
     };
     
   /** Check that all attributes required for IPET computations are
@@ -0,0 +1,391 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <cassert>
+#include "Specific/IPETAnalysis/SimplexSolver.h"
+
+// Limits of the in-process resolution, the external solver is used beyond them
+#define SIMPLEX_MAX_NONZEROS 1000000
+#define SIMPLEX_MAX_PIVOTS 50000
+
+SimplexSolver::SimplexSolver()
+{
+  first_artificial = 0;
+  first_phase1 = 0;
+  nbrows = 0;
+  nbcolumns = 0;
+  nbnonzeros = 0;
+  nbpivots = 0;
+  overflow = false;
+  toobig = false;
+}
+
+// ------------------------------------------------------------------
+// Exact rational arithmetic, the intermediate results are computed
+// on 128 bits, overflow is set when a result does not fit on 64 bits.
+// ------------------------------------------------------------------
+static __int128 gcd128(__int128 a, __int128 b)
+{
+  if (a < 0)
+    a = -a;
+  while (b != 0)
+    {
+      __int128 t = a % b;
+      a = b;
+      b = t;
+    }
+  return a;
+}
+
+static bool fits(__int128 v)
+{
+  return v >= (__int128) INT64_MIN && v <= (__int128) INT64_MAX;
+}
+
+static int compare(t_rational a, t_rational b)
+{
+  __int128 l = (__int128) a.num * b.den, r = (__int128) b.num * a.den;
+  return (l < r) ? -1 : ((l > r) ? 1 : 0);
+}
+
+static t_rational mkWide(__int128 num, __int128 den, bool & overflow)
+{
+  t_rational r = { 0, 1 };
+  if (den < 0)
+    {
+      num = -num;
+      den = -den;
+    }
+  if (num != 0 && den != 1)
+    {
+      __int128 g = gcd128(num, den);
+      num = num / g;
+      den = den / g;
+    }
+  if (num == 0)
+    return r;
+  if (!fits(num) || !fits(den))
+    {
+      overflow = true;
+      return r;
+    }
+  r.num = (long long) num;
+  r.den = (long long) den;
+  return r;
+}
+
+t_rational SimplexSolver::mkRational(long long num, long long den)
+{
+  return mkWide(num, den, overflow);
+}
+
+t_rational SimplexSolver::add(t_rational a, t_rational b)
+{
+  if (a.den == 1 && b.den == 1)
+    return mkWide((__int128) a.num + b.num, 1, overflow);
+  return mkWide((__int128) a.num * b.den + (__int128) b.num * a.den, (__int128) a.den * b.den, overflow);
+}
+
+t_rational SimplexSolver::mul(t_rational a, t_rational b)
+{
+  if (a.num == 0 || b.num == 0)
+    return mkRational(0, 1);
+  return mkWide((__int128) a.num * b.num, (__int128) a.den * b.den, overflow);
+}
+
+t_rational SimplexSolver::div(t_rational a, t_rational b)
+{
+  assert(b.num != 0);
+  return mkWide((__int128) a.num * b.den, (__int128) a.den * b.num, overflow);
+}
+
+// ------------------------------------------------------------------
+// Sparse tableau: a coefficient becoming 0 is removed from its row
+// and its column.
+// ------------------------------------------------------------------
+t_rational SimplexSolver::get(unsigned int row, unsigned int column)
+{
+  t_simplex_row::iterator it = rows[row].find(column);
+  if (it == rows[row].end())
+    return mkRational(0, 1);
+  return it->second;
+}
+
+void SimplexSolver::addTo(unsigned int row, unsigned int column, t_rational v)
+{
+  if (v.num == 0)
+    return;
+  t_simplex_row::iterator it = rows[row].find(column);
+  if (it == rows[row].end())
+    {
+      rows[row].insert(make_pair(column, v));
+      columns[column].insert(row);
+      if (++nbnonzeros > SIMPLEX_MAX_NONZEROS)
+	toobig = true;
+      return;
+    }
+  it->second = add(it->second, v);
+  if (it->second.num == 0)
+    {
+      rows[row].erase(it);
+      columns[column].erase(row);
+      nbnonzeros--;
+    }
+}
+
+// ------------------------------------------------------------------
+// Pivot on (row, column), on all the rows (objectives included)
+// ------------------------------------------------------------------
+void SimplexSolver::pivot(unsigned int row, unsigned int column)
+{
+  t_simplex_row & prow = rows[row];
+  t_rational p = prow[column];
+  if (p.num != p.den)
+    for (t_simplex_row::iterator it = prow.begin(); it != prow.end(); it++)
+      it->second = div(it->second, p);
+
+  // The pivot row is copied, the rows of the column being updated while they are visited
+  vector < pair < unsigned int, t_rational > > pentries(prow.begin(), prow.end());
+  vector < unsigned int > targets(columns[column].begin(), columns[column].end());
+  for (unsigned int i = 0; i < targets.size(); i++)
+    {
+      if (targets[i] == row)
+	continue;
+      t_rational f = rows[targets[i]][column];
+      f.num = -f.num;
+      for (unsigned int k = 0; k < pentries.size(); k++)
+	addTo(targets[i], pentries[k].first, mul(f, pentries[k].second));
+    }
+  basis[row] = column;
+  nbpivots++;
+}
+
+// ------------------------------------------------------------------
+// Maximises the objective row obj, the entering column is chosen
+// among the nbcandidates first ones. To limit the fill-in, the
+// entering column is the sparsest one with a negative reduced cost,
+// and the ties of the ratio test go to the shortest row (Bland's rule
+// alone is much slower on large IPET systems). This rule may cycle on
+// degenerate pivots, which are most of the pivots on IPET systems:
+// after as many consecutive degenerate pivots as rows, Bland's rule
+// (lowest entering column, ties to the lowest basic column) is used
+// until the objective increases, which ensures termination.
+// The artificial variables of the equalities to 0 (flow and call
+// constraints) are 0 from the start and are left in the basis, only
+// the other ones are minimised in phase 1, which stops as soon as they
+// are 0. An artificial variable which is 0 must not leave 0 (in phase
+// 2, all of them), so its row bounds the entering column whatever the
+// sign of the coefficient (degenerate pivot).
+// ------------------------------------------------------------------
+bool SimplexSolver::optimise(unsigned int obj, unsigned int nbcandidates)
+{
+  bool phase1 = (obj == nbrows);
+  unsigned int nbdegenerate = 0;
+  while (!overflow && !toobig)
+    {
+      if (phase1 && get(obj, nbcolumns).num == 0)
+	return true;
+      if (nbpivots > SIMPLEX_MAX_PIVOTS)
+	{
+	  toobig = true;
+	  break;
+	}
+      bool bland = (nbdegenerate >= nbrows);
+      unsigned int column = nbcandidates;
+      for (t_simplex_row::iterator it = rows[obj].begin(); it != rows[obj].end() && it->first < nbcandidates; it++)
+	if (it->second.num < 0 && (column == nbcandidates || columns[it->first].size() < columns[column].size()))
+	  {
+	    column = it->first;
+	    if (bland)
+	      break;
+	  }
+      if (column == nbcandidates)
+	return true;
+
+      int row = -1;
+      t_rational best = { 0, 1 };
+      for (set < unsigned int >::iterator it = columns[column].begin(); it != columns[column].end(); it++)
+	{
+	  unsigned int i = *it;
+	  if (i >= nbrows)
+	    continue;
+	  t_rational coef = rows[i][column];
+	  t_rational ratio;
+	  if (basis[i] >= first_artificial && (!phase1 || basis[i] < first_phase1))
+	    ratio = mkRational(0, 1);
+	  else if (coef.num > 0)
+	    ratio = div(get(i, nbcolumns), coef);
+	  else
+	    continue;
+	  int cmp = (row == -1) ? -1 : compare(ratio, best);
+	  if (cmp < 0 || (cmp == 0 && (bland ? basis[i] < basis[row] : rows[i].size() < rows[row].size())))
+	    {
+	      row = i;
+	      best = ratio;
+	    }
+	}
+      if (row == -1)
+	return false;		// unbounded
+      nbdegenerate = (best.num == 0) ? nbdegenerate + 1 : 0;
+      pivot(row, column);
+    }
+  return false;
+}
+
+// ------------------------------------------------------------------
+// Builds the tableau of the system and solves it. When relaxed, the
+// equalities with a non zero rhs (the entry point one in IPET) are
+// relaxed into inequalities: the origin is then feasible and phase 1
+// is not needed. The relaxed optimum is the optimum of the system if
+// it satisfies these equalities (a relaxed equality is satisfied iff
+// its slack variable is 0).
+// ------------------------------------------------------------------
+bool SimplexSolver::run(ILPModel & model, bool relaxed)
+{
+  const map < string, long > &obj = model.getObjective();
+  const vector < t_ilp_constraint > &constraints = model.getConstraints();
+
+  // Columns: variables, slack variables of the inequalities, of the relaxed equalities, then artificial variables
+  index.clear();
+  names.clear();
+  for (map < string, long >::const_iterator it = obj.begin(); it != obj.end(); it++)
+    if (index.insert(make_pair(it->first, names.size())).second)
+      names.push_back(it->first);
+  unsigned int nbslacks = 0, nbrelaxed = 0, nbzeros = 0, nbartificials = 0;
+  unsigned long nbterms = 0;
+  for (unsigned int i = 0; i < constraints.size(); i++)
+    {
+      const t_ilp_constraint & c = constraints[i];
+      for (map < string, long >::const_iterator it = c.terms.begin(); it != c.terms.end(); it++)
+	if (index.insert(make_pair(it->first, names.size())).second)
+	  names.push_back(it->first);
+      nbterms += c.terms.size() + 3;
+      if (!c.equality)
+	nbslacks++;
+      else if (relaxed && c.rhs != 0)
+	nbrelaxed++;
+      // Artificial variable for the equalities and the inequalities ">=" (negative rhs)
+      if (c.equality && c.rhs == 0)
+	nbzeros++;
+      else if (c.equality ? !relaxed : c.rhs < 0)
+	nbartificials++;
+    }
+  // The relaxation is useless if phase 1 is needed anyway
+  if (relaxed && (nbrelaxed == 0 || nbartificials != 0))
+    return false;
+
+  nbrows = constraints.size();
+  unsigned int first_relaxed = names.size() + nbslacks;
+  first_artificial = first_relaxed + nbrelaxed;
+  first_phase1 = first_artificial + nbzeros;
+  nbcolumns = first_phase1 + nbartificials;
+  nbnonzeros = 0;
+  nbpivots = 0;
+  overflow = false;
+  // Size guard on the initial tableau
+  toobig = (nbterms > SIMPLEX_MAX_NONZEROS);
+  if (toobig)
+    return false;
+  rows.assign(nbrows + 2, t_simplex_row());
+  columns.assign(nbcolumns + 1, set < unsigned int >());
+  basis.assign(nbrows, 0);
+
+  unsigned int slack = names.size(), relax = first_relaxed, zero = first_artificial, artificial = first_phase1;
+  unsigned int phase1 = nbrows, phase2 = nbrows + 1;
+  for (unsigned int i = 0; i < nbrows; i++)
+    {
+      const t_ilp_constraint & c = constraints[i];
+      long sign = (c.rhs < 0) ? -1 : 1;
+      for (map < string, long >::const_iterator it = c.terms.begin(); it != c.terms.end(); it++)
+	addTo(i, index[it->first], mkRational(sign * it->second, 1));
+      addTo(i, nbcolumns, mkRational(sign * c.rhs, 1));
+      if (!c.equality)
+	addTo(i, slack++, mkRational(sign, 1));
+      if (c.equality && c.rhs == 0)
+	{
+	  addTo(i, zero, mkRational(1, 1));
+	  basis[i] = zero++;
+	}
+      else if (c.equality && relaxed)
+	{
+	  addTo(i, relax, mkRational(1, 1));
+	  basis[i] = relax++;
+	}
+      else if (c.equality || c.rhs < 0)
+	{
+	  addTo(i, artificial, mkRational(1, 1));
+	  basis[i] = artificial++;
+	  // Phase 1 maximises -sum(artificial variables), expressed with the non basic variables
+	  vector < pair < unsigned int, t_rational > > entries(rows[i].begin(), rows[i].end());
+	  for (unsigned int k = 0; k < entries.size(); k++)
+	    if (entries[k].first < first_artificial || entries[k].first == nbcolumns)
+	      addTo(phase1, entries[k].first, mkRational(-entries[k].second.num, 1));
+	}
+      else
+	basis[i] = slack - 1;
+    }
+  for (map < string, long >::const_iterator it = obj.begin(); it != obj.end(); it++)
+    addTo(phase2, index[it->first], mkRational(-it->second, 1));
+
+  // Phase 1: feasible basis
+  optimise(phase1, first_artificial);
+  if (overflow || toobig || get(phase1, nbcolumns).num != 0)
+    return false;
+
+  // Phase 2: optimum of the objective function
+  if (!optimise(phase2, first_artificial) || overflow || toobig)
+    return false;
+
+  // Relaxed equalities: the slack variables must be 0
+  for (unsigned int i = 0; i < nbrows; i++)
+    if (basis[i] >= first_relaxed && basis[i] < first_artificial && get(i, nbcolumns).num != 0)
+      return false;
+  return true;
+}
+
+bool SimplexSolver::solve(ILPModel & model, map < string, long > &values, long &objective)
+{
+  if (!run(model, true) && (overflow || toobig || !run(model, false)))
+    return false;
+
+  // The solution must be integral
+  t_rational optimum = get(nbrows + 1, nbcolumns);
+  if (optimum.den != 1)
+    return false;
+  objective = optimum.num;
+  values.clear();
+  for (unsigned int j = 0; j < names.size(); j++)
+    values[names[j]] = 0;
+  for (unsigned int i = 0; i < nbrows; i++)
+    if (basis[i] < names.size())
+      {
+	t_rational v = get(i, nbcolumns);
+	if (v.den != 1)
+	  return false;
+	values[names[basis[i]]] = v.num;
+      }
+  return true;
+}
@@ -0,0 +1,116 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef IPET_SIMPLEX_SOLVER_H
+#define IPET_SIMPLEX_SOLVER_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include "Specific/IPETAnalysis/ILPModel.h"
+
+using namespace std;
+
+/** Rational number num/den, with den > 0 and gcd(num, den) = 1 */
+typedef struct
+{
+  long long num, den;
+} t_rational;
+
+/** Sparse row of the tableau: column -> non zero coefficient */
+typedef map < unsigned int, t_rational > t_simplex_row;
+
+/**
+   In-process resolution of the ILP system of IPETAnalysis (inprocess="on").
+
+   It is only used for the methods without pipeline, on systems with
+   no binary variable: flow constraints, loop bounds
+   (n <= maxiter * sum(entry edges)) and call equalities. Their LP
+   relaxation is solved with a two-phase simplex in exact rational
+   arithmetic. The tableau is sparse (rows of non zero coefficients,
+   and the rows of every column), IPET constraints having a few terms
+   each. Phase 1 is skipped when the optimum of the system with its
+   non homogeneous equalities (the entry point one) relaxed into
+   inequalities satisfies them. The solution is kept only if the integer
+   variables (the ones of the objective function) are integral at the
+   optimum, it is then the ILP optimum the external solver would find.
+   Otherwise (or on an arithmetic overflow, an infeasible or unbounded
+   system, a tableau or a number of pivots over the limits) the
+   external solver has to be used.
+
+   When several paths are the worst case, the frequencies of the
+   solution may describe another one than the external solver's: the
+   WCET is the same, the frequencies can differ.
+*/
+class SimplexSolver
+{
+  /** Variables of the system, and their columns */
+  vector < string > names;
+  map < string, unsigned int > index;
+  /** Constraint rows then the two objective rows (phase 1, phase 2), column nbcolumns is the rhs */
+  vector < t_simplex_row > rows;
+  /** Rows with a non zero coefficient, for every column */
+  vector < set < unsigned int > > columns;
+  /** Basic column of every constraint row */
+  vector < unsigned int > basis;
+  /** First artificial column, artificial columns never enter the basis */
+  unsigned int first_artificial;
+  /** First artificial column minimised in phase 1, the previous ones are 0 from the start */
+  unsigned int first_phase1;
+  unsigned int nbrows, nbcolumns;
+  /** Number of non zero coefficients of the tableau, and of pivots */
+  unsigned long nbnonzeros, nbpivots;
+  bool overflow, toobig;
+
+  t_rational mkRational (long long num, long long den);
+  t_rational add (t_rational a, t_rational b);
+  t_rational mul (t_rational a, t_rational b);
+  t_rational div (t_rational a, t_rational b);
+
+  /** Coefficient of the tableau (0 if missing) */
+  t_rational get (unsigned int row, unsigned int column);
+  /** Adds v to the coefficient (row, column), keeping rows and columns sparse */
+  void addTo (unsigned int row, unsigned int column, t_rational v);
+
+  void pivot (unsigned int row, unsigned int column);
+  /** Simplex iterations on the objective row obj, @return false if unbounded */
+  bool optimise (unsigned int obj, unsigned int nbcandidates);
+  /** Builds the tableau (with the non homogeneous equalities relaxed if relaxed) and solves it, @return true on an optimum */
+  bool run (ILPModel & model, bool relaxed);
+
+ public:
+  SimplexSolver ();
+
+  /** Solves the system of model.
+      @return true if an integral optimum is found: values of the variables (0 if missing) and objective value.
+  */
+  bool solve (ILPModel & model, map < string, long > &values, long &objective);
+
+  /** @return true if the last resolution was given up on the size limits */
+  bool isTooBig ()
+  {
+    return toobig;
+  }
+};
+
+#endif
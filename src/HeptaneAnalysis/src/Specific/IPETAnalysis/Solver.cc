@@ -47,6 +47,7 @@ void Solver::setFrequencyAttribute(string VariableName, string freq)
   Node *n;
   string ctxName;
 
+  solution[VariableName] = freq;
   n = analysis->node_ids[VariableName];
   if (n != NULL)
     {
@@ -169,6 +170,22 @@ void LpsolveSolver::generate_equality(ostringstream & os, vector < string > vid,
   os << " = " << N << ";" << endl;
 }
 
+// Generate an equality sum (ids*cst) = N
+void LpsolveSolver::generate_linear_equality(ostringstream & os, vector < string > ids, vector < long >cst, int N)
+{
+  assert(ids.size() == cst.size() && ids.size() > 0);
+  unsigned int nvars = ids.size();
+  for (unsigned int i = 0; i < nvars; i++)
+    {
+      os << cst[i] << "*" << ids[i] << " ";
+      if (i < nvars - 1)
+	os << " + ";
+      else
+	os << " = ";
+    }
+  os << N << ";" << endl;
+}
+
 void LpsolveSolver::generate_int2bin(ostringstream & os, const string & X, const string & q)
 {
   assert(false && "LPSolve doesn't really work well, so I gave up maintaining it");
@@ -358,6 +375,29 @@ void CPLEXSolver::generate_equality(ostringstream & os, vector < string > vid, i
   os << " = " << N << endl;
 }
 
+// Generate an equality sum (ids*cst) = N
+void CPLEXSolver::generate_linear_equality(ostringstream & os, vector < string > ids, vector < long >cst, int N)
+{
+  assert(ids.size() == cst.size() && ids.size() > 0);
+  unsigned int nvars = ids.size();
+  for (unsigned int i = 0; i < nvars; i++)
+    {
+      os << cst[i] << " " << ids[i] << " ";
+      if (i < nvars - 1)
+	{
+	  if (cst[i + 1] >= 0)
+	    os << " + ";
+	  else
+	    os << " ";
+	}
+      else
+	{
+	  os << " = ";
+	}
+    }
+  os << N << endl;
+}
+
 void CPLEXSolver::generate_int2bin(ostringstream & os, const string & X, const string & q)
 {
   os << q << " = 0 -> " << X << " = 0" << endl;
@@ -29,6 +29,8 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <map>
+#include <set>
 #include "SharedAttributes/SharedAttributes.h"
 // #include <libxml/parser.h>  removed because it induces "memory leaks".
 
@@ -43,6 +45,8 @@ class Solver
  protected:
   IPETAnalysis * analysis;
   set<string> binvars;
+  /** Values of the variables in the solution (filled by setFrequencyAttribute) */
+  map<string, string> solution;
  public:
   friend class IPETAnalysis;
   Solver (IPETAnalysis * a):analysis (a)
@@ -84,6 +88,9 @@ class Solver
   /** Generate an inequality: Sum(vids) = N */
   virtual void generate_equality (ostringstream & os, vector < string > vid, int N) = 0;
 
+  /** Generate an equality sum (ids*cst) = N */
+  virtual void generate_linear_equality (ostringstream & os, vector < string > vid, vector < long >cst, int N) = 0;
+
   /** Solve the constraint system */
   virtual bool solve (string file_name, string fout) = 0;
 
@@ -117,6 +124,7 @@ class LpsolveSolver:public Solver
   void generate_inequality (ostringstream & os, vector < string > vid, int N);
   void generate_linear_inequality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_equality (ostringstream & os, vector < string > vid, int N);
+  void generate_linear_equality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_int2bin(ostringstream & os, const string &X, const string &q);
   bool solve (string file_name, string fout);
   bool parse_output (string file_name, string & wcet);
@@ -140,6 +148,7 @@ class CPLEXSolver:public Solver
   void generate_inequality (ostringstream & os, vector < string > vid, int N);
   void generate_linear_inequality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_equality (ostringstream & os, vector < string > vid, int N);
+  void generate_linear_equality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_int2bin(ostringstream & os, const string &X, const string &q);
   bool solve (string file_name, string fout);
   bool parse_output (string file_name, string & wcet);
@@ -62,6 +62,16 @@ unsigned int PipelineAnalysis::getFetchLatency(Instruction & inst, Context * con
   return latency;
 }
 
+void PipelineAnalysis::getFetchLatencies(Node & BB, Context * context, bool first, t_latencies & lat)
+{
+  vector < Instruction * >insts = BB.GetInstructions();
+  for (unsigned int i = 0; i < insts.size(); i++)
+    {
+      if (insts[i]->IsCode())
+	lat.push_back(getFetchLatency(*insts[i], context, first));
+    }
+}
+
 unsigned int PipelineAnalysis::computeBB(Node & BB, Context * context, bool first)
 {
   unsigned int Time = 0;
@@ -72,6 +82,17 @@ unsigned int PipelineAnalysis::computeBB(Node & BB, Context * context, bool firs
 
   if (insts.size() == 0)
     return 0;
+
+  // Reuse the simulation of BB with the same fetch latencies, if any
+  pair < Node *, t_latencies > key(&BB, t_latencies());
+  getFetchLatencies(BB, context, first, key.second);
+  nbLookups++;
+  map < pair < Node *, t_latencies >, unsigned int >::iterator found = bbTimes.find(key);
+  if (found != bbTimes.end())
+    {
+      nbHits++;
+      return found->second;
+    }
   while (!(*it)->IsCode())
     it++;
 
@@ -95,6 +116,7 @@ unsigned int PipelineAnalysis::computeBB(Node & BB, Context * context, bool firs
       delete IP[i];
     }
 
+  bbTimes[key] = Time;
   return Time;
 }
 
@@ -111,34 +133,50 @@ int PipelineAnalysis::Delta(Node * pred, Node * dest, Context * predContext, Con
   if (insts.size() == 0)
     return 0;
 
-  while (!(*it)->IsCode())
-    it++;
-  //schedule first instruction
-  scheduleFirstInst(*(*it), IP, predContext, predOccur);
-
-  //schedule next instructions from the source BB
-  it++;
-  while (it < insts.end())
+  // Reuse the simulation of pred followed by dest with the same fetch latencies, if any
+  pair < pair < Node *, Node * >, t_latencies > key(make_pair(pred, dest), t_latencies());
+  getFetchLatencies(*pred, predContext, predOccur, key.second);
+  getFetchLatencies(*dest, destContext, destOccur, key.second);
+  nbLookups++;
+  map < pair < pair < Node *, Node * >, t_latencies >, unsigned int >::iterator found = pairTimes.find(key);
+  if (found != pairTimes.end())
     {
-      if ((*it)->IsCode())
-	scheduleNextInst(*(*it), IP, predContext, predOccur);
-      it++;
+      nbHits++;
+      Time = found->second;
     }
-  //schedule instruction from the destination BB
-  insts = dest->GetInstructions();
-  it = insts.begin();
-
-  while (it < insts.end())
+  else
     {
-      if ((*it)->IsCode())
-	scheduleNextInst(*(*it), IP, destContext, destOccur);
+      while (!(*it)->IsCode())
+	it++;
+      //schedule first instruction
+      scheduleFirstInst(*(*it), IP, predContext, predOccur);
+
+      //schedule next instructions from the source BB
       it++;
-    }
-  Time = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick;
+      while (it < insts.end())
+	{
+	  if ((*it)->IsCode())
+	    scheduleNextInst(*(*it), IP, predContext, predOccur);
+	  it++;
+	}
+      //schedule instruction from the destination BB
+      insts = dest->GetInstructions();
+      it = insts.begin();
 
-  //delete allocated InstructionPipeline
-  for (unsigned int i = 0; i < IP.size(); i++)
-    delete IP[i];
+      while (it < insts.end())
+	{
+	  if ((*it)->IsCode())
+	    scheduleNextInst(*(*it), IP, destContext, destOccur);
+	  it++;
+	}
+      Time = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick;
+
+      //delete allocated InstructionPipeline
+      for (unsigned int i = 0; i < IP.size(); i++)
+	delete IP[i];
+
+      pairTimes[key] = Time;
+    }
 
   // compute the delta
   string predAttrName;
@@ -204,6 +242,7 @@ int PipelineAnalysis::computeReturnDelta(vector < Node * >endNodes, Node * retur
 {
   PIPELINEDEPTH = 4;
   nbCacheLevel = nbcache;
+  nbLookups = nbHits = 0;
 
   // Fill-in attribute names for the different cache levels
   for (int l = 1; l <= nbCacheLevel; l++)
@@ -442,6 +481,12 @@ bool PipelineAnalysis::PerformAnalysis()
 	  TRACE_PIPELINEANALYSIS(cout << attrName << " = " << time.GetValue() << endl);
 	}
     }
+  if (nbLookups != 0)
+    {
+      stringstream infostr;
+      infostr << "PipelineAnalysis: " << nbHits << " of " << nbLookups << " pipeline simulations reused (hit ratio " << (100.0 * nbHits) / nbLookups << "%)";
+      Logger::addInfo(infostr.str());
+    }
   TRACE_PIPELINEANALYSIS(cout << " PipelineAnalysis::PerformAnalysis () : END " << endl);
   TRACE_PIPELINEANALYSIS(cout << " ############################################################################" << endl);
   return true;
@@ -450,4 +495,6 @@ bool PipelineAnalysis::PerformAnalysis()
 /* Remove all private attributes */
 void PipelineAnalysis::RemovePrivateAttributes()
 {
+  bbTimes.clear();
+  pairTimes.clear();
 }
@@ -45,6 +45,18 @@ class PipelineAnalysis:public Analysis
   map < int, string > CodeCHMC;
   map < int, string > DataCHMC;
 
+  /** Memoization of the pipeline simulations.
+      The only context dependent input of a simulation is the fetch latency of
+      every instruction, so that a simulation is reused for all the contexts
+      and occurences giving the same fetch latencies to the simulated instructions.
+      - bbTimes: (BB, fetch latencies) -> execution time of BB alone
+      - pairTimes: ((pred, dest), fetch latencies of pred then dest) -> execution time of pred followed by dest
+  */
+  typedef vector < unsigned int > t_latencies;
+  map < pair < Node *, t_latencies >, unsigned int > bbTimes;
+  map < pair < pair < Node *, Node * >, t_latencies >, unsigned int > pairTimes;
+  unsigned long nbLookups, nbHits;
+
  protected:
   unsigned int PIPELINEDEPTH;
 
@@ -140,6 +152,12 @@ class PipelineAnalysis:public Analysis
   */
   int computeReturnDelta (vector < Node * >endNodes, Node * returnNode, Context * context, bool Occur);
 
+  /**
+     Append to lat the fetch latency of every code instruction of BB
+     for a context (context) and an occurence (first).
+  */
+  void getFetchLatencies (Node & BB, Context * context, bool first, t_latencies & lat);
+
   /**
      Return true if the set of names contains a register name
   */
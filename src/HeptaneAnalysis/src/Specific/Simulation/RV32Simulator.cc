@@ -0,0 +1,487 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <elf.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include "Specific/Simulation/RV32Simulator.h"
+
+#define PAGE_BITS 12
+#define PAGE_SIZE (1u << PAGE_BITS)
+
+const char *RV32Simulator::opNames[NB_OPS] = {
+  "lui", "auipc", "jal", "jalr",
+  "beq", "bne", "blt", "bge", "bltu", "bgeu",
+  "lb", "lh", "lw", "lbu", "lhu", "sb", "sh", "sw",
+  "addi", "slti", "sltiu", "xori", "ori", "andi", "slli", "srli", "srai",
+  "add", "sub", "sll", "slt", "sltu", "xor", "srl", "sra", "or", "and",
+  "mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu",
+  "fence", "fence.i", "ecall", "ebreak",
+  "csrrw", "csrrs", "csrrc", "csrrwi", "csrrsi", "csrrci",
+  "illegal"
+};
+
+RV32Simulator::RV32Simulator ()
+{
+  pages.resize (1u << (32 - PAGE_BITS), NULL);
+  code_start = code_end = 0;
+  entry_address = 0;
+  outside_block = 0;
+  nb_instructions = nb_cycles = 0;
+  exit_code = 0;
+  for (int i = 0; i < NB_OPS; i++)
+    costs[i] = -1;
+}
+
+RV32Simulator::~RV32Simulator ()
+{
+  for (size_t i = 0; i < pages.size (); i++)
+    delete[] pages[i];
+}
+
+static string hexAddress (uint32_t addr)
+{
+  ostringstream os;
+  os << "0x" << hex << addr;
+  return os.str ();
+}
+
+// -------------------------------------------
+// Memory
+// -------------------------------------------
+uint8_t *RV32Simulator::page (uint32_t addr)
+{
+  uint8_t *&pg = pages[addr >> PAGE_BITS];
+  if (pg == NULL)
+    {
+      pg = new uint8_t[PAGE_SIZE];
+      memset (pg, 0, PAGE_SIZE);
+    }
+  return pg;
+}
+
+uint32_t RV32Simulator::read (uint32_t addr, unsigned int size)
+{
+  uint32_t offset = addr & (PAGE_SIZE - 1);
+  if ((addr & (size - 1)) == 0)
+    {
+      uint8_t *p = page (addr) + offset;
+      if (size == 4) return *(uint32_t *) p;
+      if (size == 2) return *(uint16_t *) p;
+      return *p;
+    }
+  uint32_t value = 0;		// misaligned
+  for (unsigned int i = 0; i < size; i++)
+    value |= (uint32_t) read (addr + i, 1) << (8 * i);
+  return value;
+}
+
+void RV32Simulator::write (uint32_t addr, uint32_t value, unsigned int size)
+{
+  uint32_t offset = addr & (PAGE_SIZE - 1);
+  if ((addr & (size - 1)) == 0)
+    {
+      uint8_t *p = page (addr) + offset;
+      if (size == 4) *(uint32_t *) p = value;
+      else if (size == 2) *(uint16_t *) p = value;
+      else *p = value;
+      return;
+    }
+  for (unsigned int i = 0; i < size; i++)
+    write (addr + i, value >> (8 * i), 1);
+}
+
+// -------------------------------------------
+// ELF loading
+// -------------------------------------------
+bool RV32Simulator::load (const string & file_name)
+{
+  ifstream f (file_name.c_str (), ios::binary);
+  if (!f)
+    {
+      error = "cannot open " + file_name;
+      return false;
+    }
+  vector < char > file ((istreambuf_iterator < char >(f)), istreambuf_iterator < char >());
+  if (file.size () < sizeof (Elf32_Ehdr))
+    {
+      error = file_name + " is not an ELF file";
+      return false;
+    }
+  const Elf32_Ehdr *eh = (const Elf32_Ehdr *) &file[0];
+  if (memcmp (eh->e_ident, ELFMAG, SELFMAG) != 0 || eh->e_ident[EI_CLASS] != ELFCLASS32
+      || eh->e_ident[EI_DATA] != ELFDATA2LSB || eh->e_machine != EM_RISCV)
+    {
+      error = file_name + " is not a 32 bits little endian RISC-V ELF file";
+      return false;
+    }
+  entry_address = eh->e_entry;
+
+  // Segments
+  code_start = 0xFFFFFFFF;
+  code_end = 0;
+  for (unsigned int i = 0; i < eh->e_phnum; i++)
+    {
+      const Elf32_Phdr *ph = (const Elf32_Phdr *) &file[eh->e_phoff + i * eh->e_phentsize];
+      if (ph->p_type != PT_LOAD) continue;
+      if (ph->p_offset + ph->p_filesz > file.size ())
+	{
+	  error = file_name + ": truncated segment";
+	  return false;
+	}
+      for (uint32_t k = 0; k < ph->p_filesz; k++)
+	write (ph->p_vaddr + k, (uint8_t) file[ph->p_offset + k], 1);
+      if (ph->p_flags & PF_X)
+	{
+	  code_start = min (code_start, (uint32_t) ph->p_vaddr);
+	  code_end = max (code_end, (uint32_t) (ph->p_vaddr + ph->p_memsz));
+	}
+    }
+  if (code_start >= code_end)
+    {
+      error = file_name + ": no executable segment";
+      return false;
+    }
+  code_start &= ~3u;
+  code.resize ((code_end - code_start + 3) / 4);
+  for (size_t i = 0; i < code.size (); i++)
+    {
+      code[i] = decode (read (code_start + 4 * i, 4));
+      code[i].block = outside_block;
+      code[i].leader = false;
+    }
+
+  // Symbols
+  for (unsigned int i = 0; i < eh->e_shnum; i++)
+    {
+      const Elf32_Shdr *sh = (const Elf32_Shdr *) &file[eh->e_shoff + i * eh->e_shentsize];
+      if (sh->sh_type != SHT_SYMTAB) continue;
+      const Elf32_Shdr *strtab = (const Elf32_Shdr *) &file[eh->e_shoff + sh->sh_link * eh->e_shentsize];
+      for (uint32_t s = 0; s < sh->sh_size / sizeof (Elf32_Sym); s++)
+	{
+	  const Elf32_Sym *sym = (const Elf32_Sym *) &file[sh->sh_offset + s * sizeof (Elf32_Sym)];
+	  if (sym->st_name != 0)
+	    symbols[string (&file[strtab->sh_offset + sym->st_name])] = sym->st_value;
+	}
+    }
+  return true;
+}
+
+bool RV32Simulator::getSymbol (const string & name, uint32_t & value)
+{
+  map < string, uint32_t >::iterator it = symbols.find (name);
+  if (it == symbols.end ()) return false;
+  value = it->second;
+  return true;
+}
+
+// -------------------------------------------
+// Basic blocks and costs
+// -------------------------------------------
+void RV32Simulator::setNbBlocks (int nbblocks)
+{
+  outside_block = nbblocks;
+  for (size_t i = 0; i < code.size (); i++)
+    code[i].block = outside_block;
+  block_counts.assign (nbblocks + 1, 0);
+  block_cycles.assign (nbblocks + 1, 0);
+}
+
+bool RV32Simulator::addInstruction (uint32_t addr, int block, bool leader)
+{
+  if (addr < code_start || addr >= code_end || (addr & 3) != 0) return false;
+  t_decoded & d = code[(addr - code_start) / 4];
+  d.block = block;
+  d.leader = leader;
+  return true;
+}
+
+void RV32Simulator::setCostFunction (function < int (const string &) > f)
+{
+  cost_function = f;
+}
+
+// -------------------------------------------
+// Decoding
+// -------------------------------------------
+RV32Simulator::t_decoded RV32Simulator::decode (uint32_t instr)
+{
+  t_decoded d;
+  d.op = OP_ILLEGAL;
+  d.rd = (instr >> 7) & 0x1f;
+  d.rs1 = (instr >> 15) & 0x1f;
+  d.rs2 = (instr >> 20) & 0x1f;
+  d.imm = 0;
+  unsigned int funct3 = (instr >> 12) & 7, funct7 = instr >> 25;
+  int32_t imm_i = (int32_t) instr >> 20;
+
+  switch (instr & 0x7f)
+    {
+    case 0x37:
+      d.op = OP_LUI;
+      d.imm = instr & 0xfffff000;
+      break;
+    case 0x17:
+      d.op = OP_AUIPC;
+      d.imm = instr & 0xfffff000;
+      break;
+    case 0x6f:
+      d.op = OP_JAL;
+      d.imm = (((int32_t) instr >> 31) << 20) | (instr & 0xff000) | ((instr >> 9) & 0x800) | ((instr >> 20) & 0x7fe);
+      break;
+    case 0x67:
+      if (funct3 == 0) { d.op = OP_JALR; d.imm = imm_i; }
+      break;
+    case 0x63:
+      {
+	static const uint8_t ops[8] = { OP_BEQ, OP_BNE, OP_ILLEGAL, OP_ILLEGAL, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU };
+	d.op = ops[funct3];
+	d.imm = (((int32_t) instr >> 31) << 12) | ((instr << 4) & 0x800) | ((instr >> 20) & 0x7e0) | ((instr >> 7) & 0x1e);
+	break;
+      }
+    case 0x03:
+      {
+	static const uint8_t ops[8] = { OP_LB, OP_LH, OP_LW, OP_ILLEGAL, OP_LBU, OP_LHU, OP_ILLEGAL, OP_ILLEGAL };
+	d.op = ops[funct3];
+	d.imm = imm_i;
+	break;
+      }
+    case 0x23:
+      {
+	static const uint8_t ops[8] = { OP_SB, OP_SH, OP_SW, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL };
+	d.op = ops[funct3];
+	d.imm = (((int32_t) instr >> 25) << 5) | ((instr >> 7) & 0x1f);
+	break;
+      }
+    case 0x13:
+      {
+	static const uint8_t ops[8] = { OP_ADDI, OP_SLLI, OP_SLTI, OP_SLTIU, OP_XORI, OP_SRLI, OP_ORI, OP_ANDI };
+	d.op = ops[funct3];
+	d.imm = imm_i;
+	if (funct3 == 1 || funct3 == 5)
+	  {
+	    d.imm = d.rs2;	// shift amount
+	    if (funct3 == 5 && funct7 == 0x20) d.op = OP_SRAI;
+	    else if (funct7 != 0) d.op = OP_ILLEGAL;
+	  }
+	break;
+      }
+    case 0x33:
+      if (funct7 == 0)
+	{
+	  static const uint8_t ops[8] = { OP_ADD, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_OR, OP_AND };
+	  d.op = ops[funct3];
+	}
+      else if (funct7 == 0x20)
+	{
+	  if (funct3 == 0) d.op = OP_SUB;
+	  if (funct3 == 5) d.op = OP_SRA;
+	}
+      else if (funct7 == 1)
+	{
+	  static const uint8_t ops[8] = { OP_MUL, OP_MULH, OP_MULHSU, OP_MULHU, OP_DIV, OP_DIVU, OP_REM, OP_REMU };
+	  d.op = ops[funct3];
+	}
+      break;
+    case 0x0f:
+      if (funct3 == 0) d.op = OP_FENCE;
+      if (funct3 == 1) d.op = OP_FENCEI;
+      break;
+    case 0x73:
+      {
+	static const uint8_t ops[8] = { OP_ILLEGAL, OP_CSRRW, OP_CSRRS, OP_CSRRC, OP_ILLEGAL, OP_CSRRWI, OP_CSRRSI, OP_CSRRCI };
+	if (funct3 == 0)
+	  {
+	    if (instr == 0x00000073) d.op = OP_ECALL;
+	    if (instr == 0x00100073) d.op = OP_EBREAK;
+	  }
+	else
+	  {
+	    d.op = ops[funct3];
+	    d.imm = instr >> 20;	// csr number
+	  }
+	break;
+      }
+    }
+  return d;
+}
+
+// -------------------------------------------
+// System calls (Linux/newlib numbers)
+// -------------------------------------------
+bool RV32Simulator::systemCall (t_sim_status & status)
+{
+  const unsigned int a0 = 10, a1 = 11, a2 = 12, a7 = 17;
+  switch (regs[a7])
+    {
+    case 93:			// exit
+      exit_code = regs[a0];
+      status = SIM_EXITED;
+      return false;
+    case 64:			// write
+      for (uint32_t i = 0; i < regs[a2]; i++)
+	cout << (char) read (regs[a1] + i, 1);
+      return true;
+    default:
+      error = "unsupported system call " + to_string (regs[a7]);
+      status = SIM_ERROR;
+      return false;
+    }
+}
+
+// -------------------------------------------
+// Simulation
+// -------------------------------------------
+t_sim_status RV32Simulator::run (uint32_t entry, uint32_t sp, uint64_t maxinstructions)
+{
+  const unsigned int ra = 1, rsp = 2, gp = 3;
+  t_sim_status status = SIM_RETURNED;
+  assert (block_counts.size () == (size_t) outside_block + 1 && cost_function);
+
+  memset (regs, 0, sizeof (regs));
+  regs[ra] = RETURN_ADDRESS;
+  regs[rsp] = sp;
+  uint32_t value;
+  if (getSymbol ("__global_pointer$", value)) regs[gp] = value;
+
+  uint32_t pc = entry;
+  uint64_t count = 0, cycles = 0;
+  t_decoded *decoded = &code[0];
+  size_t nbdecoded = code.size ();
+  uint64_t *counts = &block_counts[0], *bcycles = &block_cycles[0];
+
+  while (true)
+    {
+      uint32_t index = (pc - code_start) >> 2;
+      if (index >= nbdecoded || (pc & 3) != 0)
+	{
+	  if (pc != RETURN_ADDRESS)
+	    {
+	      error = "jump out of the code at " + hexAddress (pc);
+	      status = SIM_ERROR;
+	    }
+	  break;
+	}
+      if (count == maxinstructions)
+	{
+	  status = SIM_LIMIT;
+	  break;
+	}
+      const t_decoded & d = decoded[index];
+      int cost = costs[d.op];
+      if (cost < 0)
+	cost = costs[d.op] = cost_function (opNames[d.op]);
+      count++;
+      cycles += cost;
+      if (d.leader) counts[d.block]++;
+      bcycles[d.block] += cost;
+
+      uint32_t next = pc + 4;
+      uint32_t s1 = regs[d.rs1], s2 = regs[d.rs2];
+      uint32_t *rd = &regs[d.rd];
+      switch (d.op)
+	{
+	case OP_LUI: *rd = d.imm; break;
+	case OP_AUIPC: *rd = pc + d.imm; break;
+	case OP_JAL: *rd = next; next = pc + d.imm; break;
+	case OP_JALR: next = (s1 + d.imm) & ~1u; *rd = pc + 4; break;
+	case OP_BEQ: if (s1 == s2) next = pc + d.imm; break;
+	case OP_BNE: if (s1 != s2) next = pc + d.imm; break;
+	case OP_BLT: if ((int32_t) s1 < (int32_t) s2) next = pc + d.imm; break;
+	case OP_BGE: if ((int32_t) s1 >= (int32_t) s2) next = pc + d.imm; break;
+	case OP_BLTU: if (s1 < s2) next = pc + d.imm; break;
+	case OP_BGEU: if (s1 >= s2) next = pc + d.imm; break;
+	case OP_LB: *rd = (int32_t) (int8_t) read (s1 + d.imm, 1); break;
+	case OP_LH: *rd = (int32_t) (int16_t) read (s1 + d.imm, 2); break;
+	case OP_LW: *rd = read (s1 + d.imm, 4); break;
+	case OP_LBU: *rd = read (s1 + d.imm, 1); break;
+	case OP_LHU: *rd = read (s1 + d.imm, 2); break;
+	case OP_SB: write (s1 + d.imm, s2, 1); break;
+	case OP_SH: write (s1 + d.imm, s2, 2); break;
+	case OP_SW: write (s1 + d.imm, s2, 4); break;
+	case OP_ADDI: *rd = s1 + d.imm; break;
+	case OP_SLTI: *rd = (int32_t) s1 < d.imm; break;
+	case OP_SLTIU: *rd = s1 < (uint32_t) d.imm; break;
+	case OP_XORI: *rd = s1 ^ d.imm; break;
+	case OP_ORI: *rd = s1 | d.imm; break;
+	case OP_ANDI: *rd = s1 & d.imm; break;
+	case OP_SLLI: *rd = s1 << d.imm; break;
+	case OP_SRLI: *rd = s1 >> d.imm; break;
+	case OP_SRAI: *rd = (int32_t) s1 >> d.imm; break;
+	case OP_ADD: *rd = s1 + s2; break;
+	case OP_SUB: *rd = s1 - s2; break;
+	case OP_SLL: *rd = s1 << (s2 & 31); break;
+	case OP_SLT: *rd = (int32_t) s1 < (int32_t) s2; break;
+	case OP_SLTU: *rd = s1 < s2; break;
+	case OP_XOR: *rd = s1 ^ s2; break;
+	case OP_SRL: *rd = s1 >> (s2 & 31); break;
+	case OP_SRA: *rd = (int32_t) s1 >> (s2 & 31); break;
+	case OP_OR: *rd = s1 | s2; break;
+	case OP_AND: *rd = s1 & s2; break;
+	case OP_MUL: *rd = s1 * s2; break;
+	case OP_MULH: *rd = ((int64_t) (int32_t) s1 * (int64_t) (int32_t) s2) >> 32; break;
+	case OP_MULHSU: *rd = ((int64_t) (int32_t) s1 * (int64_t) s2) >> 32; break;
+	case OP_MULHU: *rd = ((uint64_t) s1 * (uint64_t) s2) >> 32; break;
+	case OP_DIV:
+	  if (s2 == 0) *rd = 0xFFFFFFFF;
+	  else if (s1 == 0x80000000 && s2 == 0xFFFFFFFF) *rd = s1;
+	  else *rd = (int32_t) s1 / (int32_t) s2;
+	  break;
+	case OP_DIVU: *rd = (s2 == 0) ? 0xFFFFFFFF : s1 / s2; break;
+	case OP_REM:
+	  if (s2 == 0) *rd = s1;
+	  else if (s1 == 0x80000000 && s2 == 0xFFFFFFFF) *rd = 0;
+	  else *rd = (int32_t) s1 % (int32_t) s2;
+	  break;
+	case OP_REMU: *rd = (s2 == 0) ? s1 : s1 % s2; break;
+	case OP_FENCE:
+	case OP_FENCEI:
+	  break;
+	case OP_CSRRW: case OP_CSRRS: case OP_CSRRC:
+	case OP_CSRRWI: case OP_CSRRSI: case OP_CSRRCI:
+	  // rdcycle/rdtime (0xC00, 0xC01) and rdinstret (0xC02), writes ignored
+	  if (d.imm == 0xC00 || d.imm == 0xC01) *rd = cycles;
+	  else if (d.imm == 0xC02) *rd = count;
+	  else *rd = 0;
+	  break;
+	case OP_ECALL:
+	  if (!systemCall (status)) goto stop;
+	  break;
+	case OP_EBREAK:
+	  status = SIM_EXITED;
+	  goto stop;
+	default:
+	  error = "illegal instruction at " + hexAddress (pc);
+	  status = SIM_ERROR;
+	  goto stop;
+	}
+      regs[0] = 0;
+      pc = next;
+    }
+ stop:
+  nb_instructions = count;
+  nb_cycles = cycles;
+  return status;
+}
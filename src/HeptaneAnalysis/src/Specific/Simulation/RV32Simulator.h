@@ -0,0 +1,141 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef RV32_SIMULATOR_H
+#define RV32_SIMULATOR_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+using namespace std;
+
+/** Outcome of a simulation */
+typedef enum
+{ SIM_RETURNED, SIM_EXITED, SIM_LIMIT, SIM_ERROR } t_sim_status;
+
+/**
+ * Instruction-set simulator of the RV32IM executables built by HeptaneExtract.
+ *
+ * The executable segments are decoded once, the simulation then runs a
+ * switch on the decoded instructions. Every decoded instruction knows the
+ * basic block it belongs to (addInstruction): the simulator counts the
+ * executions of the blocks (on their first instruction) and the cycles
+ * spent in them. The cost of an instruction is given per mnemonic by the
+ * cost function of setCostFunction, asked once per mnemonic actually executed.
+ *
+ * System calls: exit (93) and write (64) on the standard output.
+ * The cycle and instret counters are readable through the csr instructions,
+ * the other csr read as 0. The host is assumed little endian.
+ *
+ * Used by SimulationAnalysis.
+ */
+class RV32Simulator
+{
+ public:
+  /** Decoded operations, in the order of the mnemonics of opNames */
+  typedef enum
+  { OP_LUI, OP_AUIPC, OP_JAL, OP_JALR,
+    OP_BEQ, OP_BNE, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU,
+    OP_LB, OP_LH, OP_LW, OP_LBU, OP_LHU, OP_SB, OP_SH, OP_SW,
+    OP_ADDI, OP_SLTI, OP_SLTIU, OP_XORI, OP_ORI, OP_ANDI, OP_SLLI, OP_SRLI, OP_SRAI,
+    OP_ADD, OP_SUB, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_SRA, OP_OR, OP_AND,
+    OP_MUL, OP_MULH, OP_MULHSU, OP_MULHU, OP_DIV, OP_DIVU, OP_REM, OP_REMU,
+    OP_FENCE, OP_FENCEI, OP_ECALL, OP_EBREAK,
+    OP_CSRRW, OP_CSRRS, OP_CSRRC, OP_CSRRWI, OP_CSRRSI, OP_CSRRCI,
+    OP_ILLEGAL, NB_OPS
+  } t_op;
+
+ private:
+  typedef struct
+  {
+    uint8_t op, rd, rs1, rs2;
+    int32_t imm;
+    int32_t block;		// basic block of the instruction, outside_block if none
+    bool leader;		// first instruction of its basic block
+  } t_decoded;
+
+  /** Memory: 4 KB pages allocated on first access */
+  vector < uint8_t * > pages;
+  uint8_t *page (uint32_t addr);
+  uint32_t read (uint32_t addr, unsigned int size);
+  void write (uint32_t addr, uint32_t value, unsigned int size);
+
+  /** Decoded executable segments [code_start, code_end) */
+  uint32_t code_start, code_end;
+  vector < t_decoded > code;
+  t_decoded decode (uint32_t instr);
+
+  map < string, uint32_t > symbols;
+  uint32_t entry_address;
+
+  /** Cost of the operations (-1: not asked yet) */
+  function < int (const string &) > cost_function;
+  int costs[NB_OPS];
+
+  uint32_t regs[32];
+
+  /** Executes an ecall, @return false if the simulation stops */
+  bool systemCall (t_sim_status & status);
+
+ public:
+  static const char *opNames[NB_OPS];
+
+  /** Return address of the simulated function: the simulation stops there */
+  static const uint32_t RETURN_ADDRESS = 0xFFFFFFFC;
+
+  /** Block of the instructions of no basic block */
+  int outside_block;
+
+  /** Results of the simulation */
+  vector < uint64_t > block_counts;
+  vector < uint64_t > block_cycles;
+  uint64_t nb_instructions, nb_cycles;
+  int exit_code;
+  string error;
+
+  RV32Simulator ();
+  ~RV32Simulator ();
+
+  /** Loads the segments and the symbols of an ELF32 RISC-V executable, @return false on error (see error) */
+  bool load (const string & file_name);
+
+  /** @return true if symbol name is defined, its value in value */
+  bool getSymbol (const string & name, uint32_t & value);
+
+  /** Declares nbblocks basic blocks, numbered from 0 */
+  void setNbBlocks (int nbblocks);
+
+  /** The instruction at addr belongs to block (first instruction if leader). @return false if addr is not in the code */
+  bool addInstruction (uint32_t addr, int block, bool leader);
+
+  /** Cost in cycles of the instructions of a mnemonic */
+  void setCostFunction (function < int (const string &) > f);
+
+  /** Runs the function at entry, with stack pointer sp, until it returns, exits,
+      or maxinstructions instructions are executed */
+  t_sim_status run (uint32_t entry, uint32_t sp, uint64_t maxinstructions);
+};
+
+#endif
@@ -0,0 +1,280 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+#include "Specific/Simulation/SimulationAnalysis.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "arch.h"
+
+// ----------------------
+// SimulationAnalysis class
+// ----------------------
+
+SimulationAnalysis::SimulationAnalysis(Program * p, string vbinary_file, string vtiming_file, int vnbthreads, unsigned long vsp,
+				       string vreport_file, unsigned long long vmax_instructions):Analysis(p)
+{
+  binary_file = vbinary_file;
+  timing_file = vtiming_file;
+  nbthreads = vnbthreads;
+  sp = vsp;
+  report_file = vreport_file;
+  max_instructions = vmax_instructions;
+  default_latency = -1;
+}
+
+// -------------------------------------------------
+// Latencies, one per line, either mnemonic,cycles
+// or "mnemonic" : cycles. Lines starting with # and
+// the lines without a number (csv header) are skipped.
+// -------------------------------------------------
+bool SimulationAnalysis::readTimingFile()
+{
+  ifstream f(timing_file.c_str());
+  if (!f)
+    return false;
+  string line;
+  while (getline(f, line))
+    {
+      if (line.empty() || line[0] == '#')
+	continue;
+      size_t sep = line.find_first_of(",:");
+      if (sep == string::npos)
+	continue;
+      string mnemonic, value = line.substr(sep + 1);
+      for (size_t i = 0; i < sep; i++)
+	if (!isspace(line[i]) && line[i] != '"')
+	  mnemonic += tolower(line[i]);
+      istringstream is(value);
+      int cycles;
+      if (mnemonic.empty() || !(is >> cycles))
+	continue;
+      if (mnemonic == "_default_value_")
+	default_latency = cycles;
+      else
+	latencies[mnemonic] = cycles;
+    }
+  return true;
+}
+
+// -------------------------------------------------
+// Cost of a mnemonic: its latency, rounded up to a
+// multiple of the period of the thread interleaving
+// -------------------------------------------------
+int SimulationAnalysis::getCost(const string & mnemonic)
+{
+  int latency;
+  if (timing_file == "")
+    latency = Arch::getLatency(mnemonic);
+  else
+    {
+      map < string, int >::iterator it = latencies.find(mnemonic);
+      if (it != latencies.end())
+	latency = it->second;
+      else if (default_latency >= 0)
+	latency = default_latency;
+      else
+	{
+	  Logger::addFatal("SIMULATION: no timing for instruction " + mnemonic + " in " + timing_file);
+	  latency = 1;
+	}
+    }
+  return nbthreads * ((max(latency, 1) + nbthreads - 1) / nbthreads);
+}
+
+// -------------------------------------------------
+// Checks the code addresses
+// -------------------------------------------------
+bool SimulationAnalysis::CheckInputAttributes()
+{
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      if (lcfg[c]->IsExternal() || lcfg[c]->IsEmpty())
+	continue;
+      vector < Node * >vn = lcfg[c]->GetAllNodes();
+      for (size_t n = 0; n < vn.size(); n++)
+	{
+	  vector < Instruction * >vi = vn[n]->GetAsm();
+	  for (size_t i = 0; i < vi.size(); i++)
+	    if (!vi[i]->HasAttribute(AddressAttributeName))
+	      {
+		Logger::addError("SIMULATION: instruction without address in " + lcfg[c]->getStringName());
+		return false;
+	      }
+	}
+    }
+  return true;
+}
+
+// -------------------------------------------------
+// Simulation of the entry point, observed counts
+// and cycles attached to the nodes and compared to
+// the bounds of the IPET analysis in report_file
+// -------------------------------------------------
+bool SimulationAnalysis::PerformAnalysis()
+{
+  RV32Simulator sim;
+  if (!sim.load(binary_file))
+    {
+      Logger::addError("SIMULATION: " + sim.error);
+      return false;
+    }
+  if (timing_file != "" && !readTimingFile())
+    {
+      Logger::addError("SIMULATION: cannot open the timing file " + timing_file);
+      return false;
+    }
+  sim.setCostFunction([this] (const string & mnemonic) { return getCost(mnemonic); });
+
+  // Basic blocks of the simulator: the nodes of all the cfgs
+  vector < Node * >nodes;
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      if (lcfg[c]->IsExternal() || lcfg[c]->IsEmpty())
+	continue;
+      vector < Node * >vn = lcfg[c]->GetAllNodes();
+      for (size_t n = 0; n < vn.size(); n++)
+	if (vn[n]->GetAsm().size() != 0)
+	  nodes.push_back(vn[n]);
+    }
+  sim.setNbBlocks(nodes.size());
+  for (size_t n = 0; n < nodes.size(); n++)
+    {
+      vector < Instruction * >vi = nodes[n]->GetAsm();
+      for (size_t i = 0; i < vi.size(); i++)
+	{
+	  t_address addr = ((AddressAttribute &) vi[i]->GetAttribute(AddressAttributeName)).getCodeAddress();
+	  if (!sim.addInstruction(addr, n, i == 0))
+	    {
+	      Logger::addError("SIMULATION: " + binary_file + " is not the binary of the analysed program (no code at " + vi[i]->GetCode() + ")");
+	      return false;
+	    }
+	}
+    }
+
+  Cfg *entry = p->GetEntryPoint();
+  uint32_t entry_address;
+  if (!sim.getSymbol(entry->getStringName(), entry_address))
+    {
+      Logger::addError("SIMULATION: no symbol " + entry->getStringName() + " in " + binary_file);
+      return false;
+    }
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  t_sim_status status = sim.run(entry_address, sp, max_instructions);
+  double seconds = chrono::duration < double >(chrono::steady_clock::now() - start).count();
+  if (status == SIM_ERROR)
+    {
+      Logger::addError("SIMULATION: " + sim.error + " after " + to_string(sim.nb_instructions) + " instructions");
+      return false;
+    }
+  if (status == SIM_LIMIT)
+    Logger::addWarning("SIMULATION: stopped after " + to_string(sim.nb_instructions) + " instructions (maxinstructions)");
+
+  ostringstream info;
+  info << "SIMULATION: " << sim.nb_instructions << " instructions, " << sim.nb_cycles << " cycles";
+  if (seconds > 0)
+    info << " (" << (unsigned long) (sim.nb_instructions / seconds / 1e6) << " MIPS)";
+  Logger::addInfo(info.str());
+  if (entry->HasAttribute(WCETAttributeName))
+    {
+      string wcet = ((SerialisableStringAttribute &) entry->GetAttribute(WCETAttributeName)).GetValue();
+      ostringstream ratio;
+      ratio << "SIMULATION: observed " << sim.nb_cycles << " cycles, WCET bound " << wcet << " cycles";
+      if (sim.nb_cycles > 0)
+	ratio << " (bound/observed " << atof(wcet.c_str()) / sim.nb_cycles << ")";
+      Logger::addInfo(ratio.str());
+      if (sim.nb_cycles > strtoull(wcet.c_str(), NULL, 10))
+	Logger::addWarning("SIMULATION: observed cycles exceed the WCET bound");
+    }
+
+  // Observed executions and cycles of the nodes, next to their frequencies
+  // on the worst-case path (which a node may legitimately exceed when the
+  // observed path is not the worst-case one)
+  ofstream report;
+  if (report_file != "")
+    {
+      report.open(report_file.c_str());
+      if (!report)
+	{
+	  Logger::addError("SIMULATION: cannot open " + report_file);
+	  return false;
+	}
+      report << "node_id,function,address,observed_count,wcet_path_count,observed_cycles" << endl;
+    }
+  for (size_t n = 0; n < nodes.size(); n++)
+    {
+      Node *node = nodes[n];
+      SerialisableUnsignedLongAttribute count(sim.block_counts[n]), cycles(sim.block_cycles[n]);
+      node->SetAttribute(ObservedFrequencyAttributeName, count);
+      node->SetAttribute(ObservedCyclesAttributeName, cycles);
+
+      // Worst-case path frequency: sum over the contexts (IPET, generate_node_freq)
+      Cfg *c = node->GetCfg();
+      bool bounded = false;
+      unsigned long long bound = 0;
+      if (c->HasAttribute(ContextListAttributeName))
+	{
+	  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
+	  for (size_t ic = 0; ic < contexts.size(); ic++)
+	    {
+	      string name = AnalysisHelper::getContextAttrFrequencyName(contexts[ic]->getStringId());
+	      if (node->HasAttribute(name))
+		{
+		  bounded = true;
+		  bound += ((SerialisableUnsignedLongAttribute &) node->GetAttribute(name)).GetValue();
+		}
+	    }
+	}
+      if (report_file != "")
+	report << node->getIdentifier() << "," << c->getStringName() << "," << AnalysisHelper::getStartAddress(node) << ","
+	       << sim.block_counts[n] << "," << (bounded ? to_string(bound) : string("")) << "," << sim.block_cycles[n] << endl;
+    }
+  if (report_file != "")
+    report << "outside,,," << sim.block_counts[nodes.size()] << ",," << sim.block_cycles[nodes.size()] << endl;
+  return true;
+}
+
+// -------------------------------------------------
+// The observed counts are kept (serialised)
+// -------------------------------------------------
+void SimulationAnalysis::RemovePrivateAttributes()
+{
+}
+
+void SimulationAnalysis::GetAttributeDependencies(set < string > &reads, set < string > &writes)
+{
+  reads.insert(CodeAddressSlot);
+  reads.insert(ContextListAttributeName);
+  reads.insert(string(FrequencyAttributeName) + "*");
+  reads.insert(WCETAttributeName);
+  writes.insert(ObservedFrequencyAttributeName);
+  writes.insert(ObservedCyclesAttributeName);
+}
@@ -0,0 +1,93 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef SIMULATION_ANALYSIS_H
+#define SIMULATION_ANALYSIS_H
+
+#include <map>
+#include <string>
+#include "Analysis.h"
+#include "Specific/Simulation/RV32Simulator.h"
+
+/**
+ * Simulation of the analysed executable (SIMULATION directive, RISCV only),
+ * to measure the tightness of the WCET bound.
+ *
+ * The entry point is run on an RV32IM instruction-set simulator
+ * (RV32Simulator) until it returns. Every node gets the number of times it
+ * was executed (ObservedFrequency) and the cycles spent in it (ObservedCycles),
+ * and the observed executions are written next to the bounds of the IPET
+ * analysis (frequency attributes of all the contexts) in report_file.
+ *
+ * Cycle model (FlexPRET): the cost of an instruction is read per mnemonic in
+ * timing_file, either in the fp_inst_timing.csv format (mnemonic,cycles) or
+ * in the format of the latency files of the data directory ("mnemonic" : cycles,
+ * _DEFAULT_VALUE_ for the others). Without timing_file, the latencies of the
+ * architecture are used. With nbthreads hardware threads interleaved round-robin,
+ * the analysed thread issues an instruction every nbthreads cycles: an
+ * instruction of latency L costs nbthreads * ceil(L / nbthreads) cycles.
+ *
+ * Used in:
+ *  - GNUmakefile
+ *  - Generic/Config.h
+ *  - Generic/Config.cc
+ */
+class SimulationAnalysis:public Analysis
+{
+ private:
+  string binary_file;
+  string timing_file;
+  int nbthreads;
+  unsigned long sp;
+  string report_file;
+  unsigned long long max_instructions;
+
+  /** Latencies of timing_file, by mnemonic (lower case) */
+  map < string, int > latencies;
+  int default_latency;
+
+  /** Reads timing_file, @return false on error */
+  bool readTimingFile ();
+
+  /** @return the cost of the instructions of a mnemonic with the thread interleaving */
+  int getCost (const string & mnemonic);
+
+ public:
+
+  /** Constructor */
+  SimulationAnalysis (Program * p, string vbinary_file, string vtiming_file, int vnbthreads, unsigned long vsp,
+		      string vreport_file, unsigned long long vmax_instructions);
+
+  /** Checks if all required attributes are in the CFG (code addresses) */
+  bool CheckInputAttributes ();
+
+  /** Performs the analysis */
+  bool PerformAnalysis ();
+
+  /** Remove all private attributes */
+  void RemovePrivateAttributes ();
+
+  /** Attribute slots read and written by the analysis (see Analysis::GetAttributeDependencies) */
+  void GetAttributeDependencies (set < string > &reads, set < string > &writes);
+};
+
+#endif
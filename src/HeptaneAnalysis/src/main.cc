@@ -32,9 +32,11 @@ See CREDITS.txt for credits of authorship
 #include <stdexcept>
 #include <assert.h>
 #include <sys/time.h>
+#include <sys/resource.h>
 
 #include "Logger.h"
 #include "Generic/Config.h"
+#include "Generic/AnalysisServer.h"
 #include "Generic/Analysis.h"
 #include "SharedAttributes/SharedAttributes.h"
 #include "Specific/CacheAnalysis/ICacheAnalysis.h"
@@ -194,6 +196,14 @@ main (int argc, char **argv)
 {
   string configFile;
   bool printTime = true;
+  bool server = false;
+
+  // Server mode: the configuration files come with the requests (see Generic/AnalysisServer.h)
+  if (argc >= 2 && string (argv[argc - 1]) == "-server")
+    {
+      server = true;
+      argc--;
+    }
 
   if (argc == 3)
     {
@@ -206,13 +216,14 @@ main (int argc, char **argv)
 	cout << "Unknown option " << argv[1] << "...ignored " << endl;
     }
   else
-    if (argc != 2)
+    if (argc != 2 && !(server && argc == 1))
       {
-	cerr <<  "Usage " << string (argv[0]) << " <configfilename.xml>" << endl;
+	cerr <<  "Usage " << string (argv[0]) << " [-t] <configfilename.xml>" << endl;
+	cerr <<  "      " << string (argv[0]) << " [-t] -server" << endl;
 	exit (-1);
       }
   
-  configFile = string (argv[argc-1]);
+  if (!server) configFile = string (argv[argc-1]);
   
   // Initialisation code (do not remove, useful to create serialisation code
   // for attribute types not supported by cfglib
@@ -226,6 +237,14 @@ main (int argc, char **argv)
   af->SetAttributeType (ContextTreeAttributeName, new ContextTree ());
   af->SetAttributeType (MetaInstructionAttributeName, new MetaInstructionAttribute ());
 
+  if (server)
+    {
+      AnalysisServer ().serve (cin, cout);
+      Logger::kill ();
+      delete config;
+      return 0;
+    }
+
   Timer timer_AllAnalysis;
   float time = 0.0;
   timer_AllAnalysis.initTimer();
@@ -255,6 +274,11 @@ main (int argc, char **argv)
       stringstream infostr;
       infostr << " =======> Total Time = "  << time;
       Logger::addInfo(infostr.str());
+      struct rusage usage;
+      getrusage (RUSAGE_SELF, &usage);
+      stringstream memstr;
+      memstr << " =======> Maximum resident set size (kB) = " << usage.ru_maxrss;
+      Logger::addInfo(memstr.str());
       Logger::print();
     }
 
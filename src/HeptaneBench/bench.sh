@@ -0,0 +1,152 @@
+#!/bin/bash
+
+#---------------------------------------------------------------------
+#
+# Copyright IRISA, 2003-2017
+#
+# This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+# estimation.
+# APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+#
+# Heptane is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Heptane is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details (COPYING.txt).
+#
+# See CREDITS.txt for credits of authorship
+#
+#---------------------------------------------------------------------
+
+# Scaling benchmarks of HeptaneAnalysis.
+#
+# For every scale given as argument (small, medium, large; all of them
+# by default), a synthetic RISCV program is generated by HeptaneGenerate
+# and analysed by HeptaneAnalysis (ICACHE, DATAADDRESS, DCACHE, PIPELINE,
+# IPET). The time of every analysis step, the total time and the maximum
+# resident set size are reported in ${BENCH_DIR}/bench.txt.
+#
+# When the RISCV cross compiler is installed, the extraction of a few
+# classic benchmarks is timed too.
+#
+# Environment:
+#   BENCH_DIR     output directory (default /tmp/heptane-bench)
+#   BENCH_SOLVER  ILP solver used by the IPET analysis (default lp_solve)
+
+HEPTANE_DIR=$(cd "$(dirname "$0")/../.." && pwd)
+OUT=${BENCH_DIR:-/tmp/heptane-bench}
+SOLVER=${BENCH_SOLVER:-lp_solve}
+EXTRACT_BENCHS="fir matmult nsichneu statemate"
+
+function scale_options {
+    case $1 in
+	small)  echo "-functions 8 -depth 3 -loops 2 -nesting 2 -blocks 4 -bbsize 6" ;;
+	medium) echo "-functions 16 -depth 4 -loops 3 -nesting 2 -blocks 5 -bbsize 8" ;;
+	large)  echo "-functions 32 -depth 5 -loops 3 -nesting 3 -blocks 6 -bbsize 8" ;;
+	*) return 1 ;;
+    esac
+}
+
+# Elapsed seconds since $1 (date +%s.%N)
+function elapsed {
+    echo "$(date +%s.%N) $1" | awk '{ printf "%.3f", $1 - $2 }'
+}
+
+function write_config {
+    cat > $1/config.xml <<EOF
+<?xml version="1.0"?>
+<!DOCTYPE CONFIGURATION SYSTEM "config.dtd">
+<CONFIGURATION>
+<INPUTOUTPUTDIR name="$1"/>
+<ARCHITECTURE>
+<TARGET NAME="RISCV" ENDIANNESS="LITTLE" DATAPATH="${HEPTANE_DIR}/data"/>
+<CACHE nbsets="32" nbways="2" cachelinesize="32" replacement_policy="LRU" type="icache" level="1" latency="1"/>
+<CACHE nbsets="32" nbways="2" cachelinesize="32" replacement_policy="LRU" type="dcache" level="1" latency="1"/>
+<MEMORY load_latency="100" store_latency="100"/>
+</ARCHITECTURE>
+<ANALYSIS>
+<ENTRYPOINT keepresults="on" input_file="$2.xml" output_file="" entrypointname="main"/>
+<ICACHE keepresults="on" input_file="" output_file="" level="1" must="on" persistence="on" may="on"/>
+<DATAADDRESS keepresults="on" input_file="" output_file="" sp="7FFFE000"/>
+<DCACHE keepresults="on" input_file="" output_file="" level="1" must="on" persistence="on" may="on"/>
+<PIPELINE keepresults="on" input_file="" output_file=""/>
+<IPET keepresults="on" input_file="" output_file="res.xml" solver="${SOLVER}" pipeline="on" attach_WCET_info="on" generate_node_freq="on"/>
+</ANALYSIS>
+</CONFIGURATION>
+EOF
+}
+
+SCALES=$*
+if [ -z "$SCALES" ]
+then
+    SCALES="small medium large"
+fi
+for scale in $SCALES
+do
+    if ! scale_options $scale > /dev/null
+    then
+	echo "Usage: $0 [small] [medium] [large]"
+	exit 1
+    fi
+done
+
+if [ ! -x ${HEPTANE_DIR}/bin/HeptaneGenerate ] || [ ! -x ${HEPTANE_DIR}/bin/HeptaneAnalysis ]
+then
+    echo ">>> ERROR: HeptaneGenerate and HeptaneAnalysis must be built first (make -C ${HEPTANE_DIR}/src)"
+    exit 1
+fi
+
+mkdir -p ${OUT}
+REPORT=${OUT}/bench.txt
+rm -f ${REPORT}
+
+for scale in $SCALES
+do
+    DIR=${OUT}/${scale}
+    mkdir -p ${DIR}
+    ${HEPTANE_DIR}/bin/HeptaneGenerate -datapath ${HEPTANE_DIR}/data $(scale_options $scale) ${DIR}/${scale}.xml > ${DIR}/generate.log
+    if [ $? -ne 0 ]
+    then
+	echo ">>> ERROR: generation of the ${scale} program failed (see ${DIR}/generate.log)"
+	exit 1
+    fi
+    write_config ${DIR} ${scale}
+
+    echo "Analysing the ${scale} program ..."
+    (cd ${DIR} && ${HEPTANE_DIR}/bin/HeptaneAnalysis config.xml > analysis.log 2>&1)
+    status=$?
+
+    {
+	echo "=== ${scale}: $(scale_options $scale)"
+	grep "^Number of" ${DIR}/generate.log | sed -e "s/^/    /"
+	if [ $status -ne 0 ]
+	then
+	    echo "    analysis failed (status ${status}, see ${DIR}/analysis.log)"
+	else
+	    grep "\*\*\*\*\*\*\*\* " ${DIR}/analysis.log | sed -e "s/^.*\*\*\*\*\*\*\*\* /    /"
+	    grep "=======>" ${DIR}/analysis.log | sed -e "s/^.*=======> /    /"
+	fi
+    } | tee -a ${REPORT}
+done
+
+{
+    echo "=== extraction (RISCV)"
+    if ls ${HEPTANE_DIR}/CROSS_COMPILERS/RISCV/bin/*gcc > /dev/null 2>&1
+    then
+	cd ${HEPTANE_DIR}
+	for bench in ${EXTRACT_BENCHS}
+	do
+	    start=$(date +%s.%N)
+	    ./extract.sh ${bench} main RISCV bench > ${OUT}/extract_${bench}.log 2>&1
+	    echo "    ${bench}: $(elapsed $start) s"
+	done
+    else
+	echo "    skipped, no RISCV cross compiler in ${HEPTANE_DIR}/CROSS_COMPILERS"
+    fi
+} | tee -a ${REPORT}
+
+echo "Report written to ${REPORT}"
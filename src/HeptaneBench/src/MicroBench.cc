@@ -0,0 +1,415 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/* -----------------------------------------------------
+   Micro-benchmarks of the inner kernels of the analyses:
+   the abstract cache sets (MUST, MAY, PS), the abstract
+   caches and the constraint generation of the ILP solvers.
+   Every kernel is timed in isolation and reported in
+   ns/op and allocations/op.
+   -------------------------------------------------------- */
+
+#include <string>
+#include <vector>
+#include <set>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+#include <chrono>
+#include "Specific/CacheAnalysis/Cache.h"
+#include "Specific/IPETAnalysis/Solver.h"
+
+/** Number of allocations since the start (global operator new, single threaded) */
+static unsigned long long nb_allocations = 0;
+
+void *operator new (size_t size)
+{
+  nb_allocations++;
+  void *p = malloc (size ? size : 1);
+  if (p == NULL)
+    throw std::bad_alloc ();
+  return p;
+}
+
+// Not inlined: at -O2, gcc would see free() called on the result of operator new (-Wmismatched-new-delete)
+__attribute__ ((noinline)) void operator delete (void *p) noexcept
+{
+  free (p);
+}
+
+__attribute__ ((noinline)) void operator delete (void *p, size_t) noexcept
+{
+  free (p);
+}
+
+/** Minimal time of a measure (ms) and kernels to be measured (substring of their names) */
+static unsigned int min_time = 100;
+static string filter;
+
+/** Kept results, so that the compiler does not drop the measured code */
+static unsigned long long sink = 0;
+
+/** Number of operations between two reads of the clock */
+#define MEASURE_BATCH 256
+
+/** Time op(i) for i = 0, 1, ... during min_time ms at least and report it as name/params */
+template < typename F > static void measure (const string & name, const string & params, F op)
+{
+  if (name.find (filter) == string::npos)
+    return;
+
+  for (unsigned int i = 0; i < MEASURE_BATCH; i++)	// warm-up
+    op (i);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now ();
+  unsigned long long allocations = nb_allocations;
+  unsigned long long nbops = 0;
+  double elapsed;
+  do
+    {
+      for (unsigned int i = 0; i < MEASURE_BATCH; i++)
+	op (nbops++);
+      elapsed = chrono::duration < double, nano > (chrono::steady_clock::now () - start).count ();
+    }
+  while (elapsed < min_time * 1e6);
+  allocations = nb_allocations - allocations;
+
+  cout << left << setw (36) << name << setw (40) << params << right << fixed
+       << setw (12) << setprecision (1) << elapsed / nbops << " ns/op"
+       << setw (10) << setprecision (2) << (double) allocations / nbops << " allocs/op" << endl;
+}
+
+/** Linear congruential generator, for reproducible inputs */
+static unsigned int seed = 1;
+static unsigned int draw (unsigned int n)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) % n;
+}
+
+/** Empty abstract cache sets */
+template < typename T > T emptySet (unsigned int nbways, t_replacement_policy policy);
+
+template <> MUST emptySet < MUST > (unsigned int nbways, t_replacement_policy policy)
+{
+  return MUST (nbways, policy);
+}
+
+template <> MAY emptySet < MAY > (unsigned int nbways, t_replacement_policy policy)
+{
+  return MAY (nbways);
+}
+
+template <> PS emptySet < PS > (unsigned int nbways, t_replacement_policy policy)
+{
+  return PS (nbways, policy);
+}
+
+/** Empty abstract caches */
+template < typename T > AbstractCache < T > emptyCache (unsigned int nbsets, unsigned int nbways, t_replacement_policy policy, unsigned int linesize)
+{
+  return AbstractCache < T > (nbsets, nbways, policy, linesize);
+}
+
+template <> AbstractCache < MAY > emptyCache < MAY > (unsigned int nbsets, unsigned int nbways, t_replacement_policy policy, unsigned int linesize)
+{
+  return AbstractCache < MAY > (nbsets, nbways, linesize);
+}
+
+static string policyName (t_replacement_policy policy)
+{
+  switch (policy)
+    {
+    case LRU: return "LRU";
+    case PLRU: return "PLRU";
+    case MRU: return "MRU";
+    case FIFO: return "FIFO";
+    default: return "?";
+    }
+}
+
+/** Number of inputs (accesses, block sets, states) prepared for a measure, a power of 2 */
+#define NB_INPUTS 1024
+
+/** Update, Join, Equals of the abstract cache sets of type T (name) for an associativity and a policy.
+    The accesses are drawn among 2*nbways conflicting cache lines. */
+template < typename T > static void benchCacheSet (const string & name, unsigned int nbways, t_replacement_policy policy, const vector < unsigned int >&blocksizes)
+{
+  const unsigned int linesize = 32;
+  ostringstream params;
+  params << "ways=" << nbways << " policy=" << policyName (policy);
+
+  vector < t_address > accesses;
+  for (unsigned int i = 0; i < NB_INPUTS; i++)
+    accesses.push_back (draw (2 * nbways) * 64 * linesize);
+
+  // States reached by random accesses, and equal copies built independently
+  vector < T > states, copies;
+  for (unsigned int i = 0; i < NB_INPUTS; i++)
+    {
+      T s = emptySet < T > (nbways, policy), c = emptySet < T > (nbways, policy);
+      unsigned int start = draw (NB_INPUTS);
+      for (unsigned int j = 0; j < 2 * nbways; j++)
+	{
+	  s.Update (accesses[(start + j) % NB_INPUTS]);
+	  c.Update (accesses[(start + j) % NB_INPUTS]);
+	}
+      states.push_back (s);
+      copies.push_back (c);
+    }
+
+  T current = states[0];
+  measure (name + "::Update", params.str (),[&](unsigned long long i)
+	   {
+	     current.Update (accesses[i % NB_INPUTS]);
+	   });
+
+  for (size_t b = 0; b < blocksizes.size (); b++)
+    {
+      vector < set < t_address > > blocks (NB_INPUTS);
+      for (unsigned int i = 0; i < NB_INPUTS; i++)
+	while (blocks[i].size () < min (blocksizes[b], 2 * nbways))
+	  blocks[i].insert (accesses[draw (NB_INPUTS)]);
+      ostringstream bparams;
+      bparams << params.str () << " blocks=" << blocksizes[b];
+      // The state is reset at each batch: repeated updates would reach a fixpoint (e.g. an empty MUST set)
+      measure (name + "::Update(set)", bparams.str (),[&](unsigned long long i)
+	       {
+		 if (i % MEASURE_BATCH == 0)
+		   current = states[(i / MEASURE_BATCH) % NB_INPUTS];
+		 current.Update (blocks[i % NB_INPUTS]);
+	       });
+    }
+
+  measure (name + "::copy", params.str (),[&](unsigned long long i)
+	   {
+	     T result (states[i % NB_INPUTS]);
+	     sink += result.Absent (accesses[i % NB_INPUTS]);
+	   });
+
+  measure (name + "::Join", params.str () + " (copy incl.)",[&](unsigned long long i)
+	   {
+	     T result (states[i % NB_INPUTS]);
+	     result.Join (states[(i * 7 + 1) % NB_INPUTS]);
+	     sink += result.Absent (accesses[i % NB_INPUTS]);
+	   });
+
+  // Equal sets are the worst case (every line compared), alternate them with distinct ones
+  measure (name + "::Equals", params.str (),[&](unsigned long long i)
+	   {
+	     const T & other = (i & 1) ? copies[i % NB_INPUTS] : states[(i + 1) % NB_INPUTS];
+	     sink += states[i % NB_INPUTS].Equals (other);
+	   });
+
+  measure (name + "::Hash", params.str (),[&](unsigned long long i)
+	   {
+	     sink += states[i % NB_INPUTS].Hash ();
+	   });
+}
+
+/** Update(set), Join, Equals of the abstract caches of type T (name) for a number of sets.
+    The block sets are ranges of consecutive cache lines, as the accesses to arrays. */
+template < typename T > static void benchAbstractCache (const string & name, unsigned int nbsets, unsigned int nbways, t_replacement_policy policy, const vector < unsigned int >&blocksizes)
+{
+  const unsigned int linesize = 32;
+  const unsigned int nblines = 4 * nbsets * nbways;
+  ostringstream params;
+  params << "sets=" << nbsets << " ways=" << nbways << " policy=" << policyName (policy);
+
+  vector < AbstractCache < T > > states;
+  for (unsigned int i = 0; i < 64; i++)
+    {
+      AbstractCache < T > acs = emptyCache < T > (nbsets, nbways, policy, linesize);
+      for (unsigned int j = 0; j < nbsets * nbways; j++)
+	acs.Update (draw (nblines) * linesize, "A");
+      states.push_back (acs);
+    }
+
+  for (size_t b = 0; b < blocksizes.size (); b++)
+    {
+      vector < set < t_address > > blocks (NB_INPUTS);
+      for (unsigned int i = 0; i < NB_INPUTS; i++)
+	{
+	  unsigned int first = draw (nblines);
+	  for (unsigned int j = 0; j < blocksizes[b]; j++)
+	    blocks[i].insert ((first + j) * linesize);
+	}
+      ostringstream bparams;
+      bparams << params.str () << " blocks=" << blocksizes[b];
+      AbstractCache < T > current = states[0];
+      measure (name + "::Update(set)", bparams.str (),[&](unsigned long long i)
+	       {
+		 if (i % MEASURE_BATCH == 0)
+		   current = states[(i / MEASURE_BATCH) % 64];
+		 current.Update (blocks[i % NB_INPUTS], "A");
+	       });
+    }
+
+  measure (name + "::Join", params.str (),[&](unsigned long long i)
+	   {
+	     AbstractCache < T > result = states[i % 64];
+	     result.Join (states[(i * 7 + 1) % 64]);
+	     sink += result.Absent (0);
+	   });
+
+  measure (name + "::Equals", params.str (),[&](unsigned long long i)
+	   {
+	     sink += states[i % 64].Equals (states[(i & 1) ? i % 64 : (i + 1) % 64]);
+	   });
+}
+
+/** Constraint generation of a solver (name) for constraints of nbvars variables */
+static void benchSolver (const string & name, Solver & solver, unsigned int nbvars)
+{
+  ostringstream params;
+  params << "vars=" << nbvars;
+
+  vector < string > ids;
+  vector < long >cst;
+  for (unsigned int i = 0; i < nbvars; i++)
+    {
+      ostringstream id;
+      id << "n_" << 100 + i << "_c" << i % 4;
+      ids.push_back (id.str ());
+      cst.push_back (10 + i);
+    }
+
+  // The constraint system is reset from time to time to bound its size
+  ostringstream os;
+  auto next =[&](unsigned long long i)
+  {
+    if (i % 1024 == 0)
+      os.str ("");
+  };
+
+  measure (name + "::objective_function", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_objective_function (os, ids, cst);
+	   });
+  measure (name + "::declarations", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_declarations (os, ids);
+	   });
+  measure (name + "::flow_constraint", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_flow_constraint (os, ids);
+	   });
+  measure (name + "::inequality", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_inequality (os, ids, 10);
+	   });
+  measure (name + "::linear_inequality", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_linear_inequality (os, ids, cst, 10);
+	   });
+  measure (name + "::equality", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_equality (os, ids, 1);
+	   });
+  measure (name + "::linear_equality", params.str (),[&](unsigned long long i)
+	   {
+	     next (i);
+	     solver.generate_linear_equality (os, ids, cst, 0);
+	   });
+  if (nbvars == 1)
+    {
+      measure (name + "::null_variable", "",[&](unsigned long long i)
+	       {
+		 next (i);
+		 solver.generate_null_variable (os, ids[0]);
+	       });
+      // int2bin is only implemented for CPLEX
+      if (dynamic_cast < CPLEXSolver * >(&solver) != NULL)
+	measure (name + "::int2bin", "",[&](unsigned long long i)
+		 {
+		   next (i);
+		   solver.generate_int2bin (os, ids[0], "q_0");
+		 });
+    }
+}
+
+static void usage ()
+{
+  cerr << "Usage: HeptaneMicroBench [-time MS] [-filter NAME]" << endl;
+  cerr << "  -time MS      minimal duration of a measure (100)" << endl;
+  cerr << "  -filter NAME  only the kernels whose name contains NAME (MUST::Join, AbstractCache, lp_solve, ...)" << endl;
+  exit (-1);
+}
+
+int main (int argc, char **argv)
+{
+  if (argc % 2 != 1)
+    usage ();
+  for (int i = 1; i < argc; i += 2)
+    {
+      string option = argv[i], value = argv[i + 1];
+      if (option == "-time")
+	min_time = atoi (value.c_str ());
+      else if (option == "-filter")
+	filter = value;
+      else
+	usage ();
+    }
+
+  const unsigned int ways[] = { 2, 4, 8, 16 };
+  const t_replacement_policy policies[] = { LRU, PLRU, MRU, FIFO };
+  vector < unsigned int >blocksizes = { 1, 2, 4, 8 };
+
+  // Abstract cache sets
+  for (unsigned int w = 0; w < 4; w++)
+    {
+      for (unsigned int p = 0; p < 4; p++)
+	benchCacheSet < MUST > ("MUST", ways[w], policies[p], blocksizes);
+      benchCacheSet < MAY > ("MAY", ways[w], LRU, blocksizes);
+      for (unsigned int p = 0; p < 4; p++)
+	benchCacheSet < PS > ("PS", ways[w], policies[p], blocksizes);
+    }
+
+  // Abstract caches (hash-consed sets, see CacheSetTable)
+  const unsigned int sets[] = { 16, 64, 256 };
+  for (unsigned int s = 0; s < 3; s++)
+    {
+      benchAbstractCache < MUST > ("AbstractCache<MUST>", sets[s], 4, LRU, blocksizes);
+      benchAbstractCache < MAY > ("AbstractCache<MAY>", sets[s], 4, LRU, blocksizes);
+      benchAbstractCache < PS > ("AbstractCache<PS>", sets[s], 4, LRU, blocksizes);
+    }
+
+  // Constraint generation (the solvers are not run)
+  LpsolveSolver lpsolve (NULL);
+  CPLEXSolver cplex (NULL);
+  const unsigned int vars[] = { 1, 4, 32 };
+  for (unsigned int v = 0; v < 3; v++)
+    {
+      benchSolver ("lp_solve", lpsolve, vars[v]);
+      benchSolver ("cplex", cplex, vars[v]);
+    }
+
+  return (sink == 42) ? 1 : 0;
+}
@@ -0,0 +1,380 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <sstream>
+#include <cassert>
+#include <algorithm>
+#include "ProgramGenerator.h"
+#include "GlobalAttributes.h"
+#include "Logger.h"
+
+// Memory layout of the generated programs (RISCV, 4-byte instructions)
+#define TEXT_BASE 0x10074
+#define SBSS_BASE 0x10000000
+#define NB_GLOBALS 64
+#define BSS_BASE (SBSS_BASE + 0x1000)
+#define NB_ARRAYS 4
+#define ARRAY_WORDS 512
+// Stack frame: the local variables (sp relative), s0 and ra
+#define NB_LOCALS 13
+
+ProgramGenerator::ProgramGenerator(const GeneratorParameters & p)
+{
+  params = p;
+  if (params.nb_functions < 1)
+    Logger::addFatal("ProgramGenerator: at least one function (main) is required");
+  if (params.blocks_per_region < 1 || params.bb_size < 1)
+    Logger::addFatal("ProgramGenerator: regions and basic blocks should not be empty");
+  if (params.maxiter < 1)
+    Logger::addFatal("ProgramGenerator: loop bounds should be positive");
+  if (params.mem_ratio > 100)
+    Logger::addFatal("ProgramGenerator: the ratio of memory accesses is a percentage");
+  rng_state = 0;
+  nb_nodes = nb_instructions = nb_loops = nb_memory = nb_contexts = 0;
+}
+
+// Linear congruential generator: same program for a given seed on every host
+unsigned int ProgramGenerator::random(unsigned int n)
+{
+  rng_state = rng_state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return n == 0 ? 0 : (unsigned int) ((rng_state >> 33) % n);
+}
+
+static string hex(t_address a)
+{
+  ostringstream oss;
+  oss << std::hex << a;
+  return oss.str();
+}
+
+// --------------------------------------------------
+// Call graph: main on level 0, the other functions
+// spread over the levels 1..call_depth. Every function
+// is called from the level above, completed by random
+// calls up to calls_per_function.
+// --------------------------------------------------
+void ProgramGenerator::genCallGraph()
+{
+  functions.clear();
+  functions.resize(params.nb_functions);
+  unsigned int depth = min(params.call_depth, params.nb_functions - 1);
+  vector < vector < size_t > > levels(depth + 1);
+  for (size_t i = 0; i < functions.size(); i++)
+    {
+      functions[i].name = (i == 0) ? "main" : "f" + to_string(i);
+      functions[i].level = (i == 0) ? 0 : 1 + (i - 1) % depth;
+      levels[functions[i].level].push_back(i);
+    }
+  for (unsigned int l = 1; l <= depth; l++)
+    for (size_t k = 0; k < levels[l].size(); k++)
+      functions[levels[l - 1][random(levels[l - 1].size())]].callees.push_back(functions[levels[l][k]].name);
+  for (unsigned int l = 0; l < depth; l++)
+    for (size_t k = 0; k < levels[l].size(); k++)
+      {
+	Function & caller = functions[levels[l][k]];
+	while (caller.callees.size() < params.calls_per_function)
+	  caller.callees.push_back(functions[levels[l + 1][random(levels[l + 1].size())]].name);
+      }
+}
+
+// --------------------------------------------------
+// Straight-line code of a basic block
+// --------------------------------------------------
+void ProgramGenerator::genFiller(Block & b, unsigned int size)
+{
+  static const char *alu[] = { "add a5,a4,a5", "addi a4,a4,1", "sub a5,a5,a4", "slli a5,a5,0x2", "mv a4,a5", "mul a5,a5,a4", "xor a4,a4,a5" };
+  const unsigned int nbalu = sizeof(alu) / sizeof(alu[0]);
+
+  while (b.code.size() < size)
+    {
+      if (random(100) >= params.mem_ratio)
+	{
+	  b.code.push_back(alu[random(nbalu)]);
+	  continue;
+	}
+      t_data_pattern pattern = params.data_pattern;
+      if (pattern == MIXED_ACCESSES)
+	pattern = (t_data_pattern) random(3);
+      string op = (random(3) == 0) ? "sw a4," : "lw a4,";
+      if (pattern == STACK_ACCESSES)
+	b.code.push_back(op + to_string(4 * (int) (1 + random(NB_LOCALS))) + "(sp)");
+      else if (pattern == GLOBAL_ACCESSES)
+	b.code.push_back(op + to_string(-2048 + 4 * (int) random(NB_GLOBALS)) + "(gp)");
+      else
+	{
+	  // address = (hi << 12) + lo, lo signed on 12 bits
+	  t_address addr = BSS_BASE + 4 * (random(NB_ARRAYS) * ARRAY_WORDS + random(ARRAY_WORDS));
+	  t_address hi = (addr + 0x800) >> 12;
+	  b.code.push_back("lui a5,0x" + hex(hi));
+	  b.code.push_back(op + to_string((long) addr - (long) (hi << 12)) + "(a5)");
+	}
+      nb_memory++;
+    }
+}
+
+size_t ProgramGenerator::newBlock(Function & f, unsigned int size)
+{
+  Block b;
+  b.target = -1;
+  b.fallthrough = true;
+  b.ret = false;
+  b.addr = 0;
+  genFiller(b, size);
+  f.blocks.push_back(b);
+  return f.blocks.size() - 1;
+}
+
+// --------------------------------------------------
+// Items of a region, laid out in address order:
+// - plain block
+// - if-then-else: cond (beq to else), then (j to join), else
+// - call block ended by a jal
+// - loop: head, body region, latch (blt to head)
+// --------------------------------------------------
+void ProgramGenerator::genItem(Function & f, t_item kind, unsigned int level, unsigned int &loopsleft, size_t & nextcall)
+{
+  unsigned int size = params.bb_size;
+  switch (kind)
+    {
+    case PLAIN_ITEM:
+      newBlock(f, size);
+      break;
+    case DIAMOND_ITEM:
+      {
+	size_t cond = newBlock(f, size - 1);
+	f.blocks[cond].branch = "beq a4,a5,";
+	f.blocks[cond].target = cond + 2;
+	size_t then = newBlock(f, size - 1);
+	f.blocks[then].branch = "j ";
+	f.blocks[then].target = then + 2;
+	f.blocks[then].fallthrough = false;
+	newBlock(f, size);
+      }
+      break;
+    case CALL_ITEM:
+      {
+	size_t call = newBlock(f, size - 1);
+	f.blocks[call].branch = "jal ra,";
+	f.blocks[call].callee = f.callees[nextcall++];
+      }
+      break;
+    case LOOP_ITEM:
+      {
+	loopsleft--;
+	LoopDesc loop;
+	loop.head = newBlock(f, size);
+	genRegion(f, level + 1, params.blocks_per_region, loopsleft, nextcall);
+	loop.latch = newBlock(f, size - 1);
+	f.blocks[loop.latch].branch = "blt a4,a5,";
+	f.blocks[loop.latch].target = loop.head;
+	f.loops.push_back(loop);
+      }
+      break;
+    }
+}
+
+void ProgramGenerator::genRegion(Function & f, unsigned int level, unsigned int nbitems, unsigned int &loopsleft, size_t & nextcall)
+{
+  for (unsigned int i = 0; i < nbitems; i++)
+    {
+      unsigned int choice = random(4);
+      if (choice == 0 && loopsleft > 0 && level < params.loop_nesting)
+	genItem(f, LOOP_ITEM, level, loopsleft, nextcall);
+      else if (choice == 1 && nextcall < f.callees.size())
+	genItem(f, CALL_ITEM, level, loopsleft, nextcall);
+      else if (choice == 2)
+	genItem(f, DIAMOND_ITEM, level, loopsleft, nextcall);
+      else
+	genItem(f, PLAIN_ITEM, level, loopsleft, nextcall);
+    }
+}
+
+void ProgramGenerator::genFunction(Function & f)
+{
+  // Prologue
+  size_t entry = newBlock(f, 0);
+  f.blocks[entry].code.push_back("addi sp,sp,-64");
+  f.blocks[entry].code.push_back("sw ra,60(sp)");
+  f.blocks[entry].code.push_back("sw s0,56(sp)");
+  genFiller(f.blocks[entry], f.blocks[entry].code.size() + params.bb_size);
+
+  // Body: the loops and calls not placed randomly are appended
+  unsigned int loopsleft = (params.loop_nesting == 0) ? 0 : params.loops_per_function;
+  size_t nextcall = 0;
+  genRegion(f, 0, params.blocks_per_region, loopsleft, nextcall);
+  while (loopsleft > 0)
+    genItem(f, LOOP_ITEM, 0, loopsleft, nextcall);
+  while (nextcall < f.callees.size())
+    genItem(f, CALL_ITEM, 0, loopsleft, nextcall);
+
+  // Epilogue
+  size_t exit = newBlock(f, params.bb_size);
+  f.blocks[exit].code.push_back("lw ra,60(sp)");
+  f.blocks[exit].code.push_back("lw s0,56(sp)");
+  f.blocks[exit].code.push_back("addi sp,sp,64");
+  f.blocks[exit].ret = true;
+  f.blocks[exit].fallthrough = false;
+}
+
+// --------------------------------------------------
+// Number of contexts: one per call path from main
+// (the callees are one level below their callers)
+// --------------------------------------------------
+void ProgramGenerator::countContexts()
+{
+  map < string, unsigned long >contexts;
+  contexts["main"] = 1;
+  vector < size_t > order(functions.size());
+  for (size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  stable_sort(order.begin(), order.end(),[this] (size_t a, size_t b) { return functions[a].level < functions[b].level; });
+  nb_contexts = 0;
+  for (size_t i = 0; i < order.size(); i++)
+    {
+      Function & f = functions[order[i]];
+      nb_contexts += contexts[f.name];
+      for (size_t c = 0; c < f.callees.size(); c++)
+	contexts[f.callees[c]] += contexts[f.name];
+    }
+}
+
+static void addInstruction(Node * n, const string & code, t_address addr, bool ret)
+{
+  Instruction *inst = n->CreateNewInstruction(code, cfglib::Code, ret);
+  AddressAttribute attribute;
+  AddressInfo info;
+  info.setType("read");
+  info.setSegment("code");
+  info.setPrecision(true);
+  info.addAdrSize(to_string(addr), "4");
+  attribute.addInfo(info);
+  inst->SetAttribute(AddressAttributeName, attribute);
+}
+
+// --------------------------------------------------
+// cfglib program, as produced by HeptaneExtract
+// --------------------------------------------------
+Program *ProgramGenerator::build(const string & name)
+{
+  // Addresses
+  t_address addr = TEXT_BASE;
+  map < string, t_address > entries;
+  for (size_t i = 0; i < functions.size(); i++)
+    {
+      functions[i].addr = addr;
+      entries[functions[i].name] = addr;
+      for (size_t b = 0; b < functions[i].blocks.size(); b++)
+	{
+	  Block & block = functions[i].blocks[b];
+	  block.addr = addr;
+	  addr += 4 * (block.code.size() + ((block.branch != "" || block.ret) ? 1 : 0));
+	}
+    }
+
+  Program *p = new Program(name);
+  for (size_t i = 0; i < functions.size(); i++)
+    {
+      ListOfString names;
+      names.push_back(functions[i].name);
+      p->CreateNewCfg(functions[i].addr, names);
+    }
+
+  for (size_t i = 0; i < functions.size(); i++)
+    {
+      Function & f = functions[i];
+      Cfg *c = p->GetCfgByName(f.name);
+      vector < Node * >nodes;
+      for (size_t b = 0; b < f.blocks.size(); b++)
+	{
+	  Block & block = f.blocks[b];
+	  Node *n = c->CreateNewNode((block.callee != "") ? Call : BB);
+	  t_address a = block.addr;
+	  for (size_t k = 0; k < block.code.size(); k++, a += 4)
+	    addInstruction(n, block.code[k], a, false);
+	  if (block.callee != "")
+	    addInstruction(n, block.branch + hex(entries[block.callee]), a, false);
+	  else if (block.branch != "")
+	    addInstruction(n, block.branch + hex(f.blocks[block.target].addr), a, false);
+	  else if (block.ret)
+	    addInstruction(n, "ret", a, true);
+	  if (block.callee != "")
+	    n->SetCall(block.callee, false);
+	  nodes.push_back(n);
+	  nb_instructions += n->GetNbInstructions();
+	}
+      nb_nodes += nodes.size();
+
+      for (size_t b = 0; b < f.blocks.size(); b++)
+	{
+	  if (f.blocks[b].callee == "" && f.blocks[b].target >= 0)
+	    c->CreateNewEdge(nodes[b], nodes[f.blocks[b].target]);
+	  if (f.blocks[b].fallthrough)
+	    c->CreateNewEdge(nodes[b], nodes[b + 1]);
+	}
+
+      for (size_t l = 0; l < f.loops.size(); l++)
+	{
+	  Loop *loop = c->CreateNewLoop();
+	  for (int b = f.loops[l].head; b <= f.loops[l].latch; b++)
+	    loop->AddNode(nodes[b]);
+	  Edge *backedge = c->FindEdge(nodes[f.loops[l].latch], nodes[f.loops[l].head]);
+	  assert(backedge != NULL);
+	  loop->AddBackedge(backedge);
+	  SerialisableIntegerAttribute maxiter(params.maxiter);
+	  loop->SetAttribute(MaxiterAttributeName, maxiter);
+	}
+      nb_loops += f.loops.size();
+    }
+
+  SymbolTableAttribute symbols;
+  symbols.addSection(".text", TEXT_BASE, addr - TEXT_BASE);
+  symbols.addSection(".sbss", SBSS_BASE, 4 * NB_GLOBALS);
+  symbols.addSection(".bss", BSS_BASE, 4 * NB_ARRAYS * ARRAY_WORDS);
+  for (unsigned int v = 0; v < NB_GLOBALS; v++)
+    symbols.addVariable("g" + to_string(v), SBSS_BASE + 4 * v, 4, ".sbss");
+  for (unsigned int v = 0; v < NB_ARRAYS; v++)
+    symbols.addVariable("t" + to_string(v), BSS_BASE + 4 * v * ARRAY_WORDS, 4 * ARRAY_WORDS, ".bss");
+  symbols.setGP(SBSS_BASE + 2048);
+  p->SetAttribute(SymbolTableAttributeName, symbols);
+  return p;
+}
+
+Program *ProgramGenerator::generate(const string & name)
+{
+  rng_state = params.seed;
+  nb_nodes = nb_instructions = nb_loops = nb_memory = 0;
+  genCallGraph();
+  for (size_t i = 0; i < functions.size(); i++)
+    genFunction(functions[i]);
+  countContexts();
+  return build(name);
+}
+
+void ProgramGenerator::printStatistics(ostream & os)
+{
+  os << "Number of functions: " << functions.size() << endl;
+  os << "Number of basic blocks: " << nb_nodes << endl;
+  os << "Number of instructions: " << nb_instructions << endl;
+  os << "Number of memory instructions: " << nb_memory << endl;
+  os << "Number of loops: " << nb_loops << endl;
+  os << "Number of contexts: " << nb_contexts << endl;
+}
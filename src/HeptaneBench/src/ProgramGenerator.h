@@ -0,0 +1,129 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef _IRISA_PROGRAM_GENERATOR_H
+#define _IRISA_PROGRAM_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <CfgLib.h>
+
+using namespace std;
+using namespace cfglib;
+
+/** Data access patterns of the load/store instructions */
+typedef enum { STACK_ACCESSES, GLOBAL_ACCESSES, ARRAY_ACCESSES, MIXED_ACCESSES } t_data_pattern;
+
+/** Shape of a synthetic program */
+typedef struct
+{
+  unsigned int nb_functions;	// main included
+  unsigned int call_depth;	// levels of the call graph below main
+  unsigned int calls_per_function;
+  unsigned int loops_per_function;
+  unsigned int loop_nesting;
+  unsigned int maxiter;
+  unsigned int blocks_per_region;	// items of a function body or of a loop body
+  unsigned int bb_size;		// instructions of a basic block
+  t_data_pattern data_pattern;
+  unsigned int mem_ratio;	// percentage of load/store instructions
+  unsigned int seed;
+} GeneratorParameters;
+
+/**
+   Generator of synthetic RISCV programs, in the cfglib form produced by
+   HeptaneExtract (instruction addresses, loop bounds, symbol table), to
+   time the analyses on programs of controlled size.
+
+   The call graph is a DAG of call_depth levels under main. The body of
+   a function is a sequence of basic blocks, if-then-else, calls and
+   natural loops nested up to loop_nesting. The data accesses are stack
+   accesses (sp relative), global scalars (gp relative) or array
+   elements (lui + offset), all resolved by the DATAADDRESS analysis.
+*/
+class ProgramGenerator
+{
+private:
+  /** Basic block under construction, the blocks of a function are in address order */
+  typedef struct
+  {
+    vector < string > code;	// instructions, the terminating branch excluded
+    string branch;		// branch completed by its target address ("" if none)
+    int target;			// index of the target block (-1 for a call)
+    bool fallthrough;		// successor: next block
+    string callee;		// call block: name of the called function
+    bool ret;			// ends with the return of the function
+    t_address addr;
+  } Block;
+
+  /** Natural loop: contiguous blocks from head to latch */
+  typedef struct
+  {
+    int head, latch;
+  } LoopDesc;
+
+  typedef struct
+  {
+    string name;
+    unsigned int level;
+    vector < string > callees;
+    vector < Block > blocks;
+    vector < LoopDesc > loops;
+    t_address addr;
+  } Function;
+
+  GeneratorParameters params;
+  unsigned long rng_state;
+  vector < Function > functions;
+
+  /** Statistics of the generated program */
+  unsigned long nb_nodes, nb_instructions, nb_loops, nb_memory, nb_contexts;
+
+  /** Kinds of the items of a region */
+  typedef enum { PLAIN_ITEM, DIAMOND_ITEM, CALL_ITEM, LOOP_ITEM } t_item;
+
+  /** Random number in [0, n[ */
+  unsigned int random (unsigned int n);
+
+  void genCallGraph ();
+  /** Appends a block to f and returns its index */
+  size_t newBlock (Function & f, unsigned int size);
+  void genFiller (Block & b, unsigned int size);
+  void genItem (Function & f, t_item kind, unsigned int level, unsigned int &loopsleft, size_t & nextcall);
+  void genRegion (Function & f, unsigned int level, unsigned int nbitems, unsigned int &loopsleft, size_t & nextcall);
+  void genFunction (Function & f);
+  void countContexts ();
+  Program *build (const string & name);
+
+public:
+  /** Constructor */
+  ProgramGenerator (const GeneratorParameters & p);
+
+  /** Generates a program named name, with the entry point main */
+  Program *generate (const string & name);
+
+  /** Prints the size of the last generated program */
+  void printStatistics (ostream & os);
+};
+
+#endif
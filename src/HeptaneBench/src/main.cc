@@ -0,0 +1,124 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/* -----------------------------------------------------
+   Generator of synthetic programs in cfglib form, used
+   by the scaling benchmarks of HeptaneAnalysis (bench.sh)
+   -------------------------------------------------------- */
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include "Logger.h"
+#include "arch.h"
+#include "ProgramGenerator.h"
+
+static void usage()
+{
+  cerr << "Usage: HeptaneGenerate [options] <program.xml>" << endl;
+  cerr << "  -functions N   number of functions, main included (8)" << endl;
+  cerr << "  -depth N       depth of the call graph under main (3)" << endl;
+  cerr << "  -calls N       calls per function, leaves excluded (2)" << endl;
+  cerr << "  -loops N       loops per function (2)" << endl;
+  cerr << "  -nesting N     maximum loop nesting (2)" << endl;
+  cerr << "  -maxiter N     loop bound (10)" << endl;
+  cerr << "  -blocks N      items of a function or loop body (4)" << endl;
+  cerr << "  -bbsize N      instructions of a basic block (6)" << endl;
+  cerr << "  -data P        data accesses: stack, global, array or mixed (mixed)" << endl;
+  cerr << "  -memratio N    percentage of load/store instructions (30)" << endl;
+  cerr << "  -seed N        seed of the random choices (1)" << endl;
+  cerr << "  -datapath DIR  architecture description files (data directory of the installation)" << endl;
+  exit(-1);
+}
+
+int main(int argc, char **argv)
+{
+  GeneratorParameters params;
+  params.nb_functions = 8;
+  params.call_depth = 3;
+  params.calls_per_function = 2;
+  params.loops_per_function = 2;
+  params.loop_nesting = 2;
+  params.maxiter = 10;
+  params.blocks_per_region = 4;
+  params.bb_size = 6;
+  params.data_pattern = MIXED_ACCESSES;
+  params.mem_ratio = 30;
+  params.seed = 1;
+  // bin/HeptaneGenerate and data/ are in the same installation directory
+  string argv0 = argv[0];
+  string datapath = ((argv0.find('/') == string::npos) ? string(".") : argv0.substr(0, argv0.find_last_of('/'))) + "/../data";
+
+  if (argc < 2 || argc % 2 != 0)
+    usage();
+  for (int i = 1; i < argc - 1; i += 2)
+    {
+      string option = argv[i], value = argv[i + 1];
+      if (option == "-data")
+	{
+	  if (value == "stack") params.data_pattern = STACK_ACCESSES;
+	  else if (value == "global") params.data_pattern = GLOBAL_ACCESSES;
+	  else if (value == "array") params.data_pattern = ARRAY_ACCESSES;
+	  else if (value == "mixed") params.data_pattern = MIXED_ACCESSES;
+	  else usage();
+	  continue;
+	}
+      if (option == "-datapath")
+	{
+	  datapath = value;
+	  continue;
+	}
+      unsigned int n = (unsigned int) atoi(value.c_str());
+      if (option == "-functions") params.nb_functions = n;
+      else if (option == "-depth") params.call_depth = n;
+      else if (option == "-calls") params.calls_per_function = n;
+      else if (option == "-loops") params.loops_per_function = n;
+      else if (option == "-nesting") params.loop_nesting = n;
+      else if (option == "-maxiter") params.maxiter = n;
+      else if (option == "-blocks") params.blocks_per_region = n;
+      else if (option == "-bbsize") params.bb_size = n;
+      else if (option == "-memratio") params.mem_ratio = n;
+      else if (option == "-seed") params.seed = n;
+      else usage();
+    }
+
+  // The program is named after the output file
+  string filename = argv[argc - 1];
+  string name = filename.substr(filename.find_last_of('/') + 1);
+  name = name.substr(0, name.find('.'));
+
+  // The generated programs are RISCV programs (the symbol table is architecture dependent)
+  Arch::init("RISCV", false, datapath);
+
+  ProgramGenerator generator(params);
+  Program *p = generator.generate(name);
+  ofstream os(filename.c_str());
+  if (os.fail())
+    Logger::addFatal("HeptaneGenerate: unable to open " + filename);
+  p->serialise_program(os);
+  os.close();
+  generator.printStatistics(cout);
+  delete p;
+  Arch::kill();
+  return 0;
+}
@@ -129,9 +129,11 @@ static void GenerateAnnotationXMLForLoop(LoopTreeNode * n, ofstream & os, int in
 /*
   Check all loops have a maxiter.
   In the case a loop is not annotated, just emit a warning and go on.
+  Called once all annotations are attached and loop bounds inferred.
 */
-static void loopVerifications(vector < cfglib::Cfg * >&lc)
+void LoopVerifications(cfglib::Program & cfglib_program)
 {
+  vector < cfglib::Cfg * >lc = cfglib_program.GetAllCfgs();
   for (unsigned int c = 0; c < lc.size(); c++)
     {
       	// if we found a WCET in the annotation file, then no need to check for loop bound
@@ -222,8 +224,6 @@ void AttachAnnotationsFromXML(cfglib::Program & cfglib_program, string annotfile
 	  addAnnotationsFromFileToLoop(n->getSubloop(l), subloops_xml[l]);
 	}
     }
-  vector < cfglib::Cfg * >lc = cfglib_program.GetAllCfgs();
-  loopVerifications(lc);
 }
 
 /*
@@ -464,7 +464,6 @@ void AttachAnnotationFromBinary(cfglib::Program & cfglib_program, string annot_s
 	  }
       }
     }
-  loopVerifications(lc);
 
 
  // Verification: Does each annot has been assigned to some object ?
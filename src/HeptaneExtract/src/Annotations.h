@@ -80,6 +80,12 @@ extern void AttachAnnotationsFromXML (cfglib::Program & cfglib_program, string a
  */
 extern void AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_section_dump_file, bool verbose);
 
+/**
+    Check all loops have a maxiter (warning for the loops without one).
+    Called once the annotations are attached and the loop bounds inferred.
+ */
+extern void LoopVerifications (cfglib::Program & cfglib_program);
+
 /**
    @return the list of the addresses (decimal) of the beginning "switch" blocks 
 */
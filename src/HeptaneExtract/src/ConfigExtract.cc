@@ -20,6 +20,8 @@ See CREDITS.txt for credits of authorship
 
 ------------------------------------------------------------------------ */
 
+#include <thread>
+#include <algorithm>
 #include "ConfigExtract.h"
 #include "Utl.h"
 
@@ -207,6 +209,9 @@ ConfigExtract::ConfigExtract(string filename, bool verbose)
   output_cfg = true;
   output_code_addresses = true;
   display_stats = false;
+  infer_loop_bounds = false;
+  nb_threads = max(1u, thread::hardware_concurrency());
+  compression_suffix = "";
 
   if (!Utl::file_exists(filename))
     Logger::addFatal("ConfigExtract error: unable to open configuration file" + filename);
@@ -335,6 +340,40 @@ ConfigExtract::ConfigExtract(string filename, bool verbose)
       string vstat = lt[0].getAttributeString("VALUE");
       display_stats = (vstat == "YES");
     }
+
+  // loop bound inference
+  lt = xmldoc.searchChildren("LOOPBOUNDS");
+  assert(lt.size() <= 1);
+  if (lt.size() == 1)
+    {
+      string vinfer = lt[0].getAttributeString("INFERENCE");
+      infer_loop_bounds = (vinfer == "YES");
+    }
+
+  // worker threads of the cfg construction (default: one per core)
+  lt = xmldoc.searchChildren("THREADS");
+  assert(lt.size() <= 1);
+  if (lt.size() == 1)
+    {
+      int vthreads = lt[0].getAttributeInt("VALUE");
+      if (vthreads < 1)
+	Logger::addFatal("ConfigExtract error: THREADS VALUE must be at least 1");
+      nb_threads = vthreads;
+    }
+
+  // compression of the exported program (NO, GZ or ZST)
+  lt = xmldoc.searchChildren("COMPRESSION");
+  assert(lt.size() <= 1);
+  if (lt.size() == 1)
+    {
+      string vcomp = lt[0].getAttributeString("VALUE");
+      if (vcomp == "GZ")
+	compression_suffix = ".gz";
+      else if (vcomp == "ZST")
+	compression_suffix = ".zst";
+      else if (vcomp != "NO")
+	Logger::addFatal("ConfigExtract error: COMPRESSION VALUE must be NO, GZ or ZST");
+    }
   // -----------------------
 
   // Verification of file types
@@ -110,6 +110,9 @@ public:
   bool output_code_addresses;
 
   bool display_stats;
+  bool infer_loop_bounds;	// Loop bound inference for the loops without maxiter
+  unsigned int nb_threads;	// Worker threads of the cfg construction
+  string compression_suffix;	// "", ".gz" or ".zst" appended to the exported xml file
 
   // option
   bool overbose;
@@ -46,11 +46,15 @@
 #include <map>
 #include <stdlib.h>
 #include <algorithm>
+#include <functional>
+#include <atomic>
+#include <thread>
 
 #include "ConfigExtract.h"
 #include "dominatorAnalysis.h"
 #include "loopAnalysis.h"
 #include "switchAnalysis.h"
+#include "loopBoundAnalysis.h"
 #include "Annotations.h"
 #include "GlobalAttributes.h"
 #include "Utl.h"
@@ -157,15 +161,18 @@ static void DisplayStats(cfglib::Program & cfglib_program)
 /**
    Exporting a program (cfg form) in xml form.
 */
-static void exportCfg(cfglib::Program & cfglib_program, string exportDir)
+static void exportCfg(cfglib::Program & cfglib_program, string exportDir, string suffix)
 {
-  std::ofstream output_file_stream;
-  string exportXMLfilename = exportDir + "/" + cfglib_program.GetName() + ".xml";
-  output_file_stream.open(exportXMLfilename.c_str());
-  std::ostringstream serialised_form;
-  cfglib_program.serialise_program(serialised_form);
-  output_file_stream << serialised_form.str();
-  output_file_stream.close();
+  // Streamed to the file, compressed when suffix is ".gz" or ".zst"
+  string exportXMLfilename = exportDir + "/" + cfglib_program.GetName() + ".xml" + suffix;
+  try
+    {
+      cfglib_program.serialise_program(exportXMLfilename);
+    }
+  catch(string const &msg)
+    {
+      Logger::addFatal(msg);
+    }
 }
 
 static void cleanCfg(Cfg * vcfg)
@@ -254,12 +261,15 @@ bool changeCodeMSP430(ObjdumpInstruction & vinstruction)
     explaning why the cfg is constructed by scnanning all the cfg instructions
     - instrWithWords: (ARM SPECIFIC) mapping between instruction (t_address)
     that use .word and the corresponding words
+    - calls: the call nodes created, with the name of their callee. They are linked to their callee
+    by the caller, as it may create a cfg (cfgs of several functions are built concurrently).
     
 */
 static bool
 build_heptane_cfg(cfglib::Program & cfglib_program, const set < t_address > &bb_start_addr, /*const*/ vector < ObjdumpInstruction > &instructions,
 		  const ObjdumpFunction & function, const map < t_address, set < t_address > >&succs, const map < t_address,
-		  vector < ObjdumpWord > >&instrWithWords, map < int, ObjdumpInstruction > &MetaInstructionsTable)
+		  vector < ObjdumpWord > >&instrWithWords, map < int, ObjdumpInstruction > &MetaInstructionsTable,
+		  vector < pair < cfglib::Node *, string > >&calls)
 {
 
   // Association of Node* to addresses to properly create the list of successors
@@ -313,6 +323,8 @@ build_heptane_cfg(cfglib::Program & cfglib_program, const set < t_address > &bb_
 
       string text_instruction = current_instruction.asm_code;
       cfglib::Instruction * inst = current_node->CreateNewInstruction(text_instruction, cfglib::Code, bret);
+      // Tokenised operands, so that the analyses do not parse the code again
+      UtlCfgLib::tokenizeOperands(inst);
       // Add an address attribute to the instruction
       // FIXME: remove these hard-coded strings
       AddressAttribute attribute;
@@ -342,7 +354,7 @@ build_heptane_cfg(cfglib::Program & cfglib_program, const set < t_address > &bb_
 	  // Set the node type to call, with the called function as parameter
 	  if (Arch::getCalleeName(current_instruction) == "")
 	    Logger::addFatal("CFG extractor: name of called empty returned by getCalleeName \n\t(probably an indirect call or a switch), instruction: " + current_instruction.asm_code);
-	  current_node->SetCall(Arch::getCalleeName(current_instruction), true);
+	  calls.push_back(make_pair(current_node, Arch::getCalleeName(current_instruction)));
 	}
 
       if (isARMArchi)		// ARM SPECIFIC: attach .word information
@@ -438,7 +450,7 @@ void verifsOnCfg(vector < cfglib::Cfg * >lcfg) {
    - Make sure functions are correctly linked for call nodes,
    - Set the program entry entry point,
    - Create loops,
-   - Manage annotations.
+   - Manage annotations and infer the missing loop bounds.
 */
 static void finalize_program_construction(const ConfigExtract & config, cfglib::Program & cfglib_program)
 {
@@ -474,6 +486,16 @@ static void finalize_program_construction(const ConfigExtract & config, cfglib::
     AttachAnnotationsFromXML(cfglib_program, config.annotation_file, opt_verbose);
   // Get the other annotations from the binary file
   AttachAnnotationFromBinary(cfglib_program, config.tmp_dir + "/" + config.program_name + ".annot", opt_verbose);
+  // Infer the bounds of the loops still not annotated
+  if (config.infer_loop_bounds && (isMIPSArchi || isRISCVArchi))
+    {
+      int nbmissing = 0;
+      for (unsigned int c = 0; c < lcfg.size(); c++)
+	nbmissing += LoopBoundComputer::computeLoopBounds(lcfg[c]);
+      if (nbmissing != 0)
+	cout << "Loop bound inference: " << nbmissing << " loop(s) still need a manual " << MaxiterAttributeName << " annotation" << endl;
+    }
+  LoopVerifications(cfglib_program);
   // Output the final annotation file if required
   if (config.output_annot)
     GenerateAnnotationXMLFile(cfglib_program, config.result_dir + "/" + config.annotation_file, opt_verbose);
@@ -582,13 +604,172 @@ static int kernel(vector < ObjdumpInstruction > &instructions, ObjdumpInstructio
   return nbadded;
 }
 
+/**
+   Part of the disassembly of section .text which starts at a label of the objdump file,
+   parsed independently of the other ones (see BuildCfg).
+*/
+typedef struct
+{
+  ObjdumpFunction function;	// default (empty name) for the instructions before the first label
+  vector < size_t > lines;	// indexes of the instruction lines in the objdump file
+  vector < ObjdumpInstruction > instructions;	// the parsed instruction lines
+  vector < ObjdumpWord > words;	// ARM SPECIFIC: .word of the segment
+  map < t_address, vector < ObjdumpWord > >instrWithWords;	// ARM SPECIFIC: instructions of the segment using .word
+} ObjdumpSegment;
+
+/**
+   Segments whose cfg is built together: the instructions of the segments
+   not matching a cfg of the symbol table go to the cfg of the next segment.
+*/
+typedef struct
+{
+  vector < size_t > segments;
+  bool built;
+  vector < pair < cfglib::Node *, string > >calls;	// call nodes, linked to their callee once all the cfgs are built
+} CfgBuildUnit;
+
+/** Apply f to 0..n-1 on nbthreads worker threads */
+static void parallel_for(size_t n, unsigned int nbthreads, const function < void (size_t) > &f)
+{
+  atomic < size_t > next(0);
+  auto worker = [&]()
+    {
+      for (size_t i = next++; i < n; i = next++)
+	f(i);
+    };
+
+  unsigned int nt = (unsigned int) min((size_t) nbthreads, n);
+  if (nt <= 1)
+    worker();
+  else
+    {
+      vector < thread > threads;
+      for (unsigned int t = 0; t < nt; t++)
+	threads.push_back(thread(worker));
+      for (unsigned int t = 0; t < nt; t++)
+	threads[t].join();
+    }
+}
+
+/** 
+    Basic block discovery: add the instruction instr of a function to its instructions (see kernel),
+    with the basic block start addresses and the successors it induces.
+*/
+static void scan_instruction(ObjdumpInstruction & instr, vector < ObjdumpInstruction > &instructions, set < t_address > &bb_start_addr,
+			     map < t_address, set < t_address > >&succs, map < int, ObjdumpInstruction > &MetaInstructionsTable)
+{
+  // .word for ARM are not attached as instruction but as an attribute of an instruction
+  if (isARMArchi && Arch::isWord(instr))
+    return;
+
+  // The ARM multiple store/load (pop, push, ldm, stm) are rewritten using simple load/store instructions.
+  kernel(instructions, instr, MetaInstructionsTable);
+
+  if (Arch::isCall(instr))
+    {
+      t_address addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+      bb_start_addr.insert(addr_next_bb);
+      succs[instr.addr].insert(addr_next_bb);
+    }
+  else if (Arch::isReturn(instr))
+    {
+      t_address addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+      bb_start_addr.insert(addr_next_bb);
+    }
+  else if (Arch::isUnconditionalJump(instr))
+    {
+      t_address addr_next_bb;
+      if (isMSP430Archi)
+	{
+	  addr_next_bb = instr.addr + 2 + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+	}
+      else
+	{
+	  addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+	}
+      bb_start_addr.insert(addr_next_bb);
+
+      t_address addr_succ_bb = Arch::getJumpDestination(instr);
+      bb_start_addr.insert(addr_succ_bb);
+      succs[instr.addr].insert(addr_succ_bb);
+    }
+  else if (Arch::isConditionalJump(instr))
+    {
+      t_address addr_next_bb;
+      if (isMSP430Archi)
+	{
+	  addr_next_bb = instr.addr + 2 + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+	}
+      else
+	{
+	  addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
+	}
+      bb_start_addr.insert(addr_next_bb);
+      succs[instr.addr].insert(addr_next_bb);
+
+      t_address addr_succ_bb = Arch::getJumpDestination(instr);
+      bb_start_addr.insert(addr_succ_bb);
+      succs[instr.addr].insert(addr_succ_bb);
+    }
+}
+
+/** ARM specific: detection of the instructions of a segment using .word, stored in its instrWithWords */
+static void attach_words(ObjdumpSegment & segment, const vector < ObjdumpWord > &words)
+{
+  for (size_t k = 0; k < segment.instructions.size(); k++)
+    {
+      const ObjdumpInstruction & instr = segment.instructions[k];
+      if (!Arch::isPcInInputResources(instr))
+	continue;
+      if (Arch::isPcInOutputResources(instr))
+	{
+	  // the .word table are not assigned to the instruction.
+	  // Indirect jump (switch) via .word table.
+	  // 80f0:  e3530077        cmp     r3, #119        ; 0x77
+	  // 80f4:  979ff103        ldrls   pc, [pc, r3, lsl #2]
+	  // 80f8:  ea000257        b       8a5c <swi120+0x984>
+	  // 80fc:  000082dc        .word   0x000082dc
+	  // 8100:  000082ec        .word   0x000082ec
+	  //  ...                 
+	  continue;
+	}
+
+      // The next line is an instruction
+      assert(k + 1 < segment.instructions.size() && segment.lines[k + 1] == segment.lines[k] + 1);
+      const ObjdumpInstruction & instr2 = segment.instructions[k + 1];
+      bool instr2_consumed = true;
+
+      // Getting the .word associated to the instruction
+      vector < ObjdumpWord > words_result = Arch::getWordsFromInstr(instr, instr2, words, instr2_consumed);
+
+      // associate the .words to the instruction
+      segment.instrWithWords[instr.addr] = words_result;
+      if (instr2_consumed)
+	{
+	  // example : add r3, pc, #220    ; 0xdc
+	  //           ldm   r3, {r2, r3}
+
+	  // the first .word is used by the first instruction
+	  // while the nexts .word are used by the second instruction
+	  // TODO: to be checked
+	  //      To be safe there are added to both instructions
+	  segment.instrWithWords[instr2.addr] = words_result;
+	  k++;
+	}
+      // else, example : ldr r3, [pc, #116]  ; 81ec <RandomInteger+0x84>, directly used by the instruction
+    }
+}
+
 /** Parser: parse the objdump file and generate the CFG and the readelf file
     - First step: parsing of the readelf file  
-    - Second step: parsing of the objdump file: parsing of the symbol table and if arch == ARM then search for .word in the .text and store them in wordsPerFunction
-    - Third step: parsing of the objdump file (ARM specific: Detection of instructions using .word and store them in instrWithWords)
+    - Second step: loading of the objdump file, parsing of its symbol table,
+    and split of the disassembly of section .text into segments, one per label
+    - Third step: parsing of the segments (concurrently). ARM specific: the .word are stored in wordsPerFunction,
+    then the instructions using them are detected and stored in instrWithWords
     
     - Program & Cfgs creation
-    - Last step: parsing of the objdump file again: parsing the disassembly of section .text,  ...
+    - Last step: construction of the cfgs of the segments (concurrently) and link of the call nodes to their callee
+    (sequentially, in the order of the objdump file, so that the program does not depend on the threads).
     - Finalize program construction ( see finalize_program_construction()),
     - Export the program (xml file) (see exportCfg()).
 */
@@ -603,12 +784,6 @@ static void BuildCfg(const ConfigExtract & config)
   if (!input_readelf.is_open())
     Logger::addFatal("Error: file " + readelfname + " not present");
 
-  // Variables for function parsing
-  vector < ObjdumpInstruction > instructions;
-  map < int, ObjdumpInstruction > MetaInstructionsTable;
-  ObjdumpFunction function;
-  set < t_address > bb_start_addr;
-  map < t_address, set < t_address > >succs;
   //  ObjdumpSymbolTable symbol_table;
 
   isARMArchi = Arch::getArchitectureName() == "ARM";
@@ -641,143 +816,87 @@ static void BuildCfg(const ConfigExtract & config)
     }
   input_readelf.close();
   assert(symbol_table.sections.empty() == false);
-  line = "";
 
   /**********************************************************/
-  /******     Second step: parsing of the objdump file  *****/
+  /******     Second step: loading of the objdump file  *****/
   /**********************************************************/
-  //  - parsing of the symbol table
-  //  - if arch == ARM    then search for .word in the .text and store them in wordsPerFunction
+  // The file is read once, the next steps work on its lines
+  vector < string > lines;
+  while (!input.eof())
+    {
+      getline(input, line);
+      lines.push_back(line);
+    }
+  input.close();
 
   // go to the SYMBOL TABLE:
-  while (!input.eof() && !Arch::isObjdumpSymbolTableMarker(line))
-    getline(input, line);
+  size_t l = 0;
+  while (l < lines.size() && !Arch::isObjdumpSymbolTableMarker(lines[l]))
+    l++;
 
   // parsing the symbol table until the Disassembly of section .text:
-  while (!input.eof() && !Arch::isObjdumpTextMarker(line))
+  for (l++; l < lines.size() && !Arch::isObjdumpTextMarker(lines[l]); l++)
     {
-      getline(input, line);
-      if (line.length() == 0 || Arch::isObjdumpTextMarker(line))
+      if (lines[l].length() == 0)
 	continue;
-      //      cout << " *** parsing the line "  << line << endl;
-      Arch::parseSymbolTableLine(line, symbol_table);
+      Arch::parseSymbolTableLine(lines[l], symbol_table);
     }
 
-  // ARM specific
-  if (isARMArchi)
+  // Split the disassembly of section .text, one segment per label
+  vector < ObjdumpSegment > segments(1);
+  for (l++; l < lines.size(); l++)
     {
-      // parsing the code (searching for .word)
-      while (!input.eof())
+      if (lines[l].length() == 0)
+	continue;		// skip empty lines
+      if (Arch::isFunction(lines[l]))
 	{
-	  getline(input, line);
-	  if (line.length() == 0)
-	    continue;		// skip empty lines
-
-	  if (Arch::isFunction(line))
-	    function = Arch::parseFunction(line);	// function 
-	  else if (Arch::isInstruction(line))	// instruction
-	    {
-	      ObjdumpInstruction instr = Arch::parseInstruction(line);
-	      if (Arch::isWord(instr))
-		{
-		  ObjdumpWord data = Arch::readWordInstruction(instr, symbol_table);
-		  wordsPerFunction[function.name].push_back(data);
-		}
-	    }
+	  if (segments.back().lines.empty() && segments.size() == 1)
+	    segments.pop_back();	// no instruction before the first label
+	  segments.push_back(ObjdumpSegment());
+	  segments.back().function = Arch::parseFunction(lines[l]);
 	}
+      else if (Arch::isInstruction(lines[l]))
+	segments.back().lines.push_back(l);
     }
-  input.close();
-  line = "";
 
   /**********************************************************/
-  /******     Third step: parsing of the objdump file  ******/
+  /******     Third step: parsing of the segments      ******/
   /**********************************************************/
+  parallel_for(segments.size(), config.nb_threads,[&](size_t s)
+	       {
+		 ObjdumpSegment & segment = segments[s];
+		 for (size_t i = 0; i < segment.lines.size(); i++)
+		   {
+		     segment.instructions.push_back(Arch::parseInstruction(lines[segment.lines[i]]));
+		     // ARM specific: search for .word
+		     if (isARMArchi && Arch::isWord(segment.instructions.back()))
+		       segment.words.push_back(Arch::readWordInstruction(segment.instructions.back(), symbol_table));
+		   }
+	       });
+  lines.clear();
+
   // ARM specific: Detection of instructions using .word and store them in instrWithWords
-  if (isARMArchi && !wordsPerFunction.empty())
+  if (isARMArchi)
     {
-      input.open(objdumpname.c_str(), ios::in);
-      string line2;
-      bool line2_has_been_consumed = true;
-
-      // go to the Disassembly of section .text:
-      while (!input.eof() && !Arch::isObjdumpTextMarker(line))
-	getline(input, line);
-
-      // Parse it
-      while (!input.eof())
+      for (size_t s = 0; s < segments.size(); s++)
+	if (!segments[s].words.empty())
+	  {
+	    vector < ObjdumpWord > &words = wordsPerFunction[segments[s].function.name];
+	    words.insert(words.end(), segments[s].words.begin(), segments[s].words.end());
+	  }
+      if (!wordsPerFunction.empty())
 	{
-	  if (line2_has_been_consumed)
-	    {
-	      getline(input, line);
-	      if (line.length() == 0)
-		continue;	// skip empty lines
-	    }
-	  else
-	    {
-	      line = line2;
-	      line2_has_been_consumed = true;
-	    }
-	  if (Arch::isFunction(line))	// function
-	    {
-	      function = Arch::parseFunction(line);
-	    }
-	  else if (Arch::isInstruction(line))	// instruction
-	    {
-	      ObjdumpInstruction instr = Arch::parseInstruction(line);
-
-	      if (Arch::isPcInInputResources(instr))
-		{
-		  if (Arch::isPcInOutputResources(instr))
-		    {
-		      // the .word table are not assigned to the instruction.
-		      // Indirect jump (switch) via .word table.
-		      // 80f0:  e3530077        cmp     r3, #119        ; 0x77
-		      // 80f4:  979ff103        ldrls   pc, [pc, r3, lsl #2]
-		      // 80f8:  ea000257        b       8a5c <swi120+0x984>
-		      // 80fc:  000082dc        .word   0x000082dc
-		      // 8100:  000082ec        .word   0x000082ec
-		      //  ...                 
-		    }
-		  else
-		    {
-		      // Reading the next line
-		      getline(input, line2);
-
-		      // Some checks
-		      assert(line2.length() != 0);
-		      assert(Arch::isInstruction(line2));
-
-		      ObjdumpInstruction instr2 = Arch::parseInstruction(line2);
-		      line2_has_been_consumed = true;
-
-		      // Getting the .word associated to the instruction
-		      vector < ObjdumpWord > words_result = Arch::getWordsFromInstr(instr, instr2, wordsPerFunction[function.name], line2_has_been_consumed);
-
-		      // associate the .words to the instruction
-		      if (!line2_has_been_consumed)	// example : ldr r3, [pc, #116]  ; 81ec <RandomInteger+0x84>
-			{	// directly used by the instruction
-			  instrWithWords[instr.addr] = words_result;
-			}
-		      else
-			{
-			  // example : add r3, pc, #220    ; 0xdc
-			  //           ldm   r3, {r2, r3}
-
-			  // the first .word is used by the first instruction
-			  // while the nexts .word are used by the second instruction
-			  // TODO: to be checked
-			  //      To be safe there are added to both instructions
-			  instrWithWords[instr.addr] = words_result;
-			  instrWithWords[instr2.addr] = words_result;
-			}
-		    }
-		}
-	    }
+	  parallel_for(segments.size(), config.nb_threads,[&](size_t s)
+		       {
+			 static const vector < ObjdumpWord > nowords;
+			 map < string, vector < ObjdumpWord > >::const_iterator it = wordsPerFunction.find(segments[s].function.name);
+			 attach_words(segments[s], (it == wordsPerFunction.end())? nowords : it->second);
+		       });
+	  for (size_t s = 0; s < segments.size(); s++)
+	    for (map < t_address, vector < ObjdumpWord > >::iterator it = segments[s].instrWithWords.begin(); it != segments[s].instrWithWords.end(); it++)
+	      instrWithWords[it->first] = it->second;
 	}
-
-      input.close();
     }
-  line = "";
 
   /**********************************************************/
   /******         Program & Cfgs creation              ******/
@@ -812,110 +931,55 @@ static void BuildCfg(const ConfigExtract & config)
   cfglib_program.SetAttribute(SymbolTableAttributeName, ts_attribute);
 
   /**********************************************************/
-  /******     Last step: parsing of the objdump file   ******/
+  /******     Last step: construction of the cfgs      ******/
   /**********************************************************/
 
-  function.name = "";
-
-  input.open(objdumpname.c_str(), ios::in);
-  // Go to the Disassembly of section .text:
-  while (!input.eof() && !Arch::isObjdumpTextMarker(line))
-    getline(input, line);
-
-  // Parse it
-  while (!input.eof())
+  // Group the segments per cfg
+  vector < CfgBuildUnit > units;
+  CfgBuildUnit unit;
+  unit.built = false;
+  for (size_t s = 0; s < segments.size(); s++)
     {
-      getline(input, line);
-      if (line.length() == 0)
-	continue;		// skip empty lines
-
-      if (Arch::isFunction(line))	// function
-	{
-	  // if it is not the first function
-	  if (function.name != "")
-	    {
-	      // build the previously parsed function
-	      if (build_heptane_cfg(cfglib_program, bb_start_addr, instructions, function, succs, instrWithWords, MetaInstructionsTable))
-		{
-		  // and clean the variables for the current function
-		  instructions.clear();
-		  bb_start_addr.clear();
-		  succs.clear();
-		  MetaInstructionsTable.clear();
-		}
-	    }
-	  function = Arch::parseFunction(line);
-	}
-      else if (Arch::isInstruction(line))	// instruction
+      unit.segments.push_back(s);
+      const ObjdumpFunction & function = segments[s].function;
+      if (s + 1 == segments.size() || (function.name != "" && cfglib_program.GetCfgByAddress(function.addr) != NULL))
 	{
-	  ObjdumpInstruction instr = Arch::parseInstruction(line);
-
-	  // .word for ARM are not attached as instruction but as an attribute of an instruction
-	  if (isARMArchi && Arch::isWord(instr))
-	    continue;
-
-	  // The ARM multiple store/load (pop, push, ldm, stm) are rewritten using simple load/store instructions.
-	  kernel(instructions, instr, MetaInstructionsTable);
-
-	  if (Arch::isCall(instr))
-	    {
-	      t_address addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-	      bb_start_addr.insert(addr_next_bb);
-	      succs[instr.addr].insert(addr_next_bb);
-	    }
-	  else if (Arch::isReturn(instr))
-	    {
-	      t_address addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-	      bb_start_addr.insert(addr_next_bb);
-	    }
-	  else if (Arch::isUnconditionalJump(instr))
-	    {
-	      t_address addr_next_bb;
-	      if (isMSP430Archi)
-		{
-		  addr_next_bb = instr.addr + 2 + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-		}
-	      else
-		{
-		  addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-		}
-	      bb_start_addr.insert(addr_next_bb);
-
-	      t_address addr_succ_bb = Arch::getJumpDestination(instr);
-	      bb_start_addr.insert(addr_succ_bb);
-	      succs[instr.addr].insert(addr_succ_bb);
-	    }
-	  else if (Arch::isConditionalJump(instr))
-	    {
-	      t_address addr_next_bb;
-	      if (isMSP430Archi)
-		{
-		  addr_next_bb = instr.addr + 2 + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-		}
-	      else
-		{
-		  addr_next_bb = instr.addr + Arch::getInstructionSize() + Arch::getNBInstrInDelaySlot() * Arch::getInstructionSize();
-		}
-	      bb_start_addr.insert(addr_next_bb);
-	      succs[instr.addr].insert(addr_next_bb);
-
-	      t_address addr_succ_bb = Arch::getJumpDestination(instr);
-	      bb_start_addr.insert(addr_succ_bb);
-	      succs[instr.addr].insert(addr_succ_bb);
-	    }
+	  units.push_back(unit);
+	  unit.segments.clear();
 	}
     }
-  input.close();
 
-  // Build the last function
-  if (build_heptane_cfg(cfglib_program, bb_start_addr, instructions, function, succs, instrWithWords, MetaInstructionsTable))
-    {
-      // Finalize program construction
-      finalize_program_construction(config, cfglib_program);
-    }
+  // Build the cfgs, each one by a single thread
+  parallel_for(units.size(), config.nb_threads,[&](size_t u)
+	       {
+		 // Variables for function parsing
+		 vector < ObjdumpInstruction > instructions;
+		 map < int, ObjdumpInstruction > MetaInstructionsTable;
+		 set < t_address > bb_start_addr;
+		 map < t_address, set < t_address > >succs;
+
+		 CfgBuildUnit & unit = units[u];
+		 for (size_t i = 0; i < unit.segments.size(); i++)
+		   {
+		     ObjdumpSegment & segment = segments[unit.segments[i]];
+		     for (size_t k = 0; k < segment.instructions.size(); k++)
+		       scan_instruction(segment.instructions[k], instructions, bb_start_addr, succs, MetaInstructionsTable);
+		   }
+		 unit.built = build_heptane_cfg(cfglib_program, bb_start_addr, instructions, segments[unit.segments.back()].function, succs,
+						instrWithWords, MetaInstructionsTable, unit.calls);
+	       });
+
+  // Link the call nodes (may create the cfgs of the external functions)
+  for (size_t u = 0; u < units.size(); u++)
+    for (size_t c = 0; c < units[u].calls.size(); c++)
+      units[u].calls[c].first->SetCall(units[u].calls[c].second, true);
+
+  // Finalize program construction when the last function is built
+  if (!units.empty() && units.back().built)
+    finalize_program_construction(config, cfglib_program);
 
   // Export program in xml form
-  exportCfg(cfglib_program, config.result_dir);
+  exportCfg(cfglib_program, config.result_dir, config.compression_suffix);
 
   if (config.display_stats)
     DisplayStats(cfglib_program);
@@ -0,0 +1,620 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+#include <assert.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <ctype.h>
+#include <algorithm>
+#include "GlobalAttributes.h"
+#include "dominatorData.h"
+#include "loopBoundAnalysis.h"
+#include "ConfigExtract.h"
+
+// Pseudo location written by a call: the registers not saved by the callee are lost, and so are
+// the frame slots (their address may have escaped to the callee)
+#define CALL_MARKER "#call"
+
+// Pseudo location written by a store through another pointer than the stack/frame pointer:
+// it may modify any frame slot
+#define STORE_MARKER "#store"
+
+// Max depth of the backward search of the value of a location at the loop entry
+#define LOOPBOUND_MAX_DEPTH 12
+
+/* this namespace is the global namespace */
+namespace cfglib {
+
+  static t_sym_value mkUnknown()
+  {
+    t_sym_value v;
+    v.kind = SYM_UNKNOWN;
+    v.cst = v.cst2 = 0;
+    return v;
+  }
+
+  static t_sym_value mkValue(const string & loc, long long cst)
+  {
+    t_sym_value v = mkUnknown();
+    v.kind = SYM_VALUE;
+    v.loc = loc;
+    v.cst = cst;
+    return v;
+  }
+
+  static bool isFrameSlotName(const string & loc)
+  {
+    return loc.find('(') != string::npos;
+  }
+
+  /** @return a + b, unknown when both operands depend on a location */
+  static t_sym_value addValues(const t_sym_value & a, const t_sym_value & b)
+  {
+    if (a.kind != SYM_VALUE || b.kind != SYM_VALUE) return mkUnknown();
+    if (a.loc != "" && b.loc != "") return mkUnknown();
+    return mkValue(a.loc != "" ? a.loc : b.loc, a.cst + b.cst);
+  }
+
+  /** @return a - b, unknown when b is not a constant */
+  static t_sym_value subValues(const t_sym_value & a, const t_sym_value & b)
+  {
+    if (a.kind != SYM_VALUE || b.kind != SYM_VALUE || b.loc != "") return mkUnknown();
+    return mkValue(a.loc, a.cst - b.cst);
+  }
+
+  bool LoopBoundComputer::parseImmediate(const string & str, long long &v)
+  {
+    if (str.empty()) return false;
+    const char *s = str.c_str();
+    char *end;
+    v = strtoll(s, &end, (str.find("0x") != string::npos) ? 16 : 10);
+    return end != s && *end == '\0';
+  }
+
+  bool LoopBoundComputer::isFrameRegister(const string & reg)
+  {
+    return reg == "sp" || reg == "s0" || reg == "fp" || reg == "s8";
+  }
+
+  bool LoopBoundComputer::isCalleeSaved(const string & reg)
+  {
+    if (reg == "sp" || reg == "fp" || reg == "gp") return true;
+    return reg.size() >= 2 && reg[0] == 's' && isdigit(reg[1]);
+  }
+
+  /**
+     Stack frame slot "offset(base)" accessed by a load/store operand, when base is the stack or frame pointer.
+  */
+  bool LoopBoundComputer::getFrameSlot(const string & operand, string & slot)
+  {
+    string reg, val;
+    long long offset;
+    if (operand.find('(') == string::npos) return false;
+    Utl::extractRegVal(operand, reg, val);
+    if (!isFrameRegister(reg) || !parseImmediate(val, offset)) return false;
+    slot = Utl::int2string(offset) + "(" + reg + ")";
+    return true;
+  }
+
+  /** @return true if the location loc may be modified by the pseudo locations (calls, stores through pointers) of written */
+  bool LoopBoundComputer::isClobbered(const string & loc, const set < string > &written)
+  {
+    bool frame_slot = isFrameSlotName(loc);
+    if (written.count(CALL_MARKER) && (frame_slot || (Arch::isRegisterName(loc) && !isCalleeSaved(loc)))) return true;
+    return frame_slot && written.count(STORE_MARKER);
+  }
+
+  t_sym_value LoopBoundComputer::getValue(t_sym_state & state, const string & loc)
+  {
+    t_sym_state::iterator it = state.find(loc);
+    if (it != state.end()) return it->second;
+    set < string > markers;
+    if (state.count(CALL_MARKER)) markers.insert(CALL_MARKER);
+    if (state.count(STORE_MARKER)) markers.insert(STORE_MARKER);
+    if (isClobbered(loc, markers)) return mkUnknown();
+    return mkValue(loc, 0);
+  }
+
+  /** Removes the values of the frame slots (and of the registers not saved by the callee on a call) from state */
+  void LoopBoundComputer::clobber(t_sym_state & state, bool call)
+  {
+    for (t_sym_state::iterator it = state.begin(); it != state.end();)
+      {
+	if (isFrameSlotName(it->first) || (call && Arch::isRegisterName(it->first) && !isCalleeSaved(it->first)))
+	  state.erase(it++);
+	else
+	  ++it;
+      }
+  }
+
+  t_sym_value LoopBoundComputer::readOperand(t_sym_state & state, const string & operand)
+  {
+    long long v;
+    if (Arch::isRegisterName(operand))
+      {
+	if (Arch::isZeroRegister(operand)) return mkValue("", 0);
+	return getValue(state, operand);
+      }
+    if (parseImmediate(operand, v)) return mkValue("", v);
+    return mkUnknown();
+  }
+
+  /**
+     Symbolic execution of an instruction (code): updates the values of the registers/frame slots (state)
+     and records the locations written (written).
+     The instructions that are not interpreted make their output registers unknown.
+  */
+  void LoopBoundComputer::execute(const string & code, t_sym_state & state, set < string > &written)
+  {
+    vector < string > v = Arch::splitInstruction(code);
+    string m = v[0], dest, slot;
+    size_t nbops = v.size() - 1;
+    t_sym_value res;
+    long long imm;
+
+    if (m == "li" && nbops == 2)
+      {
+	dest = v[1];
+	res = parseImmediate(v[2], imm) ? mkValue("", imm) : mkUnknown();
+      }
+    else if ((m == "mv" || m == "move" || m == "sext.w") && nbops == 2)
+      {
+	dest = v[1];
+	res = readOperand(state, v[2]);
+      }
+    else if ((m == "addi" || m == "addiw" || m == "addiu" || m == "daddiu" || m == "add" || m == "addw" || m == "addu" || m == "daddu") && nbops == 3)
+      {
+	dest = v[1];
+	res = addValues(readOperand(state, v[2]), readOperand(state, v[3]));
+      }
+    else if ((m == "sub" || m == "subw" || m == "subu" || m == "dsubu") && nbops == 3)
+      {
+	dest = v[1];
+	res = subValues(readOperand(state, v[2]), readOperand(state, v[3]));
+      }
+    else if ((m == "slt" || m == "slti" || m == "sltu" || m == "sltiu") && nbops == 3)
+      {
+	t_sym_value a = readOperand(state, v[2]), b = readOperand(state, v[3]);
+	dest = v[1];
+	res = mkUnknown();
+	if (a.kind == SYM_VALUE && b.kind == SYM_VALUE)
+	  {
+	    res = a;
+	    res.kind = (m == "slt" || m == "slti") ? SYM_LESS : SYM_LESSU;
+	    res.loc2 = b.loc;
+	    res.cst2 = b.cst;
+	  }
+      }
+    else if (Arch::isStore(code))
+      {
+	if (getFrameSlot(v[nbops], slot))
+	  {
+	    bool integer_store = (m == "sw" || m == "sd" || m == "sh" || m == "sb");
+	    state[slot] = integer_store ? readOperand(state, v[1]) : mkUnknown();
+	    written.insert(slot);
+	  }
+	else
+	  {
+	    // The pointer may point to the stack frame
+	    clobber(state, false);
+	    state[STORE_MARKER] = mkUnknown();
+	    written.insert(STORE_MARKER);
+	  }
+	return;
+      }
+    else if (Arch::isLoad(code) && nbops == 2)
+      {
+	bool integer_load = (m == "lw" || m == "ld" || m == "lwu" || m == "lh" || m == "lhu" || m == "lb" || m == "lbu");
+	dest = v[1];
+	res = (integer_load && getFrameSlot(v[2], slot)) ? getValue(state, slot) : mkUnknown();
+      }
+    else
+      {
+	vector < string > outputs = Arch::getResourceOutputs(code);
+	for (size_t i = 0; i < outputs.size(); i++)
+	  if (Arch::isRegisterName(outputs[i]) && !Arch::isZeroRegister(outputs[i]))
+	    {
+	      state[outputs[i]] = mkUnknown();
+	      written.insert(outputs[i]);
+	    }
+	return;
+      }
+
+    if (Arch::isRegisterName(dest) && !Arch::isZeroRegister(dest))
+      {
+	state[dest] = res;
+	written.insert(dest);
+      }
+  }
+
+  /**
+     Symbolic execution of the nbinstr first instructions of n (the whole node when nbinstr < 0),
+     from the values of the locations at the node entry.
+  */
+  void LoopBoundComputer::executeNode(Node * n, int nbinstr, t_sym_state & state, set < string > &written)
+  {
+    vector < Instruction * >vi = n->GetAsm();
+    int last = (nbinstr < 0) ? (int) vi.size() : nbinstr;
+    for (int i = 0; i < last; i++)
+      execute(vi[i]->GetCode(), state, written);
+
+    if (nbinstr < 0 && n->IsCall())
+      {
+	clobber(state, true);
+	state[CALL_MARKER] = mkUnknown();
+	written.insert(CALL_MARKER);
+      }
+  }
+
+  bool LoopBoundComputer::getFirstAddress(Node * n, t_address * addr)
+  {
+    vector < Instruction * >vi = n->GetAsm();
+    if (vi.size() == 0 || !vi[0]->HasAttribute(AddressAttributeNameExtract)) return false;
+    AddressAttribute attr = (AddressAttribute &) vi[0]->GetAttribute(AddressAttributeNameExtract);
+    *addr = attr.getCodeAddress();
+    return true;
+  }
+
+  /**
+     @return the index of the conditional branch ending n (-1 if none) and its destination (target).
+     MIPS: the branch is followed by its delay slot.
+  */
+  int LoopBoundComputer::getBranchIndex(Node * n, t_address * target)
+  {
+    vector < Instruction * >vi = n->GetAsm();
+    int first = (int) vi.size() - 1 - Arch::getNBInstrInDelaySlot();
+    for (int i = (int) vi.size() - 1; i >= 0 && i >= first; i--)
+      {
+	if (!vi[i]->HasAttribute(AddressAttributeNameExtract)) continue;
+	AddressAttribute attr = (AddressAttribute &) vi[i]->GetAttribute(AddressAttributeNameExtract);
+	string l = Arch::rebuiltObjdumpInstruction(vi[i]->GetCode(), attr.getCodeAddress());
+	ObjdumpInstruction instr = Arch::parseInstruction(l);
+	if (Arch::isConditionalJump(instr))
+	  {
+	    *target = Arch::getJumpDestination(instr);
+	    return i;
+	  }
+      }
+    return -1;
+  }
+
+  /** @return true if n1 dominates n2 */
+  bool LoopBoundComputer::dominates(Node * n1, Node * n2)
+  {
+    if (n1 == n2) return true;
+    if (!n2->HasAttribute(DominatorAttributeName)) return false;
+    DominatorData & dominators = (DominatorData &) n2->GetAttribute(DominatorAttributeName);
+    return dominators.findBB(n1);
+  }
+
+  /**
+     Condition of the conditional branch (code), as "lhs rel rhs" where both sides are SYM_VALUE.
+     The MIPS set-less-than followed by a comparison with zero is folded in a single relation.
+  */
+  bool LoopBoundComputer::getCondition(const string & code, t_sym_state & state, t_sym_value & lhs, t_branch_relation & rel, t_sym_value & rhs)
+  {
+    vector < string > v = Arch::splitInstruction(code);
+    string m = v[0];
+    t_sym_value zero = mkValue("", 0);
+
+    if (v.size() == 3)
+      {
+	t_sym_value a = readOperand(state, v[1]);
+	if (m == "beqz") { lhs = a; rel = REL_EQ; rhs = zero; }
+	else if (m == "bnez") { lhs = a; rel = REL_NE; rhs = zero; }
+	else if (m == "bltz") { lhs = a; rel = REL_LT; rhs = zero; }
+	else if (m == "bgez") { lhs = a; rel = REL_GE; rhs = zero; }
+	else if (m == "blez") { lhs = zero; rel = REL_GE; rhs = a; }
+	else if (m == "bgtz") { lhs = zero; rel = REL_LT; rhs = a; }
+	else return false;
+      }
+    else if (v.size() == 4)
+      {
+	t_sym_value a = readOperand(state, v[1]), b = readOperand(state, v[2]);
+	if (m == "beq") { lhs = a; rel = REL_EQ; rhs = b; }
+	else if (m == "bne") { lhs = a; rel = REL_NE; rhs = b; }
+	else if (m == "blt") { lhs = a; rel = REL_LT; rhs = b; }
+	else if (m == "bge") { lhs = a; rel = REL_GE; rhs = b; }
+	else if (m == "bltu") { lhs = a; rel = REL_LTU; rhs = b; }
+	else if (m == "bgeu") { lhs = a; rel = REL_GEU; rhs = b; }
+	else if (m == "bgt") { lhs = b; rel = REL_LT; rhs = a; }
+	else if (m == "ble") { lhs = b; rel = REL_GE; rhs = a; }
+	else if (m == "bgtu") { lhs = b; rel = REL_LTU; rhs = a; }
+	else if (m == "bleu") { lhs = b; rel = REL_GEU; rhs = a; }
+	else return false;
+      }
+    else
+      return false;
+
+    // (a < b) ==/!= 0
+    if (rhs.kind == SYM_LESS || rhs.kind == SYM_LESSU) std::swap(lhs, rhs);
+    if (lhs.kind == SYM_LESS || lhs.kind == SYM_LESSU)
+      {
+	if ((rel != REL_EQ && rel != REL_NE) || rhs.kind != SYM_VALUE || rhs.loc != "" || rhs.cst != 0) return false;
+	bool is_signed = (lhs.kind == SYM_LESS);
+	if (rel == REL_NE)
+	  rel = is_signed ? REL_LT : REL_LTU;
+	else
+	  rel = is_signed ? REL_GE : REL_GEU;
+	rhs = mkValue(lhs.loc2, lhs.cst2);
+	lhs = mkValue(lhs.loc, lhs.cst);
+      }
+    return lhs.kind == SYM_VALUE && rhs.kind == SYM_VALUE;
+  }
+
+  bool LoopBoundComputer::evalRelation(long long l, t_branch_relation rel, long long r)
+  {
+    switch (rel)
+      {
+      case REL_EQ: return l == r;
+      case REL_NE: return l != r;
+      case REL_LT: return l < r;
+      case REL_GE: return l >= r;
+      case REL_LTU: return (unsigned long long) l < (unsigned long long) r;
+      case REL_GEU: return (unsigned long long) l >= (unsigned long long) r;
+      }
+    assert(false);
+    return false;
+  }
+
+  /** @return true if loc is written by no node of the loop */
+  bool LoopBoundComputer::isLoopInvariant(Loop * loop, const string & loc, map < Node *, set < string > >&written)
+  {
+    string base;
+    size_t p = loc.find('(');
+    if (p != string::npos) base = loc.substr(p + 1, loc.size() - p - 2);
+
+    vector < Node * >nodes = loop->GetAllNodes();
+    for (size_t i = 0; i < nodes.size(); i++)
+      {
+	set < string > &w = written[nodes[i]];
+	if (w.count(loc) || (base != "" && w.count(base)) || isClobbered(loc, w)) return false;
+      }
+    return true;
+  }
+
+  /**
+     Checks loc is an induction variable of the loop: it is updated by a single node (update_node), executed once
+     per iteration (not in a nested loop, dominating the back edges), which adds a constant (step) to it.
+  */
+  bool LoopBoundComputer::getInductionStep(Cfg * acfg, Loop * loop, const string & loc, map < Node *, set < string > >&written,
+					   map < Node *, t_sym_state > &states, Node ** update_node, long long &step)
+  {
+    string base;
+    size_t p = loc.find('(');
+    if (p != string::npos) base = loc.substr(p + 1, loc.size() - p - 2);
+
+    Node *update = NULL;
+    vector < Node * >nodes = loop->GetAllNodes();
+    for (size_t i = 0; i < nodes.size(); i++)
+      {
+	set < string > &w = written[nodes[i]];
+	if ((base != "" && w.count(base)) || isClobbered(loc, w)) return false;
+	if (w.count(loc))
+	  {
+	    if (update != NULL) return false;
+	    update = nodes[i];
+	  }
+      }
+    if (update == NULL) return false;
+
+    vector < Node * >not_nested = loop->GetAllNodesNotNested();
+    if (find(not_nested.begin(), not_nested.end(), update) == not_nested.end()) return false;
+    vector < Edge * >backedges = loop->GetBackedges();
+    for (size_t i = 0; i < backedges.size(); i++)
+      if (!dominates(update, acfg->GetSourceNode(backedges[i]))) return false;
+
+    t_sym_value v = getValue(states[update], loc);
+    if (v.kind != SYM_VALUE || v.loc != loc || v.cst == 0) return false;
+    *update_node = update;
+    step = v.cst;
+    return true;
+  }
+
+  /**
+     Possible constant values of loc at the end of node n, searched backwards through the predecessors of n.
+     @return false if one of them is not a constant.
+  */
+  bool LoopBoundComputer::getValuesAtEnd(Cfg * acfg, Node * n, const string & loc, vector < long long >&values, set < Node * >visited)
+  {
+    if (visited.count(n) || visited.size() >= LOOPBOUND_MAX_DEPTH) return false;
+    visited.insert(n);
+
+    t_sym_state state;
+    set < string > written;
+    executeNode(n, -1, state, written);
+    t_sym_value v = getValue(state, loc);
+    if (v.kind != SYM_VALUE) return false;
+    if (v.loc == "")
+      {
+	values.push_back(v.cst);
+	return true;
+      }
+
+    vector < Node * >preds = acfg->GetPredecessors(n);
+    if (preds.size() == 0) return false;	// function parameter
+    for (size_t i = 0; i < preds.size(); i++)
+      {
+	vector < long long >pred_values;
+	if (!getValuesAtEnd(acfg, preds[i], v.loc, pred_values, visited)) return false;
+	for (size_t j = 0; j < pred_values.size(); j++)
+	  values.push_back(pred_values[j] + v.cst);
+      }
+    return true;
+  }
+
+  /** Possible constant values of loc when entering the loop */
+  bool LoopBoundComputer::getEntryValues(Cfg * acfg, Loop * loop, const string & loc, vector < long long >&values)
+  {
+    vector < Node * >preds = acfg->GetPredecessors(loop->GetHead());
+    bool found = false;
+    for (size_t i = 0; i < preds.size(); i++)
+      {
+	if (loop->FindInLoop(preds[i])) continue;
+	set < Node * >visited;
+	if (!getValuesAtEnd(acfg, preds[i], loc, values, visited)) return false;
+	found = true;
+      }
+    return found;
+  }
+
+  /**
+     Number of times (nbstays) the conditional branch of the exit node keeps the control inside the loop,
+     for the worst initial values of the induction variable and of the limit.
+  */
+  bool LoopBoundComputer::boundLoopFromExit(Cfg * acfg, Loop * loop, Node * exit, map < Node *, set < string > >&written,
+					    map < Node *, t_sym_state > &states, long long &nbstays)
+  {
+    vector < Node * >succs = acfg->GetSuccessors(exit);
+    if (succs.size() != 2 || loop->FindInLoop(succs[0]) == loop->FindInLoop(succs[1])) return false;
+    Node *in = loop->FindInLoop(succs[0]) ? succs[0] : succs[1];
+    Node *out = (in == succs[0]) ? succs[1] : succs[0];
+
+    t_address target, first_in, first_out;
+    int ibranch = getBranchIndex(exit, &target);
+    if (ibranch < 0 || !getFirstAddress(in, &first_in) || !getFirstAddress(out, &first_out)) return false;
+    if (first_in != target && first_out != target) return false;
+    bool stay_if_taken = (first_in == target);
+
+    // Condition at the branch, from the values at the node entry
+    t_sym_state state;
+    set < string > w;
+    executeNode(exit, ibranch, state, w);
+    t_sym_value lhs, rhs;
+    t_branch_relation rel;
+    if (!getCondition(exit->GetAsm()[ibranch]->GetCode(), state, lhs, rel, rhs)) return false;
+
+    // One side is the induction variable, the other one is loop invariant
+    Node *update = NULL;
+    long long step = 0;
+    bool iv_left;
+    if (lhs.loc != "" && getInductionStep(acfg, loop, lhs.loc, written, states, &update, step))
+      iv_left = true;
+    else if (rhs.loc != "" && getInductionStep(acfg, loop, rhs.loc, written, states, &update, step))
+      iv_left = false;
+    else
+      return false;
+    t_sym_value iv = iv_left ? lhs : rhs, limit = iv_left ? rhs : lhs;
+
+    vector < long long >limits, inits;
+    if (limit.loc == "")
+      limits.push_back(limit.cst);
+    else
+      {
+	if (!isLoopInvariant(loop, limit.loc, written) || !getEntryValues(acfg, loop, limit.loc, limits)) return false;
+	for (size_t i = 0; i < limits.size(); i++)
+	  limits[i] += limit.cst;
+      }
+    if (!getEntryValues(acfg, loop, iv.loc, inits)) return false;
+
+    // Value compared at iteration k: init + k * step + offset
+    long long offset = iv.cst;
+    if (update != exit)
+      {
+	if (dominates(update, exit))
+	  offset += step;
+	else if (!dominates(exit, update))
+	  return false;
+      }
+
+    nbstays = 0;
+    for (size_t i = 0; i < inits.size(); i++)
+      for (size_t j = 0; j < limits.size(); j++)
+	{
+	  long long k;
+	  for (k = 0; k < LOOPBOUND_MAX_ITERATIONS; k++)
+	    {
+	      long long x = inits[i] + k * step + offset;
+	      bool taken = iv_left ? evalRelation(x, rel, limits[j]) : evalRelation(limits[j], rel, x);
+	      if (taken != stay_if_taken) break;
+	    }
+	  if (k == LOOPBOUND_MAX_ITERATIONS) return false;
+	  dbg_loopbound(cout << "  init " << inits[i] << " limit " << limits[j] << " step " << step << " : " << k << endl);
+	  nbstays = std::max(nbstays, k);
+	}
+    return true;
+  }
+
+  /**
+     Tries every exit node executed at each iteration (dominating the back edges, outside nested loops),
+     the smallest bound is kept.
+  */
+  bool LoopBoundComputer::boundLoop(Cfg * acfg, Loop * loop, int &bound)
+  {
+    Node *head = loop->GetHead();
+    vector < Node * >nodes = loop->GetAllNodes();
+    map < Node *, set < string > >written;
+    map < Node *, t_sym_state > states;
+    for (size_t i = 0; i < nodes.size(); i++)
+      executeNode(nodes[i], -1, states[nodes[i]], written[nodes[i]]);
+
+    vector < Edge * >backedges = loop->GetBackedges();
+    vector < Node * >candidates = loop->GetAllNodesNotNested();
+    bool found = false;
+    long long best = 0;
+    for (size_t c = 0; c < candidates.size(); c++)
+      {
+	Node *exit = candidates[c];
+	bool each_iteration = true;
+	for (size_t i = 0; i < backedges.size(); i++)
+	  each_iteration = each_iteration && dominates(exit, acfg->GetSourceNode(backedges[i]));
+	long long nbstays;
+	if (!each_iteration || !boundLoopFromExit(acfg, loop, exit, written, states, nbstays)) continue;
+
+	// maxiter bounds the executions of the loop body: the head test runs once more than the body
+	long long maxiter = (exit == head && nodes.size() > 1) ? nbstays : nbstays + 1;
+	if (!found || maxiter < best) best = maxiter;
+	found = true;
+      }
+    if (!found || best > INT_MAX) return false;
+    bound = (int) best;
+    return true;
+  }
+
+  int LoopBoundComputer::computeLoopBounds(Cfg * acfg)
+  {
+    int nbmissing = 0;
+    if (acfg->HasAttribute(ExternalWCETAttributeName)) return 0;	// WCET given in the annotation file
+
+    vector < Loop * >loops = acfg->GetAllLoops();
+    for (size_t l = 0; l < loops.size(); l++)
+      {
+	if (loops[l]->HasAttribute(MaxiterAttributeName)) continue;
+	t_address addr = 0;
+	getFirstAddress(loops[l]->GetHead(), &addr);
+	int bound;
+	if (boundLoop(acfg, loops[l], bound))
+	  {
+	    cfglib::SerialisableIntegerAttribute attr_bound(bound);
+	    loops[l]->SetAttribute(MaxiterAttributeName, attr_bound);
+	    cerr << "*** WARNING: loop bound inferred (to be checked): loop at 0x" << std::hex << addr << std::dec << " in CFG "
+		 << acfg->getStringName() << ", " << MaxiterAttributeName << " = " << bound << endl;
+	  }
+	else
+	  {
+	    nbmissing++;
+	    cout << "Loop bound not inferred: loop at 0x" << std::hex << addr << std::dec << " in CFG " << acfg->getStringName()
+		 << " needs a manual " << MaxiterAttributeName << " annotation" << endl;
+	  }
+      }
+    return nbmissing;
+  }
+}
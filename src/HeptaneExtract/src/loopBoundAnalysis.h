@@ -0,0 +1,99 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef _IRISA_LOOPBOUND_ANALYSIS_H
+#define _IRISA_LOOPBOUND_ANALYSIS_H
+
+/* forward declarations and #includes */
+#include "Utl.h"
+#include <CfgLib.h>
+#include <map>
+#include <set>
+
+/* Debug of loop bound analysis methods */
+// Uncomment one of these two lines to enter/leave debug mode
+// #define dbg_loopbound(x) x
+#define dbg_loopbound(x)
+
+/** Upper limit of the iterations simulated for an induction variable */
+#define LOOPBOUND_MAX_ITERATIONS 1000000
+
+/** this namespace is the global namespace */
+namespace cfglib
+{
+  /** Symbolic value of a register or of a stack frame slot inside a basic block:
+      - SYM_VALUE: value of location "loc" at the block entry + cst (a constant when loc is empty),
+      - SYM_LESS/SYM_LESSU: result of a set-less-than between (loc, cst) and (loc2, cst2).
+  */
+  typedef enum { SYM_UNKNOWN, SYM_VALUE, SYM_LESS, SYM_LESSU } t_sym_kind;
+  typedef struct
+  {
+    t_sym_kind kind;
+    std::string loc;
+    long long cst;
+    std::string loc2;
+    long long cst2;
+  } t_sym_value;
+  typedef std::map < std::string, t_sym_value > t_sym_state;
+
+  /** Relations of the conditional branches, once normalised */
+  typedef enum { REL_EQ, REL_NE, REL_LT, REL_GE, REL_LTU, REL_GEU } t_branch_relation;
+
+  /** loop bound analysis: infers the maxiter of counted loops (RISC-V and MIPS code).
+      Induction variables are registers or stack frame slots updated by a constant step once per iteration,
+      compared by the exit branch with a constant or with a loop-invariant location, and initialised by a constant.
+      The frame slots are accessed through the stack/frame pointer only: calls and stores through other pointers
+      may modify any of them.
+  */
+  class LoopBoundComputer
+  {
+  public:
+    /** Attach a maxiter to the loops of acfg that do not have one and can be bounded.
+	@return the number of loops of acfg still without maxiter. */
+    static int computeLoopBounds(Cfg * acfg);
+  private:
+    static bool boundLoop(Cfg * acfg, Loop * loop, int &bound);
+    static bool boundLoopFromExit(Cfg * acfg, Loop * loop, Node * exit, std::map < Node *, std::set < std::string > >&written,
+				  std::map < Node *, t_sym_state > &states, long long &nbstays);
+    static bool getInductionStep(Cfg * acfg, Loop * loop, const std::string & loc, std::map < Node *, std::set < std::string > >&written,
+				 std::map < Node *, t_sym_state > &states, Node ** update_node, long long &step);
+    static bool isLoopInvariant(Loop * loop, const std::string & loc, std::map < Node *, std::set < std::string > >&written);
+    static bool getEntryValues(Cfg * acfg, Loop * loop, const std::string & loc, std::vector < long long >&values);
+    static bool getValuesAtEnd(Cfg * acfg, Node * n, const std::string & loc, std::vector < long long >&values, std::set < Node * >visited);
+    static bool getCondition(const std::string & code, t_sym_state & state, t_sym_value & lhs, t_branch_relation & rel, t_sym_value & rhs);
+    static bool evalRelation(long long l, t_branch_relation rel, long long r);
+    static int getBranchIndex(Node * n, t_address * target);
+    static void execute(const std::string & code, t_sym_state & state, std::set < std::string > &written);
+    static void executeNode(Node * n, int nbinstr, t_sym_state & state, std::set < std::string > &written);
+    static t_sym_value readOperand(t_sym_state & state, const std::string & operand);
+    static t_sym_value getValue(t_sym_state & state, const std::string & loc);
+    static bool isClobbered(const std::string & loc, const std::set < std::string > &written);
+    static void clobber(t_sym_state & state, bool call);
+    static bool getFrameSlot(const std::string & operand, std::string & slot);
+    static bool isFrameRegister(const std::string & reg);
+    static bool isCalleeSaved(const std::string & reg);
+    static bool parseImmediate(const std::string & str, long long &v);
+    static bool dominates(Node * n1, Node * n2);
+    static bool getFirstAddress(Node * n, t_address * addr);
+  };
+}				// cfglib::
+#endif